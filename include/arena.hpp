@@ -0,0 +1,249 @@
+#pragma once
+/**
+ * Multi-creature arena for enen Demo
+ *
+ * Up to 16 creatures, each a Game with its own seed, learn the same
+ * puzzle side by side. Every tick gives each creature still learning one
+ * trial, on a pool of threads (creatures share nothing). Then one 80x24
+ * frame shows all of them as 20x5 tiles:
+ *
+ *   +-#1 seed 1001-----+
+ *   |trial  12  run 3/4|
+ *   |[#######...]      |
+ *   |-+-++--+++++++    |
+ *   +------------------+
+ *
+ * The header, tile borders and seed labels never change, so they are
+ * drawn once: the tile outline is a shared static template, and each
+ * arena stamps it into its own base frame at construction. A frame copies
+ * the base and writes only the figures that changed, so drawing costs a
+ * few microseconds whatever the tick count.
+ *
+ * Used by enen-autorun --arena (a cast of every tick) and enen --arena
+ * (a live view).
+ */
+
+#include "autorun.hpp"
+#include "frame.hpp"
+#include "game.hpp"
+#include "layout.hpp"
+#include "text.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace enen {
+
+struct ArenaConfig {
+    int creatures = 16;          // 1-16 (one tile each)
+    uint32_t baseSeed = 1000;    // Creature i gets baseSeed + i + 1
+    PuzzleType puzzle = PuzzleType::GENERALIZATION;
+    Backend backend = Backend::INTEGER;
+    int threads = 0;             // Trial threads (0 = one per hardware thread)
+    int maxTrials = 100;         // A creature gives up after this many
+};
+
+class Arena {
+public:
+    static constexpr int MAX_CREATURES = 16;
+    static constexpr int COLUMNS = 4;
+    static constexpr int TILE_WIDTH = terminal::WIDTH / COLUMNS;  // 20
+    static constexpr int TILE_HEIGHT = 5;
+
+    // What a tile shows about one creature
+    struct Creature {
+        uint32_t seed = 0;
+        int trials = 0;
+        int masteredAt = -1;      // Trial count when learned (-1 = not yet)
+        bool gaveUp = false;
+        bool failed = false;      // Completed the gauntlet without passing
+        uint32_t outcomes = 0;    // Last trials, newest in bit 0 (1 = correct)
+        int outcomeCount = 0;
+
+        bool learning() const { return masteredAt < 0 && !gaveUp && !failed; }
+    };
+
+    explicit Arena(const ArenaConfig& config) : config_(config) {
+        config_.creatures = std::clamp(config_.creatures, 1, MAX_CREATURES);
+        creatures_.resize(config_.creatures);
+        games_.reserve(config_.creatures);
+        for (int i = 0; i < config_.creatures; i++) {
+            Creature& c = creatures_[i];
+            c.seed = config_.baseSeed + static_cast<uint32_t>(i) + 1;
+            auto game = std::make_unique<Game>(c.seed, config_.backend);
+            while (game->state().current_puzzle != config_.puzzle && game->nextPuzzle()) {}
+            game->setEventCallback([&c](const GameEvent& event) {
+                if (event.type != EventType::OUTCOME) return;
+                c.outcomes = (c.outcomes << 1) | (event.success ? 1u : 0u);
+                c.outcomeCount++;
+            });
+            games_.push_back(std::move(game));
+        }
+        buildBase();
+    }
+
+    // Games report outcomes into creatures_ by address
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // One trial for every creature still learning. Returns false once
+    // none is (every creature has learned, failed or given up).
+    bool tick() {
+        if (learning() == 0) return false;
+        parallelFor(games_.size(), config_.threads, [&](size_t i) {
+            Creature& c = creatures_[i];
+            if (!c.learning()) return;
+            bool complete = games_[i]->runTrial();
+            c.trials++;
+            if (complete && config_.puzzle == PuzzleType::COMPOSITION &&
+                !games_[i]->state().gauntlet.passed()) {
+                c.failed = true;
+            } else if (complete) {
+                c.masteredAt = c.trials;
+            } else if (c.trials >= config_.maxTrials) c.gaveUp = true;
+        });
+        ticks_++;
+        return true;
+    }
+
+    // Compose the current state into buffer (replaces its contents)
+    void render(TextBuffer& buffer) const {
+        buffer = base_;
+        text::put(buffer, layout::arena::TICK_X, layout::arena::TITLE_Y,
+                  ENEN_FORMAT("tick {:3}  learned {:2}/{}"), ticks_, mastered(), config_.creatures);
+        for (int i = 0; i < config_.creatures; i++) renderTile(buffer, i);
+    }
+
+    int ticks() const { return ticks_; }
+    int creatureCount() const { return config_.creatures; }
+    const Creature& creature(int i) const { return creatures_[i]; }
+    const Game& game(int i) const { return *games_[i]; }
+    PuzzleType puzzle() const { return config_.puzzle; }
+
+    int mastered() const {
+        int n = 0;
+        for (const auto& c : creatures_) n += c.masteredAt >= 0;
+        return n;
+    }
+
+    int learning() const {
+        int n = 0;
+        for (const auto& c : creatures_) n += c.learning();
+        return n;
+    }
+
+private:
+    static constexpr int OUTCOMES_SHOWN = TILE_WIDTH - 2;
+
+    ArenaConfig config_;
+    std::vector<std::unique_ptr<Game>> games_;
+    std::vector<Creature> creatures_;
+    TextBuffer base_;
+    int ticks_ = 0;
+
+    // One empty tile: border and blank interior, shared by every arena
+    static const TextBuffer& tileTemplate() {
+        static const TextBuffer tile = [] {
+            TextBuffer t;
+            t.clear();
+            t.putChar(0, 0, '+');
+            t.drawHLine(1, 0, TILE_WIDTH - 2, '-');
+            t.putChar(TILE_WIDTH - 1, 0, '+');
+            for (int y = 1; y < TILE_HEIGHT - 1; y++) {
+                t.putChar(0, y, '|');
+                t.putChar(TILE_WIDTH - 1, y, '|');
+            }
+            t.putChar(0, TILE_HEIGHT - 1, '+');
+            t.drawHLine(1, TILE_HEIGHT - 1, TILE_WIDTH - 2, '-');
+            t.putChar(TILE_WIDTH - 1, TILE_HEIGHT - 1, '+');
+            return t;
+        }();
+        return tile;
+    }
+
+    static const char* puzzleTitle(PuzzleType puzzle) {
+        static const char* const TITLES[NUM_PUZZLES] = {
+            "SIZE", "EXCEPTIONS", "CONTEXT", "ORDER", "EVERYTHING"
+        };
+        return TITLES[static_cast<int>(puzzle)];
+    }
+
+    static int tileX(int i) { return (i % COLUMNS) * TILE_WIDTH; }
+    static int tileY(int i) { return layout::arena::TILES_Y + (i / COLUMNS) * TILE_HEIGHT; }
+
+    void buildBase() {
+        base_.clear();
+        text::put(base_, 0, layout::arena::TITLE_Y, ENEN_FORMAT("ARENA: {} ({} creatures)"),
+                  puzzleTitle(config_.puzzle), config_.creatures);
+        base_.drawHLine(0, layout::arena::RULE_Y, terminal::WIDTH, '=');
+
+        const TextBuffer& tile = tileTemplate();
+        for (int i = 0; i < config_.creatures; i++) {
+            for (int y = 0; y < TILE_HEIGHT; y++) {
+                base_.blit(tileX(i), tileY(i) + y, tile.line(y), TILE_WIDTH);
+            }
+            text::put(base_, tileX(i) + 2, tileY(i), ENEN_FORMAT("#{} seed {}"), i + 1,
+                      creatures_[i].seed);
+        }
+
+        base_.drawHLine(0, layout::arena::DIVIDER_Y, terminal::WIDTH, '-');
+        base_.putString(0, layout::arena::LEGEND_Y,
+                        "+ correct  - wrong  [###...] progress to mastery  one trial per tick");
+    }
+
+    void renderTile(TextBuffer& buffer, int i) const {
+        const Creature& c = creatures_[i];
+        const GameState& s = games_[i]->state();
+        int x = tileX(i) + 1;
+        int y = tileY(i) + 1;
+
+        bool gauntlet = config_.puzzle == PuzzleType::COMPOSITION;
+        const GauntletState& g = s.gauntlet;
+        if (c.masteredAt >= 0) {
+            text::put(buffer, x, y, ENEN_FORMAT("LEARNED in {:3}"), c.masteredAt);
+        } else if (c.failed) {
+            text::put(buffer, x, y, ENEN_FORMAT("FAILED at {:3}"), c.trials);
+        } else if (c.gaveUp) {
+            text::put(buffer, x, y, ENEN_FORMAT("GAVE UP at {:3}"), c.trials);
+        } else if (gauntlet) {
+            text::put(buffer, x, y, ENEN_FORMAT("trial {:3}  {:2}/{:2}"), c.trials, g.correct,
+                      g.scored_completed);
+        } else {
+            text::put(buffer, x, y, ENEN_FORMAT("trial {:3}  run {}/{}"), c.trials,
+                      s.validator.successes, s.validator.requiredSuccesses());
+        }
+
+        if (gauntlet) {
+            drawProgressBar(buffer, x, y + 1, g.warmup_completed + g.scored_completed,
+                            GauntletState::TOTAL_TRIALS);
+            if (c.masteredAt >= 0 || c.failed) {
+                text::put(buffer, x + 13, y + 1, ENEN_FORMAT("{:3}%"), g.scorePercent());
+            }
+        } else {
+            drawProgressBar(buffer, x, y + 1, c.masteredAt >= 0 ? 1 : s.validator.successes,
+                            c.masteredAt >= 0 ? 1 : s.validator.requiredSuccesses());
+        }
+
+        // Recent outcomes, oldest left
+        char* row = buffer.span(x, y + 2);
+        int shown = std::min(c.outcomeCount, OUTCOMES_SHOWN);
+        for (int k = 0; k < shown; k++) {
+            row[k] = (c.outcomes >> (shown - 1 - k)) & 1u ? '+' : '-';
+        }
+    }
+};
+
+// Run the arena to the end as cast frames: the starting state, then one
+// frame per tick, the last one held for timing::ARENA_END
+inline void recordArena(Arena& arena, FrameWriter& writer) {
+    TextBuffer buffer;
+    arena.render(buffer);
+    writer.outputFrame(buffer, timing::ARENA_TICK);
+    while (arena.tick()) {
+        arena.render(buffer);
+        writer.outputFrame(buffer, arena.learning() > 0 ? timing::ARENA_TICK : timing::ARENA_END);
+    }
+}
+
+} // namespace enen
@@ -0,0 +1,578 @@
+#pragma once
+/**
+ * Asynchronous file output for enen Demo
+ *
+ * AsyncWriter is a CastSink that takes output off the producing thread:
+ * - Output is copied into a fixed pool of preallocated, page-aligned
+ *   blocks. A full block is submitted and the producer moves on to the
+ *   next free one. It only waits when every block is still in flight,
+ *   and that wait is counted as stall time.
+ * - On Linux the blocks are written through io_uring: they are
+ *   registered with the kernel once, and each write is a WRITE_FIXED at
+ *   its file offset. This uses raw syscalls, so there is no liburing
+ *   dependency.
+ * - Elsewhere, or when io_uring is unavailable, a writer thread pwrite()s
+ *   the blocks. The thread is also used for pipes and O_APPEND files,
+ *   where writes must happen in order.
+ *
+ * Used for autorun casts (compressed or not) and by enen-bench cast.
+ */
+
+#include "frame.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#undef BLOCK_SIZE  // From <linux/fs.h>; clashes with CastStream::BLOCK_SIZE
+#define ENEN_HAVE_IO_URING 1
+#elif defined(_WIN32)
+#include <cerrno>
+#include <io.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace enen {
+
+enum class IoBackend {
+    AUTO,      // io_uring if available and the file is seekable, else THREAD
+    IO_URING,
+    THREAD,
+};
+
+inline const char* ioBackendName(IoBackend backend) {
+    switch (backend) {
+        case IoBackend::AUTO: return "auto";
+        case IoBackend::IO_URING: return "io_uring";
+        case IoBackend::THREAD: return "thread";
+    }
+    return "?";
+}
+
+namespace aio {
+
+//=============================================================================
+// Block - One preallocated output buffer
+//=============================================================================
+struct Block {
+    char* data = nullptr;
+    size_t used = 0;      // Bytes filled by the producer
+    size_t written = 0;   // Bytes the kernel has accepted (short writes resume)
+    uint64_t offset = 0;  // File offset of data[0]
+};
+
+//=============================================================================
+// Engine - Writes blocks in the background, reports them back when done
+//=============================================================================
+class Engine {
+public:
+    virtual ~Engine() = default;
+
+    // Start writing block `index` (all of block.used)
+    virtual void submit(int index) = 0;
+
+    // Append finished block indices to `done`; with `wait`, block until at
+    // least one finishes (there must be one in flight)
+    virtual void reap(std::vector<int>& done, bool wait) = 0;
+
+    // First write error (errno), 0 if none
+    virtual int error() const = 0;
+
+    // Blocks given up on while the kernel may still read them: they are
+    // never reported done and must not be reused or freed
+    virtual int lost() const { return 0; }
+};
+
+// Write all of `block` at its offset (or at the file position when the
+// file is not seekable). Returns 0 or an errno.
+#ifdef _WIN32
+inline int writeBlock(int fd, Block& block, bool /*positioned*/) {
+    while (block.written < block.used) {
+        int r = ::_write(fd, block.data + block.written, static_cast<unsigned>(block.used - block.written));
+        if (r < 0) return errno;
+        block.written += static_cast<size_t>(r);
+    }
+    return 0;
+}
+#else
+inline int writeBlock(int fd, Block& block, bool positioned) {
+    while (block.written < block.used) {
+        const char* p = block.data + block.written;
+        size_t n = block.used - block.written;
+        ssize_t r = positioned ? ::pwrite(fd, p, n, static_cast<off_t>(block.offset + block.written))
+                               : ::write(fd, p, n);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return errno;
+        }
+        block.written += static_cast<size_t>(r);
+    }
+    return 0;
+}
+#endif
+
+//=============================================================================
+// ThreadEngine - Writer thread, blocks written in submission order
+//=============================================================================
+class ThreadEngine : public Engine {
+public:
+    ThreadEngine(int fd, std::vector<Block>& blocks, bool positioned)
+        : fd_(fd), blocks_(blocks), positioned_(positioned) {
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~ThreadEngine() override {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stopping_ = true;
+        }
+        work_.notify_one();
+        thread_.join();
+    }
+
+    void submit(int index) override {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            queue_.push_back(index);
+        }
+        work_.notify_one();
+    }
+
+    void reap(std::vector<int>& done, bool wait) override {
+        std::unique_lock<std::mutex> guard(lock_);
+        if (wait) finished_.wait(guard, [this] { return !completed_.empty(); });
+        done.insert(done.end(), completed_.begin(), completed_.end());
+        completed_.clear();
+    }
+
+    int error() const override {
+        std::lock_guard<std::mutex> guard(lock_);
+        return error_;
+    }
+
+private:
+    int fd_;
+    std::vector<Block>& blocks_;
+    bool positioned_;
+    std::thread thread_;
+    mutable std::mutex lock_;
+    std::condition_variable work_;
+    std::condition_variable finished_;
+    std::deque<int> queue_;
+    std::vector<int> completed_;
+    bool stopping_ = false;
+    int error_ = 0;
+
+    void run() {
+        for (;;) {
+            std::unique_lock<std::mutex> guard(lock_);
+            work_.wait(guard, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) break;
+            int index = queue_.front();
+            queue_.pop_front();
+            guard.unlock();
+
+            int status = writeBlock(fd_, blocks_[index], positioned_);
+            guard.lock();
+            if (status && !error_) error_ = status;
+            completed_.push_back(index);
+            guard.unlock();
+            finished_.notify_one();
+        }
+    }
+};
+
+#ifdef ENEN_HAVE_IO_URING
+//=============================================================================
+// UringEngine - io_uring with the block pool registered as fixed buffers
+//=============================================================================
+class UringEngine : public Engine {
+public:
+    // Sets up the ring; check ok() afterwards
+    UringEngine(int fd, std::vector<Block>& blocks, size_t blockSize)
+        : fd_(fd), blocks_(blocks), submitted_(blocks.size(), false), lostBlocks_(blocks.size(), false) {
+        io_uring_params params = {};
+        unsigned entries = 1;
+        while (entries < blocks.size()) entries <<= 1;
+        ring_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_ < 0) return;
+
+        sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+
+        sqRing_ = map(sqRingSize_, IORING_OFF_SQ_RING);
+        cqRing_ = single ? sqRing_ : map(cqRingSize_, IORING_OFF_CQ_RING);
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqesSize_, IORING_OFF_SQES));
+        if (!sqRing_ || !cqRing_ || !sqes_) return;
+
+        char* sq = static_cast<char*>(sqRing_);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        char* cq = static_cast<char*>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // Registered buffers: the kernel pins them once instead of per write
+        std::vector<iovec> iov(blocks.size());
+        for (size_t i = 0; i < blocks.size(); i++) iov[i] = {blocks[i].data, blockSize};
+        registered_ = ::syscall(__NR_io_uring_register, ring_, IORING_REGISTER_BUFFERS,
+                                iov.data(), static_cast<unsigned>(iov.size())) == 0;
+        ok_ = true;
+    }
+
+    ~UringEngine() override {
+        if (sqes_) ::munmap(sqes_, sqesSize_);
+        if (cqRing_ && cqRing_ != sqRing_) ::munmap(cqRing_, cqRingSize_);
+        if (sqRing_) ::munmap(sqRing_, sqRingSize_);
+        if (ring_ >= 0) ::close(ring_);  // Also unregisters the buffers
+    }
+
+    bool ok() const { return ok_; }
+    bool registered() const { return registered_; }
+
+    void submit(int index) override {
+        Block& block = blocks_[index];
+        unsigned tail = *sqTail_;
+        unsigned slot = tail & sqMask_;
+        io_uring_sqe& sqe = sqes_[slot];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = registered_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe.fd = fd_;
+        sqe.addr = reinterpret_cast<uint64_t>(block.data + block.written);
+        sqe.len = static_cast<uint32_t>(block.used - block.written);
+        sqe.off = block.offset + block.written;
+        sqe.buf_index = static_cast<uint16_t>(index);
+        sqe.user_data = static_cast<uint64_t>(index);
+        sqArray_[slot] = slot;
+        __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+        for (;;) {
+            if (::syscall(__NR_io_uring_enter, ring_, 1, 0, 0, nullptr, 0) >= 0) {
+                submitted_[index] = true;
+                return;
+            }
+            int status = errno;
+            if (status == EINTR) continue;
+            // Completions backing up (EBUSY) or the kernel short of memory
+            // (EAGAIN): take what has completed and retry while that frees
+            // something
+            if ((status == EAGAIN || status == EBUSY) && setAside()) continue;
+
+            // Not submitted: withdraw the entry and report the block done
+            // (failed) from the next reap(), so nothing waits for it
+            __atomic_store_n(sqTail_, tail, __ATOMIC_RELEASE);
+            if (!error_) error_ = status;
+            failed_.push_back(index);
+            return;
+        }
+    }
+
+    void reap(std::vector<int>& done, bool wait) override {
+        for (;;) {
+            size_t before = done.size();
+            setAside();
+            completing_.swap(setAside_);
+            for (const auto& cqe : completing_) complete(cqe, done);
+            completing_.clear();
+            done.insert(done.end(), failed_.begin(), failed_.end());
+            failed_.clear();
+
+            if (!wait || done.size() > before) return;
+            if (::syscall(__NR_io_uring_enter, ring_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+                errno != EINTR) {
+                // The ring cannot be waited on: give up on every write in
+                // flight. The kernel may still be reading those blocks, so
+                // they are written off as lost rather than reported done.
+                if (!error_) error_ = errno;
+                for (size_t i = 0; i < submitted_.size(); i++) {
+                    if (!submitted_[i]) continue;
+                    submitted_[i] = false;
+                    lostBlocks_[i] = true;
+                    lost_++;
+                }
+                return;
+            }
+        }
+    }
+
+    int error() const override { return error_; }
+    int lost() const override { return lost_; }
+
+private:
+    int fd_;
+    std::vector<Block>& blocks_;
+    int ring_ = -1;
+    bool ok_ = false;
+    bool registered_ = false;
+    int error_ = 0;
+    int lost_ = 0;
+    std::vector<bool> submitted_;             // Per block: in the kernel's hands
+    std::vector<bool> lostBlocks_;            // Per block: given up on (see lost())
+    std::vector<int> failed_;                 // Blocks that could not be submitted
+    std::vector<io_uring_cqe> setAside_;      // Completions taken off the ring...
+    std::vector<io_uring_cqe> completing_;    // ...and being handled by reap()
+
+    void* sqRing_ = nullptr;
+    void* cqRing_ = nullptr;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqRingSize_ = 0, cqRingSize_ = 0, sqesSize_ = 0;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+
+    void* map(size_t size, uint64_t offset) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_,
+                         static_cast<off_t>(offset));
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    // Move completions off the ring. Returns true if there were any.
+    bool setAside() {
+        unsigned head = *cqHead_;
+        unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+        bool any = head != tail;
+        for (; head != tail; head++) setAside_.push_back(cqes_[head & cqMask_]);
+        __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+        return any;
+    }
+
+    void complete(const io_uring_cqe& cqe, std::vector<int>& done) {
+        int index = static_cast<int>(cqe.user_data);
+        if (lostBlocks_[index]) return;  // Already written off
+        Block& block = blocks_[index];
+        submitted_[index] = false;
+        if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+            submit(index);
+            return;
+        }
+        if (cqe.res <= 0) {
+            if (!error_) error_ = cqe.res < 0 ? -cqe.res : EIO;
+            done.push_back(index);
+            return;
+        }
+        block.written += static_cast<size_t>(cqe.res);
+        if (block.written < block.used) submit(index);  // Short write: the rest
+        else done.push_back(index);
+    }
+};
+#endif
+
+} // namespace aio
+
+//=============================================================================
+// AsyncWriter - Block-pooled output to a file descriptor
+//=============================================================================
+class AsyncWriter : public CastSink {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+    static constexpr int DEFAULT_BLOCKS = 8;
+
+    struct Stats {
+        uint64_t bytes = 0;          // Accepted from the producer
+        uint64_t blocks = 0;         // Blocks submitted
+        double stallSeconds = 0.0;   // Producer waiting for a free block
+        double drainSeconds = 0.0;   // close(): waiting for the last writes
+        bool registeredBuffers = false;
+    };
+
+    // Writes to `fd` from its current position; the descriptor stays open
+    explicit AsyncWriter(int fd, IoBackend backend = IoBackend::AUTO,
+                         size_t blockSize = DEFAULT_BLOCK_SIZE, int blocks = DEFAULT_BLOCKS)
+        : fd_(fd), blockSize_(blockSize) {
+        if (blocks < 2) blocks = 2;
+        pool_ = allocate(blockSize_ * static_cast<size_t>(blocks));
+        blocks_.resize(static_cast<size_t>(blocks));
+        for (int i = 0; i < blocks; i++) {
+            blocks_[i].data = pool_ + static_cast<size_t>(i) * blockSize_;
+            free_.push_back(blocks - 1 - i);
+        }
+
+        // Writes at explicit offsets may complete out of order, which is only
+        // safe on a seekable file that is not O_APPEND
+        bool positioned = false;
+#ifndef _WIN32
+        off_t position = ::lseek(fd_, 0, SEEK_CUR);
+        int flags = ::fcntl(fd_, F_GETFL);
+        positioned = position >= 0 && flags >= 0 && !(flags & O_APPEND);
+        if (positioned) offset_ = static_cast<uint64_t>(position);
+#endif
+        positioned_ = positioned;
+
+#ifdef ENEN_HAVE_IO_URING
+        if (positioned && backend != IoBackend::THREAD) {
+            auto uring = std::make_unique<aio::UringEngine>(fd_, blocks_, blockSize_);
+            if (uring->ok()) {
+                stats_.registeredBuffers = uring->registered();
+                engine_ = std::move(uring);
+                backend_ = IoBackend::IO_URING;
+            }
+        }
+#endif
+        if (!engine_) {
+            engine_ = std::make_unique<aio::ThreadEngine>(fd_, blocks_, positioned);
+            backend_ = IoBackend::THREAD;
+        }
+        current_ = take();
+    }
+
+    ~AsyncWriter() override {
+        close();
+        engine_.reset();
+        if (lost_ == 0) release(pool_);  // Else the kernel may still read it: leak
+    }
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    using CastSink::write;
+
+    void write(const char* data, size_t size) override {
+        stats_.bytes += size;
+        while (size > 0 && current_ >= 0) {
+            aio::Block& block = blocks_[current_];
+            size_t n = std::min(size, blockSize_ - block.used);
+            std::memcpy(block.data + block.used, data, n);
+            block.used += n;
+            data += n;
+            size -= n;
+            if (block.used == blockSize_) {
+                submitCurrent();
+                current_ = take();
+            }
+        }
+    }
+
+    // Submit what has been written so far (without waiting for it)
+    void flush() {
+        if (closed_ || current_ < 0 || blocks_[current_].used == 0) return;
+        submitCurrent();
+        current_ = take();
+    }
+
+    // Submit the last block and wait for every write to finish. The file
+    // position is left after the output. Returns false on a write error.
+    bool close() {
+        if (closed_) return error_ == 0;
+        auto start = std::chrono::steady_clock::now();
+        if (current_ >= 0) {
+            if (blocks_[current_].used > 0) submitCurrent();
+            else free_.push_back(current_);
+        }
+        while (inFlight_ > 0) reap(true);
+        closed_ = true;
+        stats_.drainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        error_ = engine_->error();
+#ifndef _WIN32
+        if (positioned_) ::lseek(fd_, static_cast<off_t>(offset_), SEEK_SET);
+#endif
+        return error_ == 0;
+    }
+
+    IoBackend backend() const { return backend_; }
+    int error() const { return error_; }  // errno of the first failed write
+    const Stats& stats() const { return stats_; }
+
+private:
+    int fd_;
+    size_t blockSize_;
+    char* pool_ = nullptr;
+    std::vector<aio::Block> blocks_;
+    std::vector<int> free_;
+    std::vector<int> done_;
+    std::unique_ptr<aio::Engine> engine_;
+    IoBackend backend_ = IoBackend::THREAD;
+    bool positioned_ = false;
+    uint64_t offset_ = 0;  // File offset of the next submitted block
+    int current_ = 0;      // -1 once every block is lost (output is dropped)
+    int inFlight_ = 0;
+    int lost_ = 0;         // engine_->lost() already taken off inFlight_
+    bool closed_ = false;
+    int error_ = 0;
+    Stats stats_;
+
+    static char* allocate(size_t size) {
+#ifdef _WIN32
+        return static_cast<char*>(::operator new(size, std::align_val_t(4096)));
+#else
+        void* p = nullptr;
+        if (::posix_memalign(&p, 4096, size) != 0) throw std::bad_alloc();
+        return static_cast<char*>(p);
+#endif
+    }
+
+    static void release(char* p) {
+#ifdef _WIN32
+        ::operator delete(p, std::align_val_t(4096));
+#else
+        std::free(p);
+#endif
+    }
+
+    void submitCurrent() {
+        aio::Block& block = blocks_[current_];
+        block.offset = offset_;
+        block.written = 0;
+        offset_ += block.used;
+        inFlight_++;
+        stats_.blocks++;
+        engine_->submit(current_);
+    }
+
+    void reap(bool wait) {
+        done_.clear();
+        engine_->reap(done_, wait);
+        for (int index : done_) {
+            blocks_[index].used = 0;
+            free_.push_back(index);
+            inFlight_--;
+        }
+        inFlight_ -= engine_->lost() - lost_;
+        lost_ = engine_->lost();
+    }
+
+    // A free block for the producer, waiting only if all are in flight;
+    // -1 if none will come back (all lost after an engine failure)
+    int take() {
+        reap(false);
+        if (free_.empty()) {
+            auto start = std::chrono::steady_clock::now();
+            while (free_.empty() && inFlight_ > 0) reap(true);
+            stats_.stallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (free_.empty()) return -1;
+        int index = free_.back();
+        free_.pop_back();
+        return index;
+    }
+};
+
+} // namespace enen
@@ -0,0 +1,459 @@
+#pragma once
+/**
+ * Two-phase autorun for enen Demo
+ *
+ * Recording a cast used to interleave learning, drawing and JSON escaping
+ * on one thread. Only the learning has to happen in order, so autorun is
+ * split in two:
+ *
+ * 1. simulateDemo(): runs the five puzzles and records one FrameRecord per
+ *    frame - which screen, the trial and outcome, progress, history, the
+ *    forward trace, the decision map's grid, and the pause after the frame.
+ * 2. renderCast(): turns the log into asciinema event lines. Timestamps
+ *    are a prefix sum of the pauses, so any frame can be drawn on its own;
+ *    the log is cut into chunks that a pool of threads renders, and the
+ *    chunks are stitched back together in order. All text is built here,
+ *    heatmap rows included.
+ *
+ * The cast is byte-identical for any thread count.
+ */
+
+#include "networks.hpp"
+#include "puzzles.hpp"
+#include "frame.hpp"
+#include "layout.hpp"
+#include "heatmap.hpp"
+#include "history.hpp"
+#include "screens.hpp"
+#include "text.hpp"
+#include "trial_screens.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace enen {
+
+//=============================================================================
+// FrameRecord - Everything needed to draw one frame, captured at the time
+//=============================================================================
+struct FrameRecord {
+    enum class Screen : uint8_t { INTRO_1, INTRO_2, PUZZLE_INTRO, TRIAL, VICTORY };
+
+    Screen screen = Screen::INTRO_1;
+    PuzzleType puzzle = PuzzleType::GENERALIZATION;
+    double pause = 0.0;  // Seconds until the next frame
+
+    // Trial frames: the puzzle's trial (by puzzle type)
+    union {
+        MushroomTrial mushroom = {};
+        ShapeTrial shape;
+        XORTrial xorTrial;
+        CompositionTrial composition;
+    };
+
+    bool choice = false;      // choseA / predictedSafe
+    bool correct = false;
+    bool complete = false;
+    bool inProgress = false;  // Sequence: first button of a trial
+    int action = 0;           // Sequence: button pressed
+    int trialNum = 0;
+    int successes = 0;
+    size_t bytes = 0;         // Model size (intro / victory: all five)
+    ForwardTrace trace;
+    History history;
+    GauntletState gauntlet;   // Composition trials and victory
+    bool hasHeatmap = false;
+    DecisionGrid heatmapGrid;  // Rows are formatted when the frame is drawn
+};
+
+using FrameLog = std::vector<FrameRecord>;
+
+//=============================================================================
+// Phase 1: Simulation
+//
+// Each puzzle follows the same pattern:
+// 1. Show puzzle intro
+// 2. Loop until learned: generate trial, evaluate, learn, record
+// 3. Use adaptive timing based on correctness
+//=============================================================================
+namespace autorun {
+
+inline FrameRecord& record(FrameLog& log, FrameRecord::Screen screen, double pause,
+                           PuzzleType puzzle = PuzzleType::GENERALIZATION) {
+    log.emplace_back();
+    FrameRecord& frame = log.back();
+    frame.screen = screen;
+    frame.puzzle = puzzle;
+    frame.pause = pause;
+    return frame;
+}
+
+inline FrameRecord& recordTrial(FrameLog& log, PuzzleType puzzle, double pause,
+                                const IntgrNNWrapper& net, const History& history) {
+    FrameRecord& frame = record(log, FrameRecord::Screen::TRIAL, pause, puzzle);
+    frame.bytes = net.modelSizeBytes();
+    frame.trace = net.lastForward();
+    frame.history = history;
+    return frame;
+}
+
+inline void simulatePuzzle1(FrameLog& log, RNG& rng, GeneralizationNet& net,
+                            History& history, LearningValidator& validator) {
+    record(log, FrameRecord::Screen::PUZZLE_INTRO, timing::PUZZLE_INTRO, PuzzleType::GENERALIZATION);
+
+    validator.reset();
+    history.clear();
+    DecisionMap heatmap;
+
+    while (!validator.hasLearned()) {
+        bool adversarial = validator.isFirstTrial();
+        auto trial = MushroomTrial::generate(rng, adversarial);
+
+        bool choseA = net.chooseA(trial.sizeA, trial.sizeB, trial.colorA, trial.colorB);
+        bool correct = (choseA == trial.correctIsA);
+
+        net.learn(trial.sizeA, trial.sizeB, trial.colorA, trial.colorB, trial.correctIsA);
+        validator.recordOutcome(correct);
+        heatmap.update(net, trial.colorA, trial.colorB);
+
+        char summary[48];
+        text::format(summary, sizeof(summary), ENEN_FORMAT("{}({}) vs {}({})"),
+                     MushroomTrial::colorName(trial.colorA), trial.sizeA,
+                     MushroomTrial::colorName(trial.colorB), trial.sizeB);
+        history.add(validator.total_trials, correct, summary);
+
+        bool complete = validator.hasLearned();
+        bool isFirst = (validator.total_trials == 1);
+        double pause = calculateTrialTiming(complete, isFirst, correct);
+
+        auto& frame = recordTrial(log, PuzzleType::GENERALIZATION, pause, net, history);
+        frame.mushroom = trial;
+        frame.choice = choseA;
+        frame.correct = correct;
+        frame.complete = complete;
+        frame.trialNum = validator.total_trials;
+        frame.successes = validator.successes;
+        frame.hasHeatmap = true;
+        frame.heatmapGrid = heatmap.grid();
+    }
+}
+
+inline void simulatePuzzle2(FrameLog& log, RNG& rng, FeatureSelectionNet& net,
+                            History& history, LearningValidator& validator) {
+    record(log, FrameRecord::Screen::PUZZLE_INTRO, timing::PUZZLE_INTRO, PuzzleType::FEATURE_SELECTION);
+
+    validator.reset();
+    history.clear();
+
+    while (!validator.hasLearned()) {
+        bool adversarial = validator.isFirstTrial();
+        auto trial = ShapeTrial::generate(rng, adversarial);
+
+        bool choseA = net.chooseA(trial.colorA, trial.shapeA, trial.colorB, trial.shapeB);
+        bool correct = (choseA == trial.correctIsA);
+
+        net.learn(trial.colorA, trial.shapeA, trial.colorB, trial.shapeB, trial.correctIsA);
+        validator.recordOutcome(correct);
+
+        char summary[48];
+        text::format(summary, sizeof(summary), ENEN_FORMAT("{} {} vs {} {}"),
+                     ShapeTrial::colorName(trial.colorA), ShapeTrial::shapeName(trial.shapeA),
+                     ShapeTrial::colorName(trial.colorB), ShapeTrial::shapeName(trial.shapeB));
+        history.add(validator.total_trials, correct, summary);
+
+        bool complete = validator.hasLearned();
+        bool isFirst = (validator.total_trials == 1);
+        double pause = calculateTrialTiming(complete, isFirst, correct);
+
+        auto& frame = recordTrial(log, PuzzleType::FEATURE_SELECTION, pause, net, history);
+        frame.shape = trial;
+        frame.choice = choseA;
+        frame.correct = correct;
+        frame.complete = complete;
+        frame.trialNum = validator.total_trials;
+        frame.successes = validator.successes;
+    }
+}
+
+inline void simulatePuzzle3(FrameLog& log, RNG& rng, XORNet& net,
+                            History& history, LearningValidator& validator) {
+    record(log, FrameRecord::Screen::PUZZLE_INTRO, timing::PUZZLE_INTRO, PuzzleType::XOR_CONTEXT);
+
+    validator.reset();
+    history.clear();
+    DecisionMap heatmap;
+
+    while (!validator.hasLearned()) {
+        auto trial = XORTrial::generate(rng);
+
+        bool predictedSafe = net.isSafe(trial.lightInput(), trial.pathInput());
+        bool correct = (predictedSafe == trial.isSafe);
+
+        net.learn(trial.lightInput(), trial.pathInput(), trial.isSafe);
+        validator.recordOutcome(correct);
+        heatmap.update(net);
+
+        char summary[48];
+        text::format(summary, sizeof(summary), ENEN_FORMAT("pred {}, was {}"),
+                     predictedSafe ? "safe" : "danger",
+                     trial.isSafe ? "safe" : "danger");
+        history.add(validator.total_trials, correct, summary);
+
+        bool complete = validator.hasLearned();
+        bool isFirst = (validator.total_trials == 1);
+        double pause = calculateTrialTiming(complete, isFirst, correct);
+
+        auto& frame = recordTrial(log, PuzzleType::XOR_CONTEXT, pause, net, history);
+        frame.xorTrial = trial;
+        frame.choice = predictedSafe;
+        frame.correct = correct;
+        frame.complete = complete;
+        frame.trialNum = validator.total_trials;
+        frame.successes = validator.successes;
+        frame.hasHeatmap = true;
+        frame.heatmapGrid = heatmap.grid();
+    }
+}
+
+inline void simulatePuzzle4(FrameLog& log, SequenceNet& net,
+                            History& history, LearningValidator& validator) {
+    record(log, FrameRecord::Screen::PUZZLE_INTRO, timing::PUZZLE_INTRO, PuzzleType::SEQUENCE);
+
+    validator.reset();
+    history.clear();
+    SequencePuzzle puzzle;
+
+    while (!validator.hasLearned()) {
+        int16_t last = puzzle.lastActionInput();
+        int action = net.chooseAction(last);
+        puzzle.pressButton(action);
+
+        bool success = false;
+        bool inProgress = false;
+
+        if (puzzle.isSuccess()) {
+            success = true;
+            net.learnFromOutcome(last, action, true);
+            validator.recordOutcome(true);
+            history.add(validator.total_trials, true, "A->B SUCCESS");
+            puzzle.reset();
+        } else if (puzzle.isFail()) {
+            net.learnFromOutcome(last, action, false);
+            validator.recordOutcome(false);
+            const char* msg = (action == 1) ? "B first FAIL" : "A->A FAIL";
+            history.add(validator.total_trials, false, msg);
+            puzzle.reset();
+        } else {
+            inProgress = true;
+            net.addStep(last, action, true);  // Learned when the episode ends
+        }
+
+        bool complete = validator.hasLearned();
+        bool isFirst = (validator.total_trials == 1 && !inProgress);
+        double pause = inProgress ? timing::SEQUENCE_STEP
+                     : calculateTrialTiming(complete, isFirst, success);
+
+        auto& frame = recordTrial(log, PuzzleType::SEQUENCE, pause, net, history);
+        frame.action = action;
+        frame.correct = success;
+        frame.inProgress = inProgress;
+        frame.complete = complete;
+        frame.trialNum = validator.total_trials;
+        frame.successes = validator.successes;
+    }
+}
+
+inline void simulatePuzzle5(FrameLog& log, RNG& rng, CompositionNet& net,
+                            History& history, GauntletState& gauntlet) {
+    record(log, FrameRecord::Screen::PUZZLE_INTRO, timing::PUZZLE_INTRO, PuzzleType::COMPOSITION);
+
+    gauntlet.reset();
+    history.clear();
+    DecisionMap heatmap;
+
+    while (!gauntlet.isComplete()) {
+        auto trial = CompositionTrial::generate(rng);
+
+        bool choseA = net.chooseA(trial.lightInput(), trial.sizeA, trial.sizeB);
+        bool correct = (choseA == trial.correctIsA);
+
+        net.learn(trial.lightInput(), trial.sizeA, trial.sizeB, trial.correctIsA);
+        gauntlet.recordOutcome(correct);
+        heatmap.update(net, trial.lightInput());
+
+        char summary[48];
+        bool aLarger = trial.sizeA > trial.sizeB;
+        text::format(summary, sizeof(summary), ENEN_FORMAT("{} - {}({}) {} {}({})"),
+                     trial.lightOn ? "ON" : "OFF",
+                     choseA ? 'A' : 'B', choseA ? trial.sizeA : trial.sizeB,
+                     (choseA ? aLarger : !aLarger) ? ">" : "<",
+                     choseA ? 'B' : 'A', choseA ? trial.sizeB : trial.sizeA);
+        history.add(gauntlet.currentTrials(), correct, summary);
+
+        bool complete = gauntlet.isComplete();
+        bool isFirst = (gauntlet.currentTrials() == 1);
+        double pause = calculateTrialTiming(complete, isFirst, correct);
+
+        auto& frame = recordTrial(log, PuzzleType::COMPOSITION, pause, net, history);
+        frame.composition = trial;
+        frame.choice = choseA;
+        frame.correct = correct;
+        frame.complete = complete;
+        frame.gauntlet = gauntlet;
+        frame.hasHeatmap = true;
+        frame.heatmapGrid = heatmap.grid();
+    }
+}
+
+} // namespace autorun
+
+// Run the whole demo from `seed` and record every frame
+inline FrameLog simulateDemo(uint32_t seed) {
+    RNG rng(seed);
+
+    // Neural networks for each puzzle
+    GeneralizationNet genNet;
+    FeatureSelectionNet featNet;
+    XORNet xorNet;
+    SequenceNet seqNet;
+    CompositionNet compNet;
+
+    // Shared state
+    LearningValidator validator;
+    GauntletState gauntlet;
+    History history;
+    FrameLog log;
+
+    size_t totalBytes = totalModelSize(genNet, featNet, xorNet, seqNet, compNet);
+
+    // Two-part intro
+    autorun::record(log, FrameRecord::Screen::INTRO_1, timing::INTRO_1).bytes = totalBytes;
+    autorun::record(log, FrameRecord::Screen::INTRO_2, timing::INTRO_2);
+
+    // Run all five puzzles
+    autorun::simulatePuzzle1(log, rng, genNet, history, validator);
+    autorun::simulatePuzzle2(log, rng, featNet, history, validator);
+    autorun::simulatePuzzle3(log, rng, xorNet, history, validator);
+    autorun::simulatePuzzle4(log, seqNet, history, validator);
+    autorun::simulatePuzzle5(log, rng, compNet, history, gauntlet);
+
+    // Victory screen
+    auto& victory = autorun::record(log, FrameRecord::Screen::VICTORY, timing::VICTORY);
+    victory.bytes = totalBytes;
+    victory.gauntlet = gauntlet;
+    return log;
+}
+
+//=============================================================================
+// Phase 2: Rendering
+//=============================================================================
+
+// Draw one recorded frame
+inline void renderFrame(TextBuffer& buffer, const FrameRecord& frame) {
+    const ForwardTrace* trace = &frame.trace;
+    DecisionHeatmap shown;
+    const DecisionHeatmap* heatmap = nullptr;
+    if (frame.hasHeatmap) {
+        shown.show(frame.heatmapGrid, frame.puzzle == PuzzleType::XOR_CONTEXT
+                                          ? DecisionMap::CONTEXT_AXES : DecisionMap::SIZE_AXES);
+        heatmap = &shown;
+    }
+
+    switch (frame.screen) {
+        case FrameRecord::Screen::INTRO_1:
+            renderIntro1(buffer, frame.bytes);
+            return;
+        case FrameRecord::Screen::INTRO_2:
+            renderIntro2(buffer);
+            return;
+        case FrameRecord::Screen::PUZZLE_INTRO:
+            renderPuzzleIntro(buffer, frame.puzzle);
+            return;
+        case FrameRecord::Screen::VICTORY:
+            renderVictory(buffer, frame.bytes, frame.gauntlet.correct, frame.gauntlet.scoredLimit());
+            return;
+        case FrameRecord::Screen::TRIAL:
+            break;
+    }
+
+    switch (frame.puzzle) {
+        case PuzzleType::GENERALIZATION:
+            renderPuzzle1Trial(buffer, frame.mushroom, frame.choice, frame.correct, frame.history,
+                               frame.trialNum, frame.successes, frame.bytes, trace, heatmap,
+                               frame.complete);
+            break;
+        case PuzzleType::FEATURE_SELECTION:
+            renderPuzzle2Trial(buffer, frame.shape, frame.choice, frame.correct, frame.history,
+                               frame.trialNum, frame.successes, frame.bytes, trace,
+                               frame.complete);
+            break;
+        case PuzzleType::XOR_CONTEXT:
+            renderPuzzle3Trial(buffer, frame.xorTrial, frame.choice, frame.correct, frame.history,
+                               frame.trialNum, frame.successes, frame.bytes, trace, heatmap,
+                               frame.complete);
+            break;
+        case PuzzleType::SEQUENCE:
+            renderPuzzle4Trial(buffer, frame.action, frame.correct, frame.inProgress, frame.history,
+                               frame.trialNum, frame.successes, frame.bytes, trace,
+                               frame.complete);
+            break;
+        case PuzzleType::COMPOSITION:
+            renderPuzzle5Trial(buffer, frame.composition, frame.choice, frame.correct, frame.history,
+                               frame.gauntlet, frame.bytes, trace, heatmap, frame.complete);
+            break;
+    }
+}
+
+// Run work(i) for every i in [0, count) on up to `threads` threads
+// (<= 0: one per hardware thread). Items are handed out one at a time.
+template <class Work>
+void parallelFor(size_t count, int threads, Work work) {
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, std::min(threads, static_cast<int>(count)));
+
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next++; i < count; i = next++) work(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++) workers.emplace_back(worker);
+    worker();
+    for (auto& w : workers) w.join();
+}
+
+// Frame start times: each frame starts when the previous one's pause ends
+inline std::vector<double> frameTimes(const FrameLog& log) {
+    std::vector<double> times(log.size());
+    double time = 0.0;
+    for (size_t i = 0; i < log.size(); i++) {
+        times[i] = time;
+        time += log[i].pause;
+    }
+    return times;
+}
+
+// Render the log into asciinema event lines (no header), one string per
+// chunk in frame order. threads <= 0 uses one per hardware thread.
+inline std::vector<std::string> renderCast(const FrameLog& log, int threads = 0) {
+    constexpr size_t FRAMES_PER_CHUNK = 16;
+
+    std::vector<double> times = frameTimes(log);
+    size_t chunkCount = (log.size() + FRAMES_PER_CHUNK - 1) / FRAMES_PER_CHUNK;
+    std::vector<std::string> chunks(chunkCount);
+
+    parallelFor(chunkCount, threads, [&](size_t c) {
+        TextBuffer buffer;
+        size_t end = std::min(log.size(), (c + 1) * FRAMES_PER_CHUNK);
+        for (size_t i = c * FRAMES_PER_CHUNK; i < end; i++) {
+            renderFrame(buffer, log[i]);
+            FrameWriter::appendFrame(chunks[c], buffer, times[i], i == 0);
+        }
+    });
+    return chunks;
+}
+
+} // namespace enen
@@ -0,0 +1,382 @@
+#pragma once
+/**
+ * Network backends for enen Demo
+ *
+ * The puzzle wrappers talk to their network through NetBackend, so the
+ * same wrapper (same topology, same experience replay) can run on either:
+ * - Backend::INTEGER: intgr_nn::IntegerGD, the 8-bit engine the demo ships
+ * - Backend::FLOAT:   FloatMLP, a float32 reference for A/B comparison
+ * - Backend::EVOLVED: EvolvedMLP, int8 weights trained by a (1+lambda)
+ *   evolution strategy instead of gradient steps (evolved_nn.hpp)
+ *
+ * Introspection: every forward made for a decision is recorded into a
+ * ForwardTrace as part of that same pass (inputs and outputs always;
+ * hidden units when the backend exposes them). Per-layer weights can be
+ * copied out for display. IntgrNN's public interface does not expose its
+ * internals, so on Backend::INTEGER only inputs and outputs are traced.
+ *
+ * Batched inference: forwardBatch() scores many input rows in one call
+ * (used for the decision heatmap). The float reference runs the batch
+ * layer by layer; IntgrNN takes every row in one tensor through a single
+ * forward() call.
+ *
+ * Training: IntegerGD and FloatMLP take one gradient step per sample
+ * (forward() then backward()). EvolvedMLP reports evolves() and is handed
+ * the whole encoded replay buffer once per generation through evolve().
+ *
+ * Thread safety: infer() and forwardBatch() are const and may be called
+ * from any number of threads on one backend, with no lock on the path.
+ * Training (forward/backward, reinitialize, evolve) needs exclusive
+ * access, like writing to a std::vector.
+ * - FloatMLP keeps all per-call state in a thread_local Scratch.
+ * - EvolvedMLP keeps its activations on the stack.
+ * - IntegerGD::forward() writes activations into the network, so each
+ *   thread decides on its own copy (a replica), taken again whenever the
+ *   weights have changed since. Copying is plain vector copies into the
+ *   replica's existing buffers.
+ */
+
+#include "evolved_nn.hpp"
+#include "float_nn.hpp"
+#include <intgr_nn/intgr_nn.h>
+#include <cstring>
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace enen {
+
+enum class Backend { INTEGER, FLOAT, EVOLVED };
+
+inline const char* backendName(Backend backend) {
+    switch (backend) {
+        case Backend::FLOAT: return "float32";
+        case Backend::EVOLVED: return "int8 evolved";
+        case Backend::INTEGER: break;
+    }
+    return "IntgrNN";
+}
+
+//=============================================================================
+// ForwardTrace - Unit activations of one forward pass (0-255 per unit)
+//
+// Layer 0 is the input, the last layer is the output, anything between
+// is hidden (only present when hasHidden is set).
+//=============================================================================
+struct ForwardTrace {
+    static constexpr size_t MAX_LAYERS = 4;
+    static constexpr size_t MAX_UNITS = 8;
+
+    size_t layers = 0;
+    size_t sizes[MAX_LAYERS] = {};
+    uint8_t units[MAX_LAYERS][MAX_UNITS] = {};
+    bool hasHidden = false;
+
+    bool valid() const { return layers >= 2; }
+    size_t outputLayer() const { return layers - 1; }
+
+    // Inputs and outputs only (hidden layers filled in by the backend)
+    void record(const intgr_nn::Tensor& input, size_t inputCount,
+                const intgr_nn::Tensor& output, size_t outputCount) {
+        layers = 2;
+        hasHidden = false;
+        sizes[0] = inputCount;
+        sizes[1] = outputCount;
+        for (size_t i = 0; i < inputCount && i < MAX_UNITS; i++) units[0][i] = input.at_u8(0, i);
+        for (size_t i = 0; i < outputCount && i < MAX_UNITS; i++) units[1][i] = output.at_u8(0, i);
+    }
+};
+
+// One weight layer (connects unit layer l to l + 1), row-major [out][in]
+struct LayerWeights {
+    size_t inputs = 0;
+    size_t outputs = 0;
+    std::vector<float> weights;
+    std::vector<float> biases;
+
+    float at(size_t out, size_t in) const { return weights[out * inputs + in]; }
+};
+
+//=============================================================================
+// NetBackend - the subset of the IntegerGD interface the wrappers use
+//=============================================================================
+class NetBackend {
+public:
+    virtual ~NetBackend() = default;
+
+    // Training pass (exclusive access): forward() then backward() per sample
+    virtual intgr_nn::Tensor forward(const intgr_nn::Tensor& input) = 0;
+    virtual void backward(const intgr_nn::Tensor& output, const intgr_nn::Tensor& target) = 0;
+    virtual void reinitialize(uint32_t seed) = 0;
+
+    // Decision pass (thread-safe). Records this pass into trace: inputs and
+    // outputs always, hidden units when the backend exposes them.
+    virtual intgr_nn::Tensor infer(const intgr_nn::Tensor& input, size_t inputCount,
+                                   size_t outputCount, ForwardTrace& trace) const = 0;
+
+    // Score count rows of inputWidth bytes; writes count rows of outputWidth
+    // bytes (thread-safe, like infer())
+    virtual void forwardBatch(const uint8_t* inputs, size_t inputWidth, size_t count,
+                              uint8_t* outputs, size_t outputWidth) const = 0;
+
+    virtual size_t parameterCount() const = 0;
+    virtual size_t modelSizeBytes() const = 0;
+    virtual double learningRate() const = 0;
+
+    // Copy weight layer l. Returns false if unavailable.
+    virtual bool layerWeights(size_t layer, LayerWeights& out) const = 0;
+
+    // Whole-replay training, for backends without a per-sample step.
+    // evolve() runs one generation over count samples (row-major uint8
+    // inputs and targets); true once every sample is answered correctly.
+    virtual bool evolves() const { return false; }
+    virtual bool evolve(const uint8_t* /*inputs*/, const uint8_t* /*targets*/, size_t /*count*/) {
+        return false;
+    }
+};
+
+// Identifies a set of weights: a new value, unique across all backends,
+// each time a network's weights change (0 = none)
+inline uint64_t nextBackendVersion() {
+    static std::atomic<uint64_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// The calling thread's copy of `net` at weights `version`. A few recent
+// copies are kept per thread, the least recently used one retaken when a
+// version is not among them.
+template <class Net>
+Net& replicaOf(const Net& net, uint64_t version) {
+    struct Slot {
+        uint64_t version = 0;
+        uint64_t used = 0;
+        std::unique_ptr<Net> net;
+    };
+    static constexpr size_t SLOTS = 8;
+    thread_local Slot slots[SLOTS];
+    thread_local uint64_t clock = 0;
+
+    Slot* oldest = &slots[0];
+    for (auto& slot : slots) {
+        if (slot.version == version) {
+            slot.used = ++clock;
+            return *slot.net;
+        }
+        if (slot.used < oldest->used) oldest = &slot;
+    }
+    if (oldest->net) *oldest->net = net;  // Reuses the copy's buffers
+    else oldest->net = std::make_unique<Net>(net);
+    oldest->version = version;
+    oldest->used = ++clock;
+    return *oldest->net;
+}
+
+// By default a network's forward() is assumed to write into the network,
+// so decisions run on the calling thread's replica...
+template <class Net>
+intgr_nn::Tensor inferOf(const Net& net, uint64_t version, const intgr_nn::Tensor& input,
+                         size_t inputCount, size_t outputCount, ForwardTrace& trace) {
+    intgr_nn::Tensor output = replicaOf(net, version).forward(input);
+    trace.record(input, inputCount, output, outputCount);
+    return output;
+}
+
+template <class Net>
+void forwardBatchOf(const Net& net, uint64_t version, const uint8_t* inputs, size_t inputWidth,
+                    size_t count, uint8_t* outputs, size_t outputWidth) {
+    intgr_nn::Tensor input(count, inputWidth);
+    for (size_t r = 0; r < count; r++) {
+        for (size_t i = 0; i < inputWidth; i++) input.at_u8(r, i) = inputs[r * inputWidth + i];
+    }
+    auto output = replicaOf(net, version).forward(input);
+    for (size_t r = 0; r < count; r++) {
+        for (size_t j = 0; j < outputWidth; j++) outputs[r * outputWidth + j] = output.at_u8(r, j);
+    }
+}
+
+template <class Net>
+bool layerWeightsOf(const Net&, size_t, LayerWeights&) { return false; }
+
+template <class Net>
+bool evolvesOf(const Net&) { return false; }
+
+template <class Net>
+bool evolveOf(Net&, const uint8_t*, const uint8_t*, size_t) { return false; }
+
+// ...the float reference is reentrant (per-thread scratch, no copy) and
+// exposes its hidden units and weights
+inline FloatMLP::Scratch& floatScratch() {
+    thread_local FloatMLP::Scratch scratch;
+    return scratch;
+}
+
+inline intgr_nn::Tensor inferOf(const FloatMLP& net, uint64_t /*version*/,
+                                const intgr_nn::Tensor& input, size_t inputCount,
+                                size_t outputCount, ForwardTrace& trace) {
+    auto& scratch = floatScratch();
+    auto output = net.forward(input, scratch);
+    trace.record(input, inputCount, output, outputCount);
+
+    size_t layers = net.unitLayers();
+    if (layers > ForwardTrace::MAX_LAYERS) return output;
+
+    // Hidden layers go between the recorded input and output layers
+    std::memmove(trace.units[layers - 1], trace.units[1], sizeof(trace.units[1]));
+    trace.sizes[layers - 1] = outputCount;
+    for (size_t l = 1; l + 1 < layers; l++) {
+        trace.sizes[l] = net.unitCount(l);
+        for (size_t i = 0; i < net.unitCount(l) && i < ForwardTrace::MAX_UNITS; i++) {
+            trace.units[l][i] = static_cast<uint8_t>(scratch.activations[l][i] * 255.0f + 0.5f);
+        }
+    }
+    trace.layers = layers;
+    trace.hasHidden = true;
+    return output;
+}
+
+inline void forwardBatchOf(const FloatMLP& net, uint64_t /*version*/, const uint8_t* inputs,
+                           size_t /*inputWidth*/, size_t count, uint8_t* outputs,
+                           size_t /*outputWidth*/) {
+    net.forwardBatch(inputs, count, outputs, floatScratch());
+}
+
+// Either in-tree network: unitLayers(), unitCount(), weight(), bias()
+template <class Net>
+bool copyLayerWeights(const Net& net, size_t layer, LayerWeights& out) {
+    if (layer + 1 >= net.unitLayers()) return false;
+    out.inputs = net.unitCount(layer);
+    out.outputs = net.unitCount(layer + 1);
+    out.weights.resize(out.inputs * out.outputs);
+    out.biases.resize(out.outputs);
+    for (size_t j = 0; j < out.outputs; j++) {
+        for (size_t i = 0; i < out.inputs; i++) out.weights[j * out.inputs + i] = net.weight(layer, j, i);
+        out.biases[j] = net.bias(layer, j);
+    }
+    return true;
+}
+
+inline bool layerWeightsOf(const FloatMLP& net, size_t layer, LayerWeights& out) {
+    return copyLayerWeights(net, layer, out);
+}
+
+// The evolved int8 network is reentrant too (stack activations), and
+// trains on the whole replay buffer
+inline intgr_nn::Tensor inferOf(const EvolvedMLP& net, uint64_t /*version*/,
+                                const intgr_nn::Tensor& input, size_t inputCount,
+                                size_t outputCount, ForwardTrace& trace) {
+    EvolvedMLP::Activations act;
+    auto output = net.forward(input, &act);
+    trace.record(input, inputCount, output, outputCount);
+
+    size_t layers = net.unitLayers();
+    if (layers > ForwardTrace::MAX_LAYERS) return output;
+    for (size_t l = 0; l < layers; l++) {
+        trace.sizes[l] = net.unitCount(l);
+        for (size_t i = 0; i < net.unitCount(l) && i < ForwardTrace::MAX_UNITS; i++) {
+            trace.units[l][i] = act.units[l][i];
+        }
+    }
+    trace.layers = layers;
+    trace.hasHidden = true;
+    return output;
+}
+
+inline void forwardBatchOf(const EvolvedMLP& net, uint64_t /*version*/, const uint8_t* inputs,
+                           size_t /*inputWidth*/, size_t count, uint8_t* outputs,
+                           size_t /*outputWidth*/) {
+    net.forwardBatch(inputs, count, outputs);
+}
+
+inline bool layerWeightsOf(const EvolvedMLP& net, size_t layer, LayerWeights& out) {
+    return copyLayerWeights(net, layer, out);
+}
+
+inline bool evolvesOf(const EvolvedMLP&) { return true; }
+
+inline bool evolveOf(EvolvedMLP& net, const uint8_t* inputs, const uint8_t* targets,
+                     size_t count) {
+    return net.evolve(inputs, targets, count);
+}
+
+// Adapts any network with the IntegerGD calling convention
+template <class Net>
+class BackendAdapter : public NetBackend {
+public:
+    explicit BackendAdapter(std::unique_ptr<Net> net) : net_(std::move(net)) {}
+
+    intgr_nn::Tensor forward(const intgr_nn::Tensor& input) override { return net_->forward(input); }
+    void backward(const intgr_nn::Tensor& output, const intgr_nn::Tensor& target) override {
+        net_->backward(output, target);
+        version_ = nextBackendVersion();
+    }
+    void reinitialize(uint32_t seed) override {
+        net_->reinitialize(seed);
+        version_ = nextBackendVersion();
+    }
+
+    intgr_nn::Tensor infer(const intgr_nn::Tensor& input, size_t inputCount,
+                           size_t outputCount, ForwardTrace& trace) const override {
+        return inferOf(static_cast<const Net&>(*net_), version_, input, inputCount, outputCount,
+                       trace);
+    }
+    void forwardBatch(const uint8_t* inputs, size_t inputWidth, size_t count,
+                      uint8_t* outputs, size_t outputWidth) const override {
+        forwardBatchOf(static_cast<const Net&>(*net_), version_, inputs, inputWidth, count,
+                       outputs, outputWidth);
+    }
+
+    size_t parameterCount() const override { return net_->parameterCount(); }
+    size_t modelSizeBytes() const override { return net_->modelSizeBytes(); }
+    double learningRate() const override { return net_->learningRate(); }
+
+    bool layerWeights(size_t layer, LayerWeights& out) const override {
+        return layerWeightsOf(*net_, layer, out);
+    }
+
+    bool evolves() const override { return evolvesOf(*net_); }
+    bool evolve(const uint8_t* inputs, const uint8_t* targets, size_t count) override {
+        bool solved = evolveOf(*net_, inputs, targets, count);
+        version_ = nextBackendVersion();
+        return solved;
+    }
+
+private:
+    std::unique_ptr<Net> net_;
+    uint64_t version_ = nextBackendVersion();  // Of the weights, for replicas
+};
+
+//=============================================================================
+// createNet / createDeepNet - Build a network on either backend
+//=============================================================================
+inline std::unique_ptr<NetBackend> createNet(Backend backend, size_t inputs, size_t hidden,
+                                             size_t outputs, const intgr_nn::Config& config) {
+    if (backend == Backend::EVOLVED) {
+        return std::make_unique<BackendAdapter<EvolvedMLP>>(
+            std::make_unique<EvolvedMLP>(inputs, std::initializer_list<size_t>{hidden}, outputs));
+    }
+    if (backend == Backend::FLOAT) {
+        return std::make_unique<BackendAdapter<FloatMLP>>(
+            std::make_unique<FloatMLP>(inputs, std::initializer_list<size_t>{hidden}, outputs));
+    }
+    return std::make_unique<BackendAdapter<intgr_nn::IntegerGD>>(
+        intgr_nn::IntegerGD::create(inputs, hidden, outputs, config));
+}
+
+// Two hidden layers
+inline std::unique_ptr<NetBackend> createDeepNet(Backend backend, size_t inputs,
+                                                 size_t hidden1, size_t hidden2,
+                                                 size_t outputs, const intgr_nn::Config& config) {
+    if (backend == Backend::EVOLVED) {
+        return std::make_unique<BackendAdapter<EvolvedMLP>>(
+            std::make_unique<EvolvedMLP>(inputs, std::initializer_list<size_t>{hidden1, hidden2}, outputs));
+    }
+    if (backend == Backend::FLOAT) {
+        return std::make_unique<BackendAdapter<FloatMLP>>(
+            std::make_unique<FloatMLP>(inputs, std::initializer_list<size_t>{hidden1, hidden2}, outputs));
+    }
+    return std::make_unique<BackendAdapter<intgr_nn::IntegerGD>>(
+        intgr_nn::IntegerGD::createDeep(inputs, {hidden1, hidden2}, outputs, config));
+}
+
+} // namespace enen
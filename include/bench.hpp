@@ -0,0 +1,97 @@
+#pragma once
+/**
+ * Benchmark helpers for enen Demo
+ *
+ * Shared by the enen-bench modes (src/bench_*.cpp):
+ * - Stopwatch: steady_clock timing
+ * - Samples: latency collection with mean and percentiles
+ * - allocationCount(): global operator new calls (counted in bench.cpp)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace enen {
+namespace bench {
+
+class Stopwatch {
+public:
+    Stopwatch() : start_(std::chrono::steady_clock::now()) {}
+
+    void restart() { start_ = std::chrono::steady_clock::now(); }
+
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+    double micros() const { return seconds() * 1e6; }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+class Samples {
+public:
+    void add(double value) { values_.push_back(value); sorted_ = false; }
+    void clear() { values_.clear(); }
+    size_t size() const { return values_.size(); }
+
+    double mean() const {
+        if (values_.empty()) return 0.0;
+        double sum = 0.0;
+        for (double v : values_) sum += v;
+        return sum / values_.size();
+    }
+
+    double total() const {
+        double sum = 0.0;
+        for (double v : values_) sum += v;
+        return sum;
+    }
+
+    // Sample variance (n - 1)
+    double variance() const {
+        if (values_.size() < 2) return 0.0;
+        double m = mean();
+        double sum = 0.0;
+        for (double v : values_) sum += (v - m) * (v - m);
+        return sum / (values_.size() - 1);
+    }
+
+    // p in [0, 100], nearest-rank
+    double percentile(double p) {
+        if (values_.empty()) return 0.0;
+        if (!sorted_) {
+            std::sort(values_.begin(), values_.end());
+            sorted_ = true;
+        }
+        size_t rank = static_cast<size_t>(p / 100.0 * (values_.size() - 1) + 0.5);
+        return values_[std::min(rank, values_.size() - 1)];
+    }
+
+private:
+    std::vector<double> values_;
+    bool sorted_ = false;
+};
+
+// Number of global operator new calls so far in this process
+uint64_t allocationCount();
+
+// Modes (one per src/bench_*.cpp)
+int runBackendBench(int argc, char** argv);
+int runHeatmapBench(int argc, char** argv);
+int runGauntletBench(int argc, char** argv);
+int runDemoBench(int argc, char** argv);
+int runAutorunBench(int argc, char** argv);
+int runCastBench(int argc, char** argv);
+int runRenderBench(int argc, char** argv);
+int runReplayBench(int argc, char** argv);
+int runPoolBench(int argc, char** argv);
+int runEvoBench(int argc, char** argv);
+int runBatchBench(int argc, char** argv);
+int runPairedBench(int argc, char** argv);
+
+} // namespace bench
+} // namespace enen
@@ -10,16 +10,59 @@
  * Each puzzle type has a unique diagram reflecting its architecture.
  * The diagram can show either byte count (during gameplay) or
  * "before learning" text (during intro screens).
+ *
+ * During gameplay an activity line lights up the units of the last
+ * decision (from the network's ForwardTrace): inputs, hidden neurons
+ * when the backend exposes them, and outputs.
  */
 
+#include "backend.hpp"
 #include "frame.hpp"
 #include "layout.hpp"
 #include "puzzles.hpp"
-#include <cstdio>
-#include <cstring>
+#include "text.hpp"
 
 namespace enen {
 
+//=============================================================================
+// Activity line - One glyph per unit, '.' (quiet) to '@' (firing)
+//
+// Writes a full 41-char box row into line (needs 42 bytes):
+//   "| in:.#%@  mid:.:-=+*#@  out:@          |"
+//=============================================================================
+inline char activityGlyph(uint8_t value) {
+    static const char ramp[] = ".:-=+*#%@";
+    return ramp[value * 8 / 255];
+}
+
+inline void formatActivityLine(char* line, const ForwardTrace& trace) {
+    size_t len = 0;
+    auto append = [&](const char* str) {
+        while (*str && len < 40) line[len++] = *str++;
+    };
+    auto appendLayer = [&](size_t layer) {
+        for (size_t i = 0; i < trace.sizes[layer] && i < ForwardTrace::MAX_UNITS && len < 40; i++) {
+            line[len++] = activityGlyph(trace.units[layer][i]);
+        }
+    };
+
+    append("| in:");
+    appendLayer(0);
+    if (trace.hasHidden) {
+        append("  mid:");
+        for (size_t l = 1; l < trace.outputLayer(); l++) {
+            if (l > 1) append("/");
+            appendLayer(l);
+        }
+    }
+    append("  out:");
+    appendLayer(trace.outputLayer());
+
+    while (len < 40) line[len++] = ' ';
+    line[40] = '|';
+    line[41] = '\0';
+}
+
 //=============================================================================
 // Brain Diagram - Unified rendering for all puzzle types
 //
@@ -28,28 +71,29 @@ namespace enen {
 //   x, y: Top-left corner of the box
 //   type: Which puzzle's architecture to show
 //   bytes: Model size in bytes (0 = show "before learning" instead)
+//   trace: Last decision forward to light up (nullptr = no activity line)
 //=============================================================================
 inline void drawBrainDiagram(TextBuffer& buffer, int x, int y,
-                              PuzzleType type, size_t bytes = 0) {
+                              PuzzleType type, size_t bytes = 0,
+                              const ForwardTrace* trace = nullptr) {
     // Top border
     buffer.putString(x, y, "+---------------------------------------+");
 
-    // Header line: either bytes or "before learning"
-    char header[50];
-    if (bytes > 0) {
-        std::snprintf(header, sizeof(header), "| enen's brain (%zu bytes)", bytes);
-    } else {
-        std::snprintf(header, sizeof(header), "| enen's brain (before learning)");
-    }
-    // Pad to width
-    size_t len = std::strlen(header);
-    while (len < 40) header[len++] = ' ';
-    header[40] = '|';
-    header[41] = '\0';
-    buffer.putString(x, y + 1, header);
+    // Header line: either bytes or "before learning", padded to the border
+    int end = bytes > 0
+        ? text::put(buffer, x, y + 1, ENEN_FORMAT("| enen's brain ({} bytes)"), bytes)
+        : text::put(buffer, x, y + 1, ENEN_FORMAT("| enen's brain (before learning)"));
+    buffer.drawHLine(end, y + 1, x + 40 - end, ' ');
+    buffer.putChar(x + 40, y + 1, '|');
 
     // Common structure lines
-    buffer.putString(x, y + 2, "|                                       |");
+    if (trace && trace->valid()) {
+        char activity[42];
+        formatActivityLine(activity, *trace);
+        buffer.putString(x, y + 2, activity);
+    } else {
+        buffer.putString(x, y + 2, "|                                       |");
+    }
     buffer.putString(x, y + 3, "| SEES         THINKS        DECIDES    |");
     buffer.putString(x, y + 4, "|                                       |");
 
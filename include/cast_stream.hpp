@@ -0,0 +1,303 @@
+#pragma once
+/**
+ * Compressed cast output for enen Demo
+ *
+ * CastStream is a CastSink for FrameWriter (or raw cast text) that can
+ * gzip on the fly without slowing down whoever produces the frames:
+ * - The producer appends into the front block
+ * - A full block is swapped with the back block, which a dedicated writer
+ *   thread compresses and writes while the producer fills the next one
+ * - The producer only waits if it fills a block before the writer has
+ *   finished the previous one (counted as stall time)
+ *
+ * gzip goes through zlib when the build has it (ENEN_HAVE_ZLIB), and
+ * through the in-tree encoder in deflate.hpp otherwise. Either output
+ * is a standard .gz stream: `zcat demo.cast.gz`.
+ *
+ * The encoded bytes go to a FILE*, or to another sink (an AsyncWriter,
+ * so the writer thread does not wait on the disk either). A FILE* write
+ * error is kept and returned by close(); a sink reports its own.
+ */
+
+#include "deflate.hpp"
+#include "frame.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef ENEN_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace enen {
+
+enum class Compression {
+    NONE,
+    GZIP,          // zlib if available, else in-tree
+    GZIP_BUILTIN,  // Always the in-tree encoder
+};
+
+inline const char* compressionName(Compression compression) {
+    switch (compression) {
+        case Compression::NONE:
+            return "none";
+        case Compression::GZIP:
+#ifdef ENEN_HAVE_ZLIB
+            return "gzip (zlib)";
+#else
+            return "gzip (in-tree)";
+#endif
+        case Compression::GZIP_BUILTIN:
+            return "gzip (in-tree)";
+    }
+    return "?";
+}
+
+//=============================================================================
+// Block encoders - Append the encoded form of each block to `out`
+//=============================================================================
+namespace cast {
+
+class Encoder {
+public:
+    virtual ~Encoder() = default;
+    virtual void encode(const uint8_t* data, size_t size, std::vector<uint8_t>& out) = 0;
+    virtual void finish(std::vector<uint8_t>& out) = 0;
+};
+
+class PlainEncoder : public Encoder {
+public:
+    void encode(const uint8_t* data, size_t size, std::vector<uint8_t>& out) override {
+        out.insert(out.end(), data, data + size);
+    }
+    void finish(std::vector<uint8_t>&) override {}
+};
+
+class BuiltinGzipEncoder : public Encoder {
+public:
+    void encode(const uint8_t* data, size_t size, std::vector<uint8_t>& out) override {
+        gzip_.write(data, size, out);
+    }
+    void finish(std::vector<uint8_t>& out) override { gzip_.finish(out); }
+
+private:
+    deflate::GzipEncoder gzip_;
+};
+
+#ifdef ENEN_HAVE_ZLIB
+class ZlibGzipEncoder : public Encoder {
+public:
+    ZlibGzipEncoder() {
+        // windowBits 15 + 16: gzip framing
+        deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    }
+    ~ZlibGzipEncoder() override { deflateEnd(&stream_); }
+
+    void encode(const uint8_t* data, size_t size, std::vector<uint8_t>& out) override {
+        stream_.next_in = const_cast<Bytef*>(data);
+        stream_.avail_in = static_cast<uInt>(size);
+        run(Z_NO_FLUSH, out);
+    }
+    void finish(std::vector<uint8_t>& out) override {
+        stream_.next_in = nullptr;
+        stream_.avail_in = 0;
+        run(Z_FINISH, out);
+    }
+
+private:
+    z_stream stream_ = {};
+
+    void run(int flush, std::vector<uint8_t>& out) {
+        uint8_t chunk[16384];
+        int status;
+        do {
+            stream_.next_out = chunk;
+            stream_.avail_out = sizeof(chunk);
+            status = ::deflate(&stream_, flush);
+            out.insert(out.end(), chunk, chunk + (sizeof(chunk) - stream_.avail_out));
+        } while (stream_.avail_out == 0 || (flush == Z_FINISH && status == Z_OK));
+    }
+};
+#endif
+
+inline std::unique_ptr<Encoder> makeEncoder(Compression compression) {
+    switch (compression) {
+        case Compression::NONE:
+            return std::make_unique<PlainEncoder>();
+        case Compression::GZIP:
+#ifdef ENEN_HAVE_ZLIB
+            return std::make_unique<ZlibGzipEncoder>();
+#else
+            return std::make_unique<BuiltinGzipEncoder>();
+#endif
+        case Compression::GZIP_BUILTIN:
+            return std::make_unique<BuiltinGzipEncoder>();
+    }
+    return std::make_unique<PlainEncoder>();
+}
+
+} // namespace cast
+
+//=============================================================================
+// CastStream - Double-buffered output with a writer thread
+//=============================================================================
+class CastStream : public CastSink {
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    struct Stats {
+        uint64_t bytesIn = 0;        // Cast text written
+        uint64_t bytesOut = 0;       // Encoded bytes written to the file
+        double encodeSeconds = 0.0;  // Writer thread: encoding + file writes
+        double stallSeconds = 0.0;   // Producer: waiting for the writer
+        double wallSeconds = 0.0;    // Open to close
+
+        double ratio() const { return bytesOut > 0 ? static_cast<double>(bytesIn) / bytesOut : 0.0; }
+        double encodeMBps() const { return encodeSeconds > 0 ? bytesIn / encodeSeconds / 1e6 : 0.0; }
+    };
+
+    CastStream(std::FILE* file, Compression compression)
+        : file_(file), encoder_(cast::makeEncoder(compression)),
+          opened_(std::chrono::steady_clock::now()) {
+        start();
+    }
+
+    // Encoded output to `out`, which must outlive close()
+    CastStream(CastSink* out, Compression compression)
+        : out_(out), encoder_(cast::makeEncoder(compression)),
+          opened_(std::chrono::steady_clock::now()) {
+        start();
+    }
+
+    ~CastStream() override { close(); }
+
+    CastStream(const CastStream&) = delete;
+    CastStream& operator=(const CastStream&) = delete;
+
+    using CastSink::write;
+
+    void write(const char* data, size_t size) override {
+        stats_.bytesIn += size;
+        while (size > 0) {
+            size_t n = std::min(size, BLOCK_SIZE - front_.size());
+            front_.append(data, n);
+            data += n;
+            size -= n;
+            if (front_.size() == BLOCK_SIZE) handOff();
+        }
+    }
+
+    // Flush the last block, end the gzip stream and stop the writer.
+    // Returns false if writing to the FILE* failed (see error()).
+    bool close() {
+        if (closed_) return error_ == 0;
+        if (!front_.empty()) handOff();
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            closing_ = true;
+        }
+        ready_.notify_one();
+        writer_.join();
+        if (file_ && (std::fflush(file_) != 0 || std::ferror(file_)) && !error_) {
+            error_ = errno ? errno : EIO;
+        }
+        closed_ = true;
+        stats_.wallSeconds = secondsSince(opened_);
+        return error_ == 0;
+    }
+
+    // Complete after close()
+    const Stats& stats() const { return stats_; }
+    int error() const { return error_; }  // errno of the first failed FILE* write
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::FILE* file_ = nullptr;
+    CastSink* out_ = nullptr;
+    std::unique_ptr<cast::Encoder> encoder_;
+    Clock::time_point opened_;
+
+    std::string front_;  // Producer fills
+    std::string back_;   // Writer encodes
+    bool backFull_ = false;
+    bool closing_ = false;
+    bool closed_ = false;
+    std::mutex lock_;
+    std::condition_variable ready_;  // Back block full (or closing)
+    std::condition_variable free_;   // Back block drained
+    std::thread writer_;
+    Stats stats_;
+    int error_ = 0;  // Set by the writer thread, read after close() joins it
+
+    void start() {
+        front_.reserve(BLOCK_SIZE);
+        back_.reserve(BLOCK_SIZE);
+        writer_ = std::thread([this] { run(); });
+    }
+
+    static double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Give the front block to the writer (waiting for it to drain the last)
+    void handOff() {
+        std::unique_lock<std::mutex> guard(lock_);
+        if (backFull_) {
+            auto start = Clock::now();
+            free_.wait(guard, [this] { return !backFull_; });
+            stats_.stallSeconds += secondsSince(start);
+        }
+        front_.swap(back_);
+        backFull_ = true;
+        guard.unlock();
+        ready_.notify_one();
+    }
+
+    void run() {
+        std::vector<uint8_t> encoded;
+        encoded.reserve(BLOCK_SIZE);
+        for (;;) {
+            std::unique_lock<std::mutex> guard(lock_);
+            ready_.wait(guard, [this] { return backFull_ || closing_; });
+            if (!backFull_) break;  // Closing, nothing left
+            guard.unlock();
+
+            auto start = Clock::now();
+            encoded.clear();
+            encoder_->encode(reinterpret_cast<const uint8_t*>(back_.data()), back_.size(), encoded);
+            emit(encoded);
+            stats_.encodeSeconds += secondsSince(start);
+
+            guard.lock();
+            back_.clear();
+            backFull_ = false;
+            guard.unlock();
+            free_.notify_one();
+        }
+
+        auto start = Clock::now();
+        encoded.clear();
+        encoder_->finish(encoded);
+        emit(encoded);
+        stats_.encodeSeconds += secondsSince(start);
+    }
+
+    void emit(const std::vector<uint8_t>& bytes) {
+        if (out_) {
+            out_->write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        } else if (!error_ && std::fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size()) {
+            error_ = errno ? errno : EIO;
+        }
+        stats_.bytesOut += bytes.size();
+    }
+};
+
+} // namespace enen
@@ -0,0 +1,201 @@
+#pragma once
+/**
+ * In-tree gzip encoder for enen Demo
+ *
+ * Used for compressed casts when the build has no zlib. Small and
+ * dependency-free rather than best-ratio:
+ * - LZ77 over each written block (hash chains, bounded probes)
+ * - Fixed Huffman codes (RFC 1951 block type 1), so no tables are sent
+ * - gzip framing (RFC 1952): header, CRC-32 and size trailer
+ *
+ * Cast text is highly repetitive (every frame redraws the same borders
+ * and labels), which fixed codes plus back-references already capture.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace enen {
+namespace deflate {
+
+//=============================================================================
+// CRC-32 (gzip polynomial)
+//=============================================================================
+inline uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size) {
+    static const auto TABLE = [] {
+        struct Table { uint32_t entries[256]; } table{};
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table.entries[n] = c;
+        }
+        return table;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) crc = TABLE.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+//=============================================================================
+// GzipEncoder - Streaming gzip, one fixed-Huffman block per write()
+//=============================================================================
+class GzipEncoder {
+public:
+    // Compress `size` bytes, appending output to `out`
+    void write(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+        out_ = &out;
+        if (!started_) writeHeader();
+        crc_ = crc32(crc_, data, size);
+        totalIn_ += size;
+        if (size > 0) {
+            putBits(0, 1);  // Not final
+            putBits(1, 2);  // Fixed Huffman
+            compressBlock(data, size);
+            putSymbol(END_OF_BLOCK);
+        }
+        out_ = nullptr;
+    }
+
+    // End the stream: final empty block, then the gzip trailer
+    void finish(std::vector<uint8_t>& out) {
+        out_ = &out;
+        if (!started_) writeHeader();
+        putBits(1, 1);  // Final
+        putBits(1, 2);
+        putSymbol(END_OF_BLOCK);
+        if (bitCount_ > 0) putBits(0, 8 - bitCount_);  // Byte-align
+        for (int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(crc_ >> (8 * i)));
+        for (int i = 0; i < 4; i++) out.push_back(static_cast<uint8_t>(totalIn_ >> (8 * i)));
+        out_ = nullptr;
+    }
+
+private:
+    static constexpr int END_OF_BLOCK = 256;
+    static constexpr int MIN_MATCH = 3;
+    static constexpr int MAX_MATCH = 258;
+    static constexpr size_t WINDOW = 32768;
+    static constexpr int HASH_BITS = 15;
+    static constexpr int MAX_PROBES = 16;
+
+    std::vector<uint8_t>* out_ = nullptr;
+    uint64_t bits_ = 0;
+    int bitCount_ = 0;
+    bool started_ = false;
+    uint32_t crc_ = 0;
+    uint32_t totalIn_ = 0;  // Modulo 2^32, as gzip's ISIZE
+    std::vector<int32_t> head_;
+    std::vector<int32_t> prev_;
+
+    void writeHeader() {
+        static const uint8_t HEADER[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+        out_->insert(out_->end(), HEADER, HEADER + 10);
+        started_ = true;
+    }
+
+    void putBits(uint32_t value, int count) {
+        bits_ |= static_cast<uint64_t>(value) << bitCount_;
+        bitCount_ += count;
+        while (bitCount_ >= 8) {
+            out_->push_back(static_cast<uint8_t>(bits_));
+            bits_ >>= 8;
+            bitCount_ -= 8;
+        }
+    }
+
+    // Huffman codes go out most significant bit first
+    void putCode(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; i++) reversed |= ((code >> i) & 1) << (length - 1 - i);
+        putBits(reversed, length);
+    }
+
+    // Fixed literal/length code (RFC 1951 3.2.6)
+    void putSymbol(int symbol) {
+        if (symbol < 144) putCode(0x30 + symbol, 8);
+        else if (symbol < 256) putCode(0x190 + symbol - 144, 9);
+        else if (symbol < 280) putCode(symbol - 256, 7);
+        else putCode(0xC0 + symbol - 280, 8);
+    }
+
+    void putMatch(int length, int distance) {
+        static const uint16_t LENGTH_BASE[29] = {
+            3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+            35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const uint8_t LENGTH_EXTRA[29] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const uint16_t DIST_BASE[30] = {
+            1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+            257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+        static const uint8_t DIST_EXTRA[30] = {
+            0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+            7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        int l = 28;
+        while (LENGTH_BASE[l] > length) l--;
+        putSymbol(257 + l);
+        putBits(length - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+
+        int d = 29;
+        while (DIST_BASE[d] > distance) d--;
+        putCode(d, 5);
+        putBits(distance - DIST_BASE[d], DIST_EXTRA[d]);
+    }
+
+    static uint32_t hash(const uint8_t* p) {
+        uint32_t v = (static_cast<uint32_t>(p[0]) << 16) | (p[1] << 8) | p[2];
+        return (v * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void insert(const uint8_t* data, size_t i) {
+        uint32_t h = hash(data + i);
+        prev_[i] = head_[h];
+        head_[h] = static_cast<int32_t>(i);
+    }
+
+    // Greedy LZ77 within the block
+    void compressBlock(const uint8_t* data, size_t size) {
+        head_.assign(size_t(1) << HASH_BITS, -1);
+        prev_.resize(size);
+
+        size_t i = 0;
+        while (i < size) {
+            int bestLength = 0;
+            size_t bestDistance = 0;
+
+            if (i + MIN_MATCH <= size) {
+                size_t limit = std::min<size_t>(MAX_MATCH, size - i);
+                int32_t candidate = head_[hash(data + i)];
+                for (int probe = 0; candidate >= 0 && probe < MAX_PROBES; probe++) {
+                    size_t distance = i - static_cast<size_t>(candidate);
+                    if (distance > WINDOW) break;
+                    const uint8_t* a = data + candidate;
+                    const uint8_t* b = data + i;
+                    size_t length = 0;
+                    while (length < limit && a[length] == b[length]) length++;
+                    if (static_cast<int>(length) > bestLength) {
+                        bestLength = static_cast<int>(length);
+                        bestDistance = distance;
+                        if (length == limit) break;
+                    }
+                    candidate = prev_[candidate];
+                }
+                insert(data, i);
+            }
+
+            if (bestLength >= MIN_MATCH) {
+                putMatch(bestLength, static_cast<int>(bestDistance));
+                for (size_t j = i + 1; j < i + bestLength && j + MIN_MATCH <= size; j++) insert(data, j);
+                i += bestLength;
+            } else {
+                putSymbol(data[i]);
+                i++;
+            }
+        }
+    }
+};
+
+} // namespace deflate
+} // namespace enen
@@ -0,0 +1,399 @@
+#pragma once
+/**
+ * Evolved int8 network for enen Demo
+ *
+ * A multilayer perceptron with int8 weights that is trained without
+ * gradients by a (1+lambda) evolution strategy over the replay buffer:
+ * - Each generation mutates the current weights into lambda offspring
+ *   (Gaussian steps on a random subset of weights, rounded to int8).
+ * - Parent and offspring are scored on every replay sample (squared
+ *   output error), and the best one becomes the new parent. Ties go to
+ *   the offspring, so the search can drift across flat regions.
+ * - The step size follows the 1/5 success rule: it grows after an
+ *   improving generation and shrinks otherwise.
+ *
+ * The networks it is meant for are tiny (XORNet has 17 weights,
+ * SequenceNet 18), so one candidate scores the whole history in well
+ * under a microsecond, and a generation is lambda + 1 of those. With
+ * enough work per generation (large lambda or a long history) the
+ * candidates are scored on several threads; below that, waking them would
+ * cost more than it saves, and they are scored on the calling thread.
+ * The scoring threads are started on the first such generation and kept
+ * (ScoringPool) until the network is destroyed. Results do not depend on
+ * the thread count: all mutations are drawn up front from the network's
+ * own RNG.
+ *
+ * Topologies are limited to MAX_LAYERS unit layers of at most MAX_UNITS
+ * units (activations live in fixed arrays on the stack); the constructor
+ * throws std::invalid_argument beyond that.
+ *
+ * Same calling convention as intgr_nn::IntegerGD for inference (uint8
+ * tensors in and out). backward() does nothing; the wrapper sees
+ * evolves() through NetBackend and trains with evolve() instead.
+ *
+ * Arithmetic: a weight w stands for w / 16 (so -7.9 to 7.9), inputs and
+ * activations are 0-255 for 0-1. A unit sums w * x + b * 255 in int32 and
+ * looks the result up in a 256-entry sigmoid table, 1/16 per entry.
+ * Inference is const and keeps its activations on the stack, so any
+ * number of threads can score one network.
+ */
+
+#include <intgr_nn/intgr_nn.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace enen {
+
+struct EvolutionConfig {
+    int offspring = 8;              // lambda
+    int threads = 0;                // Scoring threads (0 = one per CPU)
+    size_t parallelWork = 1 << 16;  // Weight-sample products per generation
+                                    // before scoring goes multithreaded
+};
+
+//=============================================================================
+// ScoringPool - Helper threads that run one job per generation
+//
+// run(job) calls job(t) on every thread, t = 0 being the caller, and
+// returns when all are done. Helpers sleep between generations.
+//=============================================================================
+class ScoringPool {
+public:
+    explicit ScoringPool(size_t helpers) {
+        for (size_t t = 1; t <= helpers; t++) threads_.emplace_back([this, t] { loop(t); });
+    }
+
+    ~ScoringPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) thread.join();
+    }
+
+    ScoringPool(const ScoringPool&) = delete;
+    ScoringPool& operator=(const ScoringPool&) = delete;
+
+    size_t threads() const { return threads_.size() + 1; }
+
+    void run(const std::function<void(size_t)>& job) {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            job_ = &job;
+            pending_ = threads_.size();
+            round_++;
+        }
+        wake_.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> guard(lock_);
+        done_.wait(guard, [this] { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex lock_;
+    std::condition_variable wake_;  // New round (or stopping)
+    std::condition_variable done_;  // Last helper finished its part
+    const std::function<void(size_t)>* job_ = nullptr;
+    size_t pending_ = 0;
+    uint64_t round_ = 0;
+    bool stopping_ = false;
+
+    void loop(size_t t) {
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(size_t)>* job;
+            {
+                std::unique_lock<std::mutex> guard(lock_);
+                wake_.wait(guard, [&] { return stopping_ || round_ != seen; });
+                if (stopping_) return;
+                seen = round_;
+                job = job_;
+            }
+            (*job)(t);
+            std::lock_guard<std::mutex> guard(lock_);
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+};
+
+class EvolvedMLP {
+public:
+    static constexpr size_t MAX_LAYERS = 4;  // Unit layers, input and output included
+    static constexpr size_t MAX_UNITS = 8;   // Per unit layer
+
+    // Unit activations of one forward (0-255)
+    struct Activations {
+        uint8_t units[MAX_LAYERS][MAX_UNITS];
+    };
+
+    // Lifetime counters
+    struct Stats {
+        uint64_t generations = 0;
+        uint64_t improvements = 0;     // Generations whose best offspring beat the parent
+        uint64_t parallelGenerations = 0;
+    };
+
+    EvolvedMLP(size_t inputs, std::initializer_list<size_t> hidden, size_t outputs,
+               EvolutionConfig config = EvolutionConfig())
+        : config_(config) {
+        sizes_.push_back(inputs);
+        for (size_t h : hidden) sizes_.push_back(h);
+        sizes_.push_back(outputs);
+        if (sizes_.size() > MAX_LAYERS) {
+            throw std::invalid_argument("EvolvedMLP: more than MAX_LAYERS unit layers");
+        }
+        for (size_t units : sizes_) {
+            if (units == 0 || units > MAX_UNITS) {
+                throw std::invalid_argument("EvolvedMLP: layer size outside 1..MAX_UNITS");
+            }
+        }
+
+        size_t genes = 0;
+        for (size_t l = 0; l + 1 < sizes_.size(); l++) {
+            offsets_.push_back(genes);
+            genes += sizes_[l + 1] * (sizes_[l] + 1);  // Weights, then biases
+        }
+        genome_.resize(genes);
+        config_.offspring = std::max(1, config_.offspring);
+        candidates_.resize(static_cast<size_t>(config_.offspring + 1) * genes);
+        errors_.resize(static_cast<size_t>(config_.offspring) + 1);
+
+        reinitialize(std::random_device{}());
+    }
+
+    void reinitialize(uint32_t seed) {
+        rng_.seed(seed);
+        std::uniform_int_distribution<int> dist(-INIT_RANGE, INIT_RANGE);
+        for (size_t l = 0; l + 1 < sizes_.size(); l++) {
+            int8_t* w = &genome_[offsets_[l]];
+            size_t weights = sizes_[l + 1] * sizes_[l];
+            for (size_t k = 0; k < weights; k++) w[k] = static_cast<int8_t>(dist(rng_));
+            for (size_t j = 0; j < sizes_[l + 1]; j++) w[weights + j] = 0;
+        }
+        sigma_ = SIGMA_START;
+    }
+
+    // Inference (reentrant)
+    intgr_nn::Tensor forward(const intgr_nn::Tensor& input, Activations* trace = nullptr) const {
+        Activations local;
+        Activations& act = trace ? *trace : local;
+        for (size_t i = 0; i < sizes_[0]; i++) act.units[0][i] = input.at_u8(0, i);
+        run(genome_.data(), act);
+
+        intgr_nn::Tensor output(1, sizes_.back());
+        for (size_t j = 0; j < sizes_.back(); j++) output.at_u8(0, j) = act.units[sizes_.size() - 1][j];
+        return output;
+    }
+
+    void forwardBatch(const uint8_t* inputs, size_t count, uint8_t* outputs) const {
+        size_t in = sizes_[0];
+        size_t out = sizes_.back();
+        Activations act;
+        for (size_t r = 0; r < count; r++) {
+            for (size_t i = 0; i < in; i++) act.units[0][i] = inputs[r * in + i];
+            run(genome_.data(), act);
+            for (size_t j = 0; j < out; j++) outputs[r * out + j] = act.units[sizes_.size() - 1][j];
+        }
+    }
+
+    // No gradient step: trained with evolve()
+    void backward(const intgr_nn::Tensor& /*output*/, const intgr_nn::Tensor& /*target*/) {}
+
+    // One generation over count samples (row-major uint8 inputs and
+    // targets). Returns true once every output of every sample is within
+    // SOLVED_MARGIN of its target.
+    bool evolve(const uint8_t* inputs, const uint8_t* targets, size_t count) {
+        size_t genes = genome_.size();
+        int lambda = config_.offspring;
+
+        // Candidate 0 is the parent; the rest are mutants of it
+        std::copy(genome_.begin(), genome_.end(), candidates_.begin());
+        std::normal_distribution<float> step(0.0f, sigma_);
+        std::uniform_real_distribution<float> coin(0.0f, 1.0f);
+        std::uniform_int_distribution<size_t> pick(0, genes - 1);
+        float rate = std::max(MUTATION_RATE, 1.0f / static_cast<float>(genes));
+        for (int c = 1; c <= lambda; c++) {
+            int8_t* child = &candidates_[static_cast<size_t>(c) * genes];
+            std::copy(genome_.begin(), genome_.end(), child);
+            bool mutated = false;
+            for (size_t g = 0; g < genes; g++) {
+                if (coin(rng_) >= rate) continue;
+                mutate(child[g], step(rng_));
+                mutated = true;
+            }
+            if (!mutated) mutate(child[pick(rng_)], step(rng_));
+        }
+
+        scoreCandidates(inputs, targets, count);
+
+        size_t best = 1;
+        for (size_t c = 2; c < errors_.size(); c++) {
+            if (errors_[c].value < errors_[best].value) best = c;
+        }
+        bool improved = errors_[best].value < errors_[0].value;
+        if (errors_[best].value <= errors_[0].value) {
+            std::copy_n(&candidates_[best * genes], genes, genome_.begin());
+        } else {
+            best = 0;
+        }
+        sigma_ = improved ? std::min(sigma_ * SIGMA_GROW, SIGMA_MAX)
+                          : std::max(sigma_ * SIGMA_SHRINK, SIGMA_MIN);
+        stats_.generations++;
+        stats_.improvements += improved;
+
+        return solved(&candidates_[best * genes], inputs, targets, count);
+    }
+
+    size_t parameterCount() const { return genome_.size(); }
+    size_t modelSizeBytes() const { return genome_.size() * sizeof(int8_t); }
+    double learningRate() const { return sigma_ / WEIGHT_SCALE; }  // Current step size, in weight units
+    const Stats& stats() const { return stats_; }
+    const EvolutionConfig& config() const { return config_; }
+
+    // Introspection: unit layers are input, hidden..., output
+    size_t unitLayers() const { return sizes_.size(); }
+    size_t unitCount(size_t layer) const { return sizes_[layer]; }
+
+    // Weight layer l connects unit layer l to l + 1
+    float weight(size_t l, size_t out, size_t in) const {
+        return genome_[offsets_[l] + out * sizes_[l] + in] / WEIGHT_SCALE;
+    }
+    float bias(size_t l, size_t out) const {
+        return genome_[offsets_[l] + sizes_[l + 1] * sizes_[l] + out] / WEIGHT_SCALE;
+    }
+
+private:
+    static constexpr float WEIGHT_SCALE = 16.0f;
+    static constexpr int INIT_RANGE = 32;          // Initial weights within +-2.0
+    static constexpr float SIGMA_START = 8.0f;
+    static constexpr float SIGMA_MIN = 1.0f;
+    static constexpr float SIGMA_MAX = 48.0f;
+    static constexpr float SIGMA_GROW = 1.5f;
+    static constexpr float SIGMA_SHRINK = 0.9f;   // About four misses undo one success
+    static constexpr float MUTATION_RATE = 0.25f;  // Share of weights changed per offspring
+    static constexpr int SOLVED_MARGIN = 96;
+
+    std::vector<size_t> sizes_;
+    std::vector<size_t> offsets_;     // Start of each weight layer in a genome
+    std::vector<int8_t> genome_;      // Current weights: per layer [out * in + in], then biases
+    std::vector<int8_t> candidates_;  // Parent and offspring of the generation in progress
+    // One candidate's error, alone on its cache line: scoring threads
+    // write neighbouring candidates
+    struct alignas(64) Error {
+        int64_t value = 0;
+    };
+
+    std::vector<Error> errors_;
+    std::unique_ptr<ScoringPool> pool_;  // Started by the first parallel generation
+    std::mt19937 rng_;
+    float sigma_ = SIGMA_START;
+    EvolutionConfig config_;
+    Stats stats_;
+
+    static const std::array<uint8_t, 256>& sigmoidTable() {
+        static const std::array<uint8_t, 256> table = [] {
+            std::array<uint8_t, 256> t{};
+            for (int i = 0; i < 256; i++) {
+                double x = (i - 128) / WEIGHT_SCALE;
+                t[i] = static_cast<uint8_t>(std::lround(255.0 / (1.0 + std::exp(-x))));
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    static void mutate(int8_t& gene, float step) {
+        int v = gene + static_cast<int>(std::lround(step));
+        gene = static_cast<int8_t>(std::clamp(v, -127, 127));
+    }
+
+    // Forward one genome; act.units[0] holds the input
+    void run(const int8_t* genome, Activations& act) const {
+        const auto& table = sigmoidTable();
+        for (size_t l = 0; l + 1 < sizes_.size(); l++) {
+            size_t in = sizes_[l];
+            const int8_t* w = genome + offsets_[l];
+            const int8_t* b = w + sizes_[l + 1] * in;
+            for (size_t j = 0; j < sizes_[l + 1]; j++) {
+                int32_t sum = b[j] * 255;
+                for (size_t i = 0; i < in; i++) sum += w[j * in + i] * act.units[l][i];
+                int index = std::clamp(sum / 255 + 128, 0, 255);
+                act.units[l + 1][j] = table[index];
+            }
+        }
+    }
+
+    int64_t error(const int8_t* genome, const uint8_t* inputs, const uint8_t* targets,
+                  size_t count) const {
+        size_t in = sizes_[0];
+        size_t out = sizes_.back();
+        size_t last = sizes_.size() - 1;
+        Activations act;
+        int64_t total = 0;
+        for (size_t r = 0; r < count; r++) {
+            for (size_t i = 0; i < in; i++) act.units[0][i] = inputs[r * in + i];
+            run(genome, act);
+            for (size_t j = 0; j < out; j++) {
+                int d = act.units[last][j] - targets[r * out + j];
+                total += d * d;
+            }
+        }
+        return total;
+    }
+
+    bool solved(const int8_t* genome, const uint8_t* inputs, const uint8_t* targets,
+                size_t count) const {
+        size_t in = sizes_[0];
+        size_t out = sizes_.back();
+        size_t last = sizes_.size() - 1;
+        Activations act;
+        for (size_t r = 0; r < count; r++) {
+            for (size_t i = 0; i < in; i++) act.units[0][i] = inputs[r * in + i];
+            run(genome, act);
+            for (size_t j = 0; j < out; j++) {
+                if (std::abs(act.units[last][j] - targets[r * out + j]) >= SOLVED_MARGIN) return false;
+            }
+        }
+        return true;
+    }
+
+    // errors_[c] for every candidate, on several threads when worth it
+    void scoreCandidates(const uint8_t* inputs, const uint8_t* targets, size_t count) {
+        size_t genes = genome_.size();
+        size_t n = errors_.size();
+        auto score = [&](size_t first, size_t stride) {
+            for (size_t c = first; c < n; c += stride) {
+                errors_[c].value = error(&candidates_[c * genes], inputs, targets, count);
+            }
+        };
+
+        size_t threads = config_.threads > 0 ? static_cast<size_t>(config_.threads)
+                                             : std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, n);
+        if (threads <= 1 || n * count * genes < config_.parallelWork) {
+            score(0, 1);
+            return;
+        }
+
+        if (!pool_) pool_ = std::make_unique<ScoringPool>(threads - 1);
+        size_t stride = pool_->threads();
+        pool_->run([&](size_t t) { score(t, stride); });
+        stats_.parallelGenerations++;
+    }
+};
+
+} // namespace enen
@@ -0,0 +1,189 @@
+#pragma once
+/**
+ * Float reference network for enen Demo
+ *
+ * A plain float32 multilayer perceptron with the same topologies and the
+ * same calling convention as intgr_nn::IntegerGD (uint8 tensors in and out,
+ * forward() then backward() per sample). It exists only as a baseline, so
+ * the integer networks can be measured against a conventional float MLP
+ * running the identical experience-replay loop.
+ *
+ * - Sigmoid units on every layer, inputs scaled from 0-255 to 0-1
+ * - Outputs scaled back to 0-255 so interpretBool() works unchanged
+ * - Squared-error loss, plain SGD, one update per backward()
+ *
+ * Inference is reentrant: the const forward(input, scratch) and
+ * forwardBatch() keep all per-call state in a caller-owned Scratch, so any
+ * number of threads can score one network as long as none is training it.
+ * The one-argument forward() is the training pass; it keeps its
+ * activations for the backward() that follows.
+ */
+
+#include <intgr_nn/intgr_nn.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace enen {
+
+class FloatMLP {
+public:
+    // Plain SGD on sigmoid units needs a larger step than IntgrNN's 0.1
+    static constexpr float LEARNING_RATE = 0.5f;
+
+    FloatMLP(size_t inputs, std::initializer_list<size_t> hidden, size_t outputs) {
+        sizes_.push_back(inputs);
+        for (size_t h : hidden) sizes_.push_back(h);
+        sizes_.push_back(outputs);
+
+        for (size_t l = 0; l + 1 < sizes_.size(); l++) {
+            weights_.emplace_back(sizes_[l] * sizes_[l + 1]);
+            biases_.emplace_back(sizes_[l + 1]);
+        }
+        deltas_.resize(sizes_.size());
+        for (size_t l = 0; l < sizes_.size(); l++) deltas_[l].resize(sizes_[l]);
+
+        reinitialize(std::random_device{}());
+    }
+
+    void reinitialize(uint32_t seed) {
+        std::mt19937 gen(seed);
+        for (size_t l = 0; l < weights_.size(); l++) {
+            // Xavier-uniform range keeps the sigmoids out of saturation
+            float limit = std::sqrt(6.0f / static_cast<float>(sizes_[l] + sizes_[l + 1]));
+            std::uniform_real_distribution<float> dist(-limit, limit);
+            for (float& w : weights_[l]) w = dist(gen);
+            for (float& b : biases_[l]) b = 0.0f;
+        }
+    }
+
+    // Per-call inference state (one per thread)
+    struct Scratch {
+        std::vector<std::vector<float>> activations;  // Per unit layer
+        std::vector<float> batchIn, batchOut;         // forwardBatch()
+    };
+
+    // Training forward: activations are kept for backward()
+    intgr_nn::Tensor forward(const intgr_nn::Tensor& input) { return forward(input, train_); }
+
+    // Reentrant forward: all per-call state lives in scratch
+    intgr_nn::Tensor forward(const intgr_nn::Tensor& input, Scratch& scratch) const {
+        auto& act = scratch.activations;
+        act.resize(sizes_.size());
+        for (size_t l = 0; l < sizes_.size(); l++) act[l].resize(sizes_[l]);
+
+        for (size_t i = 0; i < sizes_[0]; i++) {
+            act[0][i] = input.at_u8(0, i) / 255.0f;
+        }
+        for (size_t l = 0; l < weights_.size(); l++) {
+            const float* w = weights_[l].data();
+            for (size_t j = 0; j < sizes_[l + 1]; j++) {
+                float sum = biases_[l][j];
+                for (size_t i = 0; i < sizes_[l]; i++) {
+                    sum += w[j * sizes_[l] + i] * act[l][i];
+                }
+                act[l + 1][j] = sigmoid(sum);
+            }
+        }
+
+        intgr_nn::Tensor output(1, sizes_.back());
+        for (size_t j = 0; j < sizes_.back(); j++) {
+            output.at_u8(0, j) = static_cast<uint8_t>(std::lround(act.back()[j] * 255.0f));
+        }
+        return output;
+    }
+
+    // Score count input rows (row-major uint8) in one pass per layer
+    void forwardBatch(const uint8_t* inputs, size_t count, uint8_t* outputs,
+                      Scratch& scratch) const {
+        size_t widest = 0;
+        for (size_t size : sizes_) widest = std::max(widest, size);
+        auto& batchIn = scratch.batchIn;
+        auto& batchOut = scratch.batchOut;
+        batchIn.resize(count * widest);
+        batchOut.resize(count * widest);
+
+        for (size_t k = 0; k < count * sizes_[0]; k++) batchIn[k] = inputs[k] / 255.0f;
+
+        for (size_t l = 0; l < weights_.size(); l++) {
+            size_t in = sizes_[l];
+            size_t out = sizes_[l + 1];
+            const float* w = weights_[l].data();
+            for (size_t r = 0; r < count; r++) {
+                const float* a = &batchIn[r * in];
+                for (size_t j = 0; j < out; j++) {
+                    float sum = biases_[l][j];
+                    for (size_t i = 0; i < in; i++) sum += w[j * in + i] * a[i];
+                    batchOut[r * out + j] = sigmoid(sum);
+                }
+            }
+            batchIn.swap(batchOut);
+        }
+
+        for (size_t k = 0; k < count * sizes_.back(); k++) {
+            outputs[k] = static_cast<uint8_t>(std::lround(batchIn[k] * 255.0f));
+        }
+    }
+
+    // Gradient step for the sample passed to the last forward()
+    void backward(const intgr_nn::Tensor& /*output*/, const intgr_nn::Tensor& target) {
+        const auto& activations = train_.activations;
+        size_t last = sizes_.size() - 1;
+        for (size_t j = 0; j < sizes_[last]; j++) {
+            float y = activations[last][j];
+            deltas_[last][j] = (y - target.at_u8(0, j) / 255.0f) * y * (1.0f - y);
+        }
+
+        for (size_t l = last; l-- > 0;) {
+            float* w = weights_[l].data();
+            for (size_t i = 0; i < sizes_[l]; i++) deltas_[l][i] = 0.0f;
+
+            for (size_t j = 0; j < sizes_[l + 1]; j++) {
+                float d = deltas_[l + 1][j];
+                for (size_t i = 0; i < sizes_[l]; i++) {
+                    deltas_[l][i] += w[j * sizes_[l] + i] * d;
+                    w[j * sizes_[l] + i] -= LEARNING_RATE * d * activations[l][i];
+                }
+                biases_[l][j] -= LEARNING_RATE * d;
+            }
+            for (size_t i = 0; i < sizes_[l]; i++) {
+                float a = activations[l][i];
+                deltas_[l][i] *= a * (1.0f - a);
+            }
+        }
+    }
+
+    size_t parameterCount() const {
+        size_t count = 0;
+        for (size_t l = 0; l < weights_.size(); l++) {
+            count += weights_[l].size() + biases_[l].size();
+        }
+        return count;
+    }
+
+    size_t modelSizeBytes() const { return parameterCount() * sizeof(float); }
+    double learningRate() const { return LEARNING_RATE; }
+
+    // Introspection: unit layers are input, hidden..., output
+    size_t unitLayers() const { return sizes_.size(); }
+    size_t unitCount(size_t layer) const { return sizes_[layer]; }
+
+    // Weight layer l connects unit layer l to l + 1
+    float weight(size_t l, size_t out, size_t in) const { return weights_[l][out * sizes_[l] + in]; }
+    float bias(size_t l, size_t out) const { return biases_[l][out]; }
+
+private:
+    std::vector<size_t> sizes_;
+    std::vector<std::vector<float>> weights_;      // [layer][out * in_size + in]
+    std::vector<std::vector<float>> biases_;
+    Scratch train_;                                // Last training forward
+    std::vector<std::vector<float>> deltas_;       // Backward scratch
+
+    static float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+};
+
+} // namespace enen
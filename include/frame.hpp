@@ -5,12 +5,14 @@
  * Provides:
  * - TextBuffer: Fixed 80x24 character buffer with drawing primitives
  * - FrameWriter: Outputs frames in asciinema v2 format with timing
+ * - CastSink: Optional destination for FrameWriter output (default stdout)
  * - ansi:: namespace: Terminal escape codes for amber monochrome
  *
  * Design: Encapsulates all frame state (time, first_frame flag) in FrameWriter
  * rather than using global variables. TextBuffer is stateless and reusable.
  */
 
+#include <algorithm>
 #include <string>
 #include <cstring>
 #include <cstdio>
@@ -72,6 +74,25 @@ public:
         }
     }
 
+    // Copy `length` characters (no terminator needed), clipped to the row
+    void blit(int x, int y, const char* text, int length) {
+        if (y < 0 || y >= terminal::HEIGHT || x >= terminal::WIDTH) return;
+        if (x < 0) {
+            text -= x;
+            length += x;
+            x = 0;
+        }
+        length = std::min(length, terminal::WIDTH - x);
+        if (length > 0) std::memcpy(&buffer_[y][x], text, length);
+    }
+
+    // Row y from column x, for formatters that write known lengths in
+    // place (text.hpp); nullptr when (x, y) is off-screen
+    char* span(int x, int y) {
+        if (x < 0 || x >= terminal::WIDTH || y < 0 || y >= terminal::HEIGHT) return nullptr;
+        return &buffer_[y][x];
+    }
+
     void putChar(int x, int y, char c) {
         if (x >= 0 && x < terminal::WIDTH && y >= 0 && y < terminal::HEIGHT) {
             buffer_[y][x] = c;
@@ -95,6 +116,19 @@ private:
     char buffer_[terminal::HEIGHT][terminal::WIDTH + 1];
 };
 
+//=============================================================================
+// CastSink - Where cast text goes (stdout when none is given)
+//
+// Implemented by CastStream (cast_stream.hpp) for compressed output.
+//=============================================================================
+class CastSink {
+public:
+    virtual ~CastSink() = default;
+    virtual void write(const char* data, size_t size) = 0;
+
+    void write(const std::string& text) { write(text.data(), text.size()); }
+};
+
 //=============================================================================
 // FrameWriter - Outputs asciinema v2 format frames with timing
 //
@@ -105,26 +139,50 @@ private:
 //=============================================================================
 class FrameWriter {
 public:
-    FrameWriter() : time_(0.0), firstFrame_(true) {}
+    explicit FrameWriter(CastSink* sink = nullptr) : time_(0.0), firstFrame_(true), sink_(sink) {}
 
     // Write asciinema header (call once at start)
     void writeHeader() {
         time_t now = std::time(nullptr);
-        std::printf("{\"version\": 2, \"width\": %d, \"height\": %d, "
-                    "\"timestamp\": %ld, \"env\": {\"TERM\": \"xterm-256color\"}}\n",
-                    terminal::WIDTH, terminal::HEIGHT, now);
+        char header[160];
+        std::snprintf(header, sizeof(header),
+                      "{\"version\": 2, \"width\": %d, \"height\": %d, "
+                      "\"timestamp\": %ld, \"env\": {\"TERM\": \"xterm-256color\"}}\n",
+                      terminal::WIDTH, terminal::HEIGHT, static_cast<long>(now));
+        emit(header);
     }
 
     // Output a frame from TextBuffer
     void outputFrame(const TextBuffer& buffer, double pauseAfter = 0.0) {
-        std::string content = buildFrameContent(buffer);
-        outputRawFrame(content, pauseAfter);
+        std::string event;
+        appendFrame(event, buffer, time_, firstFrame_);
+        firstFrame_ = false;
+        emit(event);
+        time_ += pauseAfter;
+    }
+
+    // Output already formatted event lines (e.g. from appendFrame)
+    void outputEvents(const std::string& events) {
+        emit(events);
+    }
+
+    // Append one frame as an asciinema event line at the given time.
+    // Stateless, so frames can be formatted out of order or on several
+    // threads and stitched together afterwards.
+    static void appendFrame(std::string& out, const TextBuffer& buffer,
+                            double time, bool firstFrame) {
+        char stamp[32];
+        std::snprintf(stamp, sizeof(stamp), "[%.3f, \"o\", \"", time);
+        out += stamp;
+        out += escapeForJson(buildFrameContent(buffer, firstFrame));
+        out += "\"]\n";
     }
 
     // Output a raw string frame (for custom content)
     void outputRawFrame(const std::string& content, double pauseAfter = 0.0) {
-        std::string escaped = escapeForJson(content);
-        std::printf("[%.3f, \"o\", \"%s\"]\n", time_, escaped.c_str());
+        char stamp[32];
+        std::snprintf(stamp, sizeof(stamp), "[%.3f, \"o\", \"", time_);
+        emit(stamp + escapeForJson(content) + "\"]\n");
         time_ += pauseAfter;
     }
 
@@ -133,17 +191,19 @@ public:
 private:
     double time_;
     bool firstFrame_;
+    CastSink* sink_;
 
-    std::string buildFrameContent(const TextBuffer& buffer) {
-        std::string result;
-
-        // First frame sets colors, subsequent frames just clear
-        if (firstFrame_) {
-            result = ansi::INIT;
-            firstFrame_ = false;
+    void emit(const std::string& text) {
+        if (sink_) {
+            sink_->write(text);
         } else {
-            result = ansi::CLEAR;
+            std::fwrite(text.data(), 1, text.size(), stdout);
         }
+    }
+
+    static std::string buildFrameContent(const TextBuffer& buffer, bool firstFrame) {
+        // First frame sets colors, subsequent frames just clear
+        std::string result = firstFrame ? ansi::INIT : ansi::CLEAR;
 
         // Append each line (already padded to WIDTH)
         for (int y = 0; y < terminal::HEIGHT; y++) {
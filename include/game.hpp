@@ -8,12 +8,19 @@
 
 #include "networks.hpp"
 #include "puzzles.hpp"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <random>
 #include <string>
 #include <vector>
 #include <functional>
 
 namespace enen {
 
+namespace metrics { struct Shard; }
+namespace workload { class Capture; }
+
 // Event types for logging/UI
 enum class EventType {
     TRIAL_START,
@@ -32,6 +39,24 @@ struct GameEvent {
 // Callback for game events (UI can subscribe)
 using EventCallback = std::function<void(const GameEvent&)>;
 
+// Seed for RNG substream `stream` of `base` (splitmix64 finalizer), so
+// neighbouring streams are uncorrelated
+inline uint32_t substreamSeed(uint32_t base, int stream) {
+    uint64_t z = ((static_cast<uint64_t>(base) << 32) | static_cast<uint32_t>(stream))
+                 + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    uint32_t seed = static_cast<uint32_t>(z);
+    return seed ? seed : 1;  // xorshift32 must not start at 0
+}
+
+// Outcome of one puzzle in a full-demo run
+struct PuzzleResult {
+    int trials = -1;       // Trials to completion (-1 = did not complete / not run)
+    double seconds = 0.0;  // Wall time
+};
+
 // Game state - contains all puzzle state
 struct GameState {
     PuzzleType current_puzzle = PuzzleType::GENERALIZATION;
@@ -56,6 +81,7 @@ struct GameState {
 
     // RNG
     RNG rng;
+    uint32_t paired_seed = 0;  // seedPaired() seed (0 = one stream for the run)
 
     // Current trial data (for UI display)
     MushroomTrial current_mushroom;
@@ -63,7 +89,9 @@ struct GameState {
     XORTrial current_xor;
     CompositionTrial current_composition;
 
-    GameState(uint32_t seed = 12345) : rng(seed) {}
+    GameState(uint32_t seed = 12345, Backend backend = Backend::INTEGER)
+        : gen_net(backend), feat_net(backend), xor_net(backend),
+          seq_net(backend), comp_net(backend), rng(seed) {}
 
     void reset() {
         validator.reset();
@@ -71,6 +99,46 @@ struct GameState {
         puzzle_complete = false;
     }
 
+    // Return to the state of GameState(seed) in place: back to Puzzle 1,
+    // every network re-drawn with fresh random weights, its replay
+    // history emptied and its batch policy back to the default. Network objects and replay buffer capacity are
+    // reused, so a pooled state starts a run without reallocating them.
+    // The gauntlet mode is kept, as with reset().
+    void reinitialize(uint32_t seed) {
+        current_puzzle = PuzzleType::GENERALIZATION;
+        demo_complete = false;
+        reset();
+        std::random_device weights;  // Opened once for all five networks
+        gen_net.reset(weights());
+        feat_net.reset(weights());
+        xor_net.reset(weights());
+        seq_net.reset(weights());
+        comp_net.reset(weights());
+        seq_puzzle.reset();
+        rng = RNG(seed);
+        paired_seed = 0;
+        current_mushroom = MushroomTrial();
+        current_shape = ShapeTrial();
+        current_xor = XORTrial();
+        current_composition = CompositionTrial();
+    }
+
+    // Common random numbers, for paired comparisons of learner settings:
+    // every network's starting weights and each puzzle's trial stream come
+    // from `seed` alone. States seeded alike start from the same weights
+    // (for the same backend) and see the same trials in every puzzle,
+    // however many the puzzles before took. Call at the start of a run;
+    // resetNetwork() still draws fresh random weights.
+    void seedPaired(uint32_t seed) {
+        paired_seed = seed ? seed : 1;
+        gen_net.reset(substreamSeed(paired_seed, NUM_PUZZLES + 0));
+        feat_net.reset(substreamSeed(paired_seed, NUM_PUZZLES + 1));
+        xor_net.reset(substreamSeed(paired_seed, NUM_PUZZLES + 2));
+        seq_net.reset(substreamSeed(paired_seed, NUM_PUZZLES + 3));
+        comp_net.reset(substreamSeed(paired_seed, NUM_PUZZLES + 4));
+        rng = RNG(substreamSeed(paired_seed, static_cast<int>(current_puzzle)));
+    }
+
     void resetNetwork() {
         switch (current_puzzle) {
             case PuzzleType::GENERALIZATION:
@@ -101,6 +169,7 @@ struct GameState {
         }
         current_puzzle = static_cast<PuzzleType>(next);
         reset();
+        if (paired_seed) rng = RNG(substreamSeed(paired_seed, next));
         return true;
     }
 
@@ -112,11 +181,24 @@ struct GameState {
 // Game logic - runs puzzles, emits events
 class Game {
 public:
-    Game(uint32_t seed = 12345);
+    Game(uint32_t seed = 12345, Backend backend = Backend::INTEGER);
 
     // Set event callback for UI
     void setEventCallback(EventCallback cb) { callback_ = cb; }
 
+    // Publish trial, learn() and mastery counters to a metrics shard
+    // (metrics.hpp) owned by the calling thread; nullptr to stop
+    void setMetrics(metrics::Shard* shard) { metrics_ = shard; }
+
+    // Record every trial and its timing into `capture` (workload.hpp),
+    // starting a new session there; nullptr to stop
+    void setCapture(workload::Capture* capture);
+
+    // Start over as Game(seed) would, reusing this game's networks and
+    // replay buffers (GameState::reinitialize). The event callback, metrics
+    // shard and capture stay attached; a capture starts a new session.
+    void reinitialize(uint32_t seed);
+
     // Access state (for UI display)
     const GameState& state() const { return state_; }
     GameState& state() { return state_; }
@@ -139,9 +221,34 @@ public:
     // Returns true if all completed successfully
     bool runFullDemo(int maxTrialsPerPuzzle = 1000);
 
+    // Run all 5 puzzles at once, one thread each. Each puzzle draws its
+    // trials from its own RNG substream (derived from this game's RNG), so
+    // results do not depend on thread timing. Trained networks and final
+    // puzzle state are merged back at the end; events are delivered after
+    // all puzzles finish, in puzzle order.
+    // Returns true if all completed successfully
+    bool runFullDemoParallel(int maxTrialsPerPuzzle = 1000);
+
+    // Per-puzzle results of the last runFullDemo / runFullDemoParallel
+    const PuzzleResult& puzzleResult(PuzzleType type) const {
+        return results_[static_cast<int>(type)];
+    }
+
 private:
     GameState state_;
     EventCallback callback_;
+    metrics::Shard* metrics_ = nullptr;
+    workload::Capture* capture_ = nullptr;
+    std::array<PuzzleResult, NUM_PUZZLES> results_{};
+
+    bool runCurrentTrial();
+
+    // net.learn...(), timed into metrics_ when set
+    template <class Learn>
+    void learnTimed(const IntgrNNWrapper& net, Learn learn);
+
+    // runPuzzleToCompletion, timed
+    PuzzleResult runTimedPuzzle(int maxTrials);
 
     void emit(EventType type, const std::string& msg, bool success = false);
 
@@ -153,4 +260,24 @@ private:
     bool runPuzzle5Trial();
 };
 
+// Preconstructed games for back-to-back runs (seed sweeps, tests).
+// acquire(seed) hands out a released game reinitialized for `seed`, or
+// builds a new one when none is free; release() detaches its callback,
+// metrics and capture and keeps it for the next acquire. Thread-safe.
+class GamePool {
+public:
+    explicit GamePool(Backend backend = Backend::INTEGER, size_t preconstructed = 0);
+
+    std::unique_ptr<Game> acquire(uint32_t seed);
+    void release(std::unique_ptr<Game> game);
+
+    size_t available() const;
+    Backend backend() const { return backend_; }
+
+private:
+    Backend backend_;
+    mutable std::mutex lock_;
+    std::vector<std::unique_ptr<Game>> free_;
+};
+
 } // namespace enen
@@ -0,0 +1,159 @@
+#pragma once
+/**
+ * Animated GIF writer for enen Demo
+ *
+ * Minimal GIF89a encoder for the rasterized frames in raster.hpp:
+ * - Global 2-color palette (background, text)
+ * - Each frame is a sub-image at an offset, drawn over the previous frame
+ *   (disposal "do not dispose"), so unchanged regions are not re-encoded
+ * - encodeLzw() is a pure function of the pixels: frames can be
+ *   compressed on several threads and written in order afterwards
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace enen {
+namespace gif {
+
+// Smallest LZW code size GIF allows; covers our 2 colors
+constexpr int MIN_CODE_SIZE = 2;
+
+//=============================================================================
+// Frame - One encoded sub-image
+//=============================================================================
+struct Frame {
+    uint16_t x = 0, y = 0;
+    uint16_t width = 0, height = 0;
+    uint16_t delay = 0;         // Hundredths of a second
+    std::vector<uint8_t> data;  // LZW code size byte + data sub-blocks
+};
+
+//=============================================================================
+// encodeLzw - Compress palette indices (< 4) into GIF image data
+//=============================================================================
+inline std::vector<uint8_t> encodeLzw(const uint8_t* pixels, size_t count) {
+    constexpr int ALPHABET = 1 << MIN_CODE_SIZE;
+    constexpr int CLEAR = ALPHABET;
+    constexpr int END = ALPHABET + 1;
+    constexpr int MAX_CODE = 4095;
+
+    std::vector<uint8_t> out;
+    out.push_back(MIN_CODE_SIZE);
+
+    // Sub-blocks of at most 255 bytes, each prefixed with its length
+    uint8_t block[255];
+    int blockLen = 0;
+    auto putByte = [&](uint8_t b) {
+        block[blockLen++] = b;
+        if (blockLen == 255) {
+            out.push_back(255);
+            out.insert(out.end(), block, block + 255);
+            blockLen = 0;
+        }
+    };
+
+    uint32_t bits = 0;
+    int bitCount = 0;
+    int codeSize = MIN_CODE_SIZE + 1;
+    auto putCode = [&](int code) {
+        bits |= static_cast<uint32_t>(code) << bitCount;
+        bitCount += codeSize;
+        while (bitCount >= 8) {
+            putByte(static_cast<uint8_t>(bits));
+            bits >>= 8;
+            bitCount -= 8;
+        }
+    };
+
+    // Dictionary as a trie: child[code * ALPHABET + symbol], 0 = none
+    std::vector<uint16_t> child((MAX_CODE + 1) * ALPHABET, 0);
+    int lastCode = END;
+
+    putCode(CLEAR);
+    int prefix = -1;
+    for (size_t i = 0; i < count; i++) {
+        int symbol = pixels[i];
+        if (prefix < 0) {
+            prefix = symbol;
+            continue;
+        }
+        uint16_t& next = child[prefix * ALPHABET + symbol];
+        if (next) {
+            prefix = next;
+            continue;
+        }
+
+        putCode(prefix);
+        next = static_cast<uint16_t>(++lastCode);
+        if (lastCode >= (1 << codeSize)) codeSize++;
+        if (lastCode == MAX_CODE) {
+            putCode(CLEAR);
+            std::fill(child.begin(), child.end(), 0);
+            codeSize = MIN_CODE_SIZE + 1;
+            lastCode = END;
+        }
+        prefix = symbol;
+    }
+    if (prefix >= 0) putCode(prefix);
+    putCode(END);
+
+    if (bitCount > 0) putByte(static_cast<uint8_t>(bits));
+    if (blockLen > 0) {
+        out.push_back(static_cast<uint8_t>(blockLen));
+        out.insert(out.end(), block, block + blockLen);
+    }
+    out.push_back(0);  // Block terminator
+    return out;
+}
+
+//=============================================================================
+// write - Header and palette, then the frames in order (plays once)
+//=============================================================================
+inline bool write(std::FILE* file, int width, int height,
+                  const uint8_t background[3], const uint8_t foreground[3],
+                  const std::vector<Frame>& frames) {
+    auto u8 = [file](int v) { std::fputc(v & 0xFF, file); };
+    auto u16 = [&u8](int v) {
+        u8(v);
+        u8(v >> 8);
+    };
+
+    // Header + logical screen with a 2-entry global color table
+    std::fwrite("GIF89a", 1, 6, file);
+    u16(width);
+    u16(height);
+    u8(0x80);  // Global color table, 2 entries
+    u8(0);     // Background color index
+    u8(0);     // Square pixels
+    for (int i = 0; i < 3; i++) u8(background[i]);
+    for (int i = 0; i < 3; i++) u8(foreground[i]);
+
+    for (const auto& frame : frames) {
+        // Graphic control: keep previous frame under this one, set delay
+        u8(0x21);
+        u8(0xF9);
+        u8(4);
+        u8(1 << 2);  // Disposal: do not dispose
+        u16(frame.delay);
+        u8(0);  // No transparency
+        u8(0);
+
+        // Image descriptor (no local color table) + data
+        u8(0x2C);
+        u16(frame.x);
+        u16(frame.y);
+        u16(frame.width);
+        u16(frame.height);
+        u8(0);
+        std::fwrite(frame.data.data(), 1, frame.data.size(), file);
+    }
+
+    u8(0x3B);  // Trailer
+    return std::ferror(file) == 0;
+}
+
+} // namespace gif
+} // namespace enen
@@ -0,0 +1,186 @@
+#pragma once
+/**
+ * Decision heatmap for enen Demo
+ *
+ * Shows the learned decision boundary under the brain diagram, for the
+ * puzzles with two meaningful inputs:
+ * - Size:       size A (x) vs size B (y), colors held at the current trial
+ * - Context:    light (x) vs path (y)
+ * - Everything: size A (x) vs size B (y), light held at the current trial
+ *
+ * The grid comes from one batched inference call (DecisionGrid) and the
+ * text rows are built once per grid. update() re-scores only when the
+ * network's weights or the held inputs changed, so redrawing a frame
+ * between learn() calls is just a copy of the cached rows. DecisionMap is
+ * the same cache without the rows, for grids drawn later (autorun).
+ *
+ * Layout (41 x 10, right column):
+ *   " decision map          @ pick A  . pick B"
+ *   "    127|@@@@@@@@@@@@@@@@@@@@@@@@@.......|"
+ *   " size B|..."
+ *   "      0|........................@@@@@@@@|"
+ *   "       0         size A             127 "
+ */
+
+#include "brain_diagram.hpp"
+#include "frame.hpp"
+#include "networks.hpp"
+#include <cstdio>
+#include <cstring>
+
+namespace enen {
+
+// What a decision map's axes and legend say
+struct DecisionAxes {
+    const char* legend;
+    const char* x;
+    const char* y;
+};
+
+//=============================================================================
+// DecisionMap - the scored grid alone, re-scored only when the network's
+// weights or the held inputs changed (what a recorded frame keeps)
+//=============================================================================
+class DecisionMap {
+public:
+    static constexpr DecisionAxes SIZE_AXES = {"@ pick A  . pick B", "size A", "size B"};
+    static constexpr DecisionAxes CONTEXT_AXES = {"@ safe  . danger", "light", "path"};
+
+    // Refresh for the net's current weights. Returns true if the grid was
+    // re-scored, false if the cached one was still current.
+    bool update(const GeneralizationNet& net, int16_t colorA, int16_t colorB) {
+        return refresh({&net, net.weightsVersion(), colorA, colorB}, SIZE_AXES,
+                       [&](DecisionGrid& grid) { net.decisionGrid(colorA, colorB, grid); });
+    }
+
+    bool update(const XORNet& net) {
+        return refresh({&net, net.weightsVersion(), 0, 0}, CONTEXT_AXES,
+                       [&](DecisionGrid& grid) { net.decisionGrid(grid); });
+    }
+
+    bool update(const CompositionNet& net, int16_t light) {
+        return refresh({&net, net.weightsVersion(), light, 0}, SIZE_AXES,
+                       [&](DecisionGrid& grid) { net.decisionGrid(light, grid); });
+    }
+
+    // Take a grid scored elsewhere (the next update() re-scores)
+    void assign(const DecisionGrid& grid, const DecisionAxes& axes) {
+        grid_ = grid;
+        axes_ = &axes;
+        key_ = {nullptr, 0, 0, 0};
+        valid_ = true;
+    }
+
+    bool valid() const { return valid_; }
+    const DecisionGrid& grid() const { return grid_; }
+    const DecisionAxes& axes() const { return *axes_; }
+
+    // Number of times the grid was actually scored
+    uint64_t evaluations() const { return evaluations_; }
+
+private:
+    struct Key {
+        const IntgrNNWrapper* net;
+        uint64_t version;
+        int16_t a, b;  // Inputs held fixed across the grid
+
+        bool operator==(const Key& o) const {
+            return net == o.net && version == o.version && a == o.a && b == o.b;
+        }
+    };
+
+    DecisionGrid grid_;
+    const DecisionAxes* axes_ = &SIZE_AXES;
+    Key key_ = {nullptr, 0, 0, 0};
+    bool valid_ = false;
+    uint64_t evaluations_ = 0;
+
+    template <class Score>
+    bool refresh(const Key& key, const DecisionAxes& axes, Score score) {
+        if (valid_ && key == key_) return false;
+        score(grid_);
+        axes_ = &axes;
+        key_ = key;
+        valid_ = true;
+        evaluations_++;
+        return true;
+    }
+};
+
+//=============================================================================
+// DecisionHeatmap - a DecisionMap and its text rows, built once per grid
+//=============================================================================
+class DecisionHeatmap {
+public:
+    static constexpr int WIDTH = 41;
+    static constexpr int HEIGHT = static_cast<int>(DecisionGrid::ROWS) + 2;
+
+    // DecisionMap::update() for any puzzle's network, then the rows if the
+    // grid was re-scored
+    template <class Net, class... Held>
+    bool update(const Net& net, Held... held) {
+        if (!map_.update(net, held...)) return false;
+        format();
+        return true;
+    }
+
+    // Show a recorded grid
+    void show(const DecisionGrid& grid, const DecisionAxes& axes) {
+        map_.assign(grid, axes);
+        format();
+    }
+
+    bool valid() const { return map_.valid(); }
+    const DecisionGrid& grid() const { return map_.grid(); }
+    const char* row(int r) const { return rows_[r]; }
+    uint64_t evaluations() const { return map_.evaluations(); }
+
+    void draw(TextBuffer& buffer, int x, int y) const {
+        if (!valid()) return;
+        for (int r = 0; r < HEIGHT; r++) buffer.putString(x, y + r, rows_[r]);
+    }
+
+private:
+    DecisionMap map_;
+    char rows_[HEIGHT][WIDTH + 1] = {};
+
+    void format() {
+        constexpr int LABEL = 7;  // Column of the left grid border
+        constexpr int COLS = static_cast<int>(DecisionGrid::COLS);
+        const DecisionGrid& grid = map_.grid();
+        const DecisionAxes& axes = map_.axes();
+
+        auto blank = [](char* line) {
+            std::memset(line, ' ', WIDTH);
+            line[WIDTH] = '\0';
+        };
+        auto place = [](char* line, int x, const char* str) {
+            for (int i = 0; str[i] && x + i < WIDTH; i++) line[x + i] = str[i];
+        };
+
+        blank(rows_[0]);
+        place(rows_[0], 1, "decision map");
+        place(rows_[0], WIDTH - static_cast<int>(std::strlen(axes.legend)), axes.legend);
+
+        for (int r = 0; r < static_cast<int>(DecisionGrid::ROWS); r++) {
+            char* line = rows_[r + 1];
+            blank(line);
+            if (r == 0) place(line, LABEL - 3, "127");
+            if (r == static_cast<int>(DecisionGrid::ROWS) / 2) {
+                place(line, LABEL - static_cast<int>(std::strlen(axes.y)), axes.y);
+            }
+            if (r == static_cast<int>(DecisionGrid::ROWS) - 1) place(line, LABEL - 1, "0");
+            line[LABEL] = '|';
+            for (int c = 0; c < COLS; c++) line[LABEL + 1 + c] = activityGlyph(grid.cells[r][c]);
+            line[LABEL + 1 + COLS] = '|';
+        }
+
+        char* axis = rows_[HEIGHT - 1];
+        blank(axis);
+        place(axis, LABEL + 1, "0");
+        place(axis, LABEL + 1 + (COLS - static_cast<int>(std::strlen(axes.x))) / 2, axes.x);
+        place(axis, LABEL + 1 + COLS - 3, "127");
+    }
+};
+
+} // namespace enen
@@ -8,81 +8,71 @@
 
 #include "frame.hpp"
 #include "layout.hpp"
-#include <vector>
-#include <string>
-#include <cstdio>
+#include "text.hpp"
+#include <cstdint>
 
 namespace enen {
 
-//=============================================================================
-// HistoryEntry - A single trial result
-//=============================================================================
-struct HistoryEntry {
-    int trialNum;
-    bool correct;
-    std::string summary;  // Brief description of what happened
-};
-
 //=============================================================================
 // History - Rolling window of recent trials
 //
-// Keeps the last MAX_ENTRIES trials. Older entries are discarded.
+// Keeps the last MAX_ENTRIES trials. Older entries are overwritten.
 // Designed for display in the history section of puzzle screens.
+//
+// Each entry is formatted once, when it is added, into a fixed-width line
+// slot of a ring: no allocation or shifting per trial, and drawing is one
+// blit per row. History is trivially copyable (autorun keeps one per frame).
 //=============================================================================
 class History {
 public:
     static constexpr size_t MAX_ENTRIES = 4;
-
-    void add(int trialNum, bool correct, const std::string& summary) {
-        entries_.push_back({trialNum, correct, summary});
-        while (entries_.size() > MAX_ENTRIES) {
-            entries_.erase(entries_.begin());
-        }
+    static constexpr int LINE_WIDTH = 50;  // Longer lines are truncated
+
+    // "  Trial N: [OK] summary" or "  Trial N: [X] summary"
+    void add(int trialNum, bool correct, const char* summary) {
+        Slot& slot = slots_[head_];
+        slot.length = static_cast<uint8_t>(text::format(slot.text, sizeof(slot.text),
+                                                        ENEN_FORMAT("  Trial {}: {} {}"),
+                                                        trialNum, correct ? "[OK]" : "[X]", summary));
+        head_ = (head_ + 1) % MAX_ENTRIES;
+        if (count_ < MAX_ENTRIES) count_++;
     }
 
     void clear() {
-        entries_.clear();
+        head_ = 0;
+        count_ = 0;
     }
 
-    const std::vector<HistoryEntry>& entries() const {
-        return entries_;
-    }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
 
-    bool empty() const {
-        return entries_.empty();
-    }
+    // i = 0 is the most recent entry; not NUL-terminated, see lineLength()
+    const char* line(size_t i) const { return slots_[slotIndex(i)].text; }
+    int lineLength(size_t i) const { return slots_[slotIndex(i)].length; }
 
 private:
-    std::vector<HistoryEntry> entries_;
+    struct Slot {
+        char text[LINE_WIDTH + 1];
+        uint8_t length;
+    };
+
+    Slot slots_[MAX_ENTRIES] = {};
+    size_t head_ = 0;   // Next slot to write
+    size_t count_ = 0;
+
+    size_t slotIndex(size_t i) const { return (head_ + MAX_ENTRIES - 1 - i) % MAX_ENTRIES; }
 };
 
 //=============================================================================
 // drawHistory - Render history entries to a TextBuffer
 //
 // Draws most recent entries first (reverse chronological order).
-// Each entry shows: "Trial N: [OK] summary" or "Trial N: [X] summary"
 //=============================================================================
 inline void drawHistory(TextBuffer& buffer, const History& history, int startY) {
     buffer.putString(0, startY, "HISTORY:");
 
-    const auto& entries = history.entries();
-    for (size_t i = 0; i < entries.size() && static_cast<int>(startY + 1 + i) < terminal::HEIGHT - 2; i++) {
-        // Show most recent first
-        size_t idx = entries.size() - 1 - i;
-        const auto& entry = entries[idx];
-
-        char line[60];
-        std::snprintf(line, sizeof(line), "  Trial %d: %s %s",
-                      entry.trialNum,
-                      entry.correct ? "[OK]" : "[X]",
-                      entry.summary.c_str());
-
-        // Truncate if too long
-        if (std::strlen(line) > 50) {
-            line[50] = '\0';
-        }
-
-        buffer.putString(0, startY + 1 + static_cast<int>(i), line);
+    for (size_t i = 0; i < history.size() && static_cast<int>(startY + 1 + i) < terminal::HEIGHT - 2; i++) {
+        buffer.blit(0, startY + 1 + static_cast<int>(i), history.line(i), history.lineLength(i));
     }
 }
 
@@ -9,7 +9,7 @@
  * +--LEFT COLUMN (38 chars)-------------+--RIGHT COLUMN (41 chars)------------+
  * | Header, rule, progress              | Brain diagram box                    |
  * | Trial details                       |                                      |
- * | History                             |                                      |
+ * | History                             | Decision heatmap (some puzzles)      |
  * +-------------------------------------+--------------------------------------+
  * | Controls footer                                                            |
  * +----------------------------------------------------------------------------+
@@ -37,6 +37,8 @@ namespace timing {
     constexpr double COMPLETION = 4.0;     // Puzzle completed message
     constexpr double VICTORY = 8.0;        // Final victory screen
     constexpr double SEQUENCE_STEP = 0.8;  // Intermediate step in sequence puzzle
+    constexpr double ARENA_TICK = 0.5;     // One trial for every creature in the arena
+    constexpr double ARENA_END = 6.0;      // Arena after the last creature finishes
 }
 
 //=============================================================================
@@ -98,6 +100,12 @@ namespace layout {
         constexpr int HEIGHT = 10;  // 11 for composition (extra row)
     }
 
+    // Decision heatmap (right column, below the tallest brain box)
+    namespace heatmap {
+        constexpr int X = RIGHT_COLUMN_START;
+        constexpr int Y = 11;  // Rows 11-20
+    }
+
     // Intro screens (centered content)
     namespace intro {
         constexpr int TITLE_X = 29;
@@ -117,6 +125,16 @@ namespace layout {
         constexpr int SIZE_Y = 17;
     }
 
+    // Arena (arena.hpp): 4x4 tiles of 20x5 between header and legend
+    namespace arena {
+        constexpr int TITLE_Y = 0;
+        constexpr int TICK_X = 45;
+        constexpr int RULE_Y = 1;
+        constexpr int TILES_Y = 2;
+        constexpr int DIVIDER_Y = 22;
+        constexpr int LEGEND_Y = 23;
+    }
+
     // Puzzle intro (left side explanation)
     namespace puzzle_intro {
         constexpr int TITLE_X = 4;
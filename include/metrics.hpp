@@ -0,0 +1,277 @@
+#pragma once
+/**
+ * Live metrics for enen Demo
+ *
+ * A long-running process publishes its counters in a shared-memory
+ * segment (/dev/shm/<name>) that enen-top maps read-only:
+ * - One Shard per worker thread, cache-line aligned. Only its worker
+ *   writes it, so updates are a relaxed load and store - no locked
+ *   read-modify-write, no shared cache lines on the hot path
+ * - Readers sum the shards whenever they like; a counter may be one
+ *   update behind, never torn (64-bit atomics)
+ * - Each worker constructs its own shard (initShard) after pinning, so
+ *   first touch puts the shard's page on the worker's NUMA node
+ *
+ * Counters: trials, learn() calls with a log2 latency histogram, replay
+ * history sizes at each learn(), puzzles mastered, creatures that gave
+ * up, and frame overruns (trials slower than the frame budget - a
+ * creature driving a live display would have dropped a frame).
+ *
+ * On hosts without /dev/shm the segment lives in process memory: the
+ * counters still work, but nothing outside the process can see them.
+ */
+
+#include "puzzles.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace enen {
+namespace metrics {
+
+constexpr uint32_t MAGIC = 0x6E656E65;  // "enen"
+constexpr uint32_t VERSION = 1;
+constexpr int LATENCY_BUCKETS = 32;     // Bucket b: [2^b, 2^(b+1)) ns
+
+//=============================================================================
+// Counter - Single-writer 64-bit counter, readable from other processes
+//=============================================================================
+class Counter {
+public:
+    // Owning thread only
+    void add(uint64_t n) {
+        value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    void raise(uint64_t n) {
+        if (n > value_.load(std::memory_order_relaxed)) value_.store(n, std::memory_order_relaxed);
+    }
+
+    // Any thread or process
+    uint64_t load() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+    static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                  "counters must be lock-free to live in shared memory");
+};
+
+inline int latencyBucket(uint64_t nanos) {
+    int b = 0;
+    while (nanos > 1 && b < LATENCY_BUCKETS - 1) {
+        nanos >>= 1;
+        b++;
+    }
+    return b;
+}
+
+//=============================================================================
+// Shard - One worker's counters
+//=============================================================================
+struct alignas(64) Shard {
+    uint64_t frameBudgetNs = 0;  // Set before the worker starts
+    Counter trials;
+    Counter frameOverruns;
+    Counter learnCalls;
+    Counter learnNanos;
+    Counter replaySamples;       // Sum of replay sizes at each learn()
+    Counter replayMax;
+    Counter mastered[NUM_PUZZLES];
+    Counter gaveUp;              // Creatures that hit the trial limit
+    Counter learnLatency[LATENCY_BUCKETS];
+
+    void recordTrial(uint64_t nanos) {
+        trials.add(1);
+        if (frameBudgetNs > 0 && nanos > frameBudgetNs) frameOverruns.add(1);
+    }
+
+    void recordLearn(uint64_t nanos, size_t replaySize) {
+        learnCalls.add(1);
+        learnNanos.add(nanos);
+        learnLatency[latencyBucket(nanos)].add(1);
+        replaySamples.add(replaySize);
+        replayMax.raise(replaySize);
+    }
+
+    void recordMastery(PuzzleType puzzle) { mastered[static_cast<int>(puzzle)].add(1); }
+    void recordGaveUp() { gaveUp.add(1); }
+};
+
+//=============================================================================
+// Header - Start of the segment, followed by `shards` Shards
+//=============================================================================
+struct alignas(64) Header {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t shards = 0;
+    uint32_t puzzles = 0;
+    int64_t pid = 0;
+    char label[48] = {};             // What is running, for the viewer
+    std::atomic<uint32_t> running{0};  // Cleared when the publisher finishes
+};
+static_assert(std::is_standard_layout<Header>::value, "Header fields are read by offset");
+
+inline size_t segmentSize(uint32_t shards) { return sizeof(Header) + shards * sizeof(Shard); }
+
+//=============================================================================
+// Segment - Create (publisher) or map read-only (viewer)
+//=============================================================================
+class Segment {
+public:
+    Segment() = default;
+    ~Segment() { close(); }
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    // Publisher: a fresh segment with room for `shards` shards, each made
+    // by initShard(). Falls back to process memory (and returns false) if
+    // /dev/shm/<name> cannot be made.
+    bool create(const std::string& name, uint32_t shards, const char* label) {
+        close();
+        size_ = segmentSize(shards);
+        bool shared = false;
+#ifdef __linux__
+        std::string path = "/dev/shm/" + name;
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd < 0 && errno == EEXIST && abandoned(path)) {
+            ::unlink(path.c_str());
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        }
+        if (fd >= 0) {
+            if (::ftruncate(fd, static_cast<off_t>(size_)) == 0) {
+                void* p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (p != MAP_FAILED) {
+                    base_ = static_cast<char*>(p);
+                    mapped_ = true;
+                    path_ = path;
+                    shared = true;
+                }
+            }
+            ::close(fd);
+            if (!shared) ::unlink(path.c_str());
+        }
+#endif
+        if (!base_) base_ = static_cast<char*>(::operator new(size_, std::align_val_t(64)));
+
+        // The header only: shards are left to their workers (the shared
+        // file reads as zeros until then, like a fresh Shard)
+        Header* h = new (base_) Header();
+        h->shards = shards;
+        h->puzzles = NUM_PUZZLES;
+#ifdef __linux__
+        h->pid = ::getpid();
+#endif
+        std::strncpy(h->label, label, sizeof(h->label) - 1);
+        h->running.store(1, std::memory_order_relaxed);
+        h->version = VERSION;
+        std::atomic_thread_fence(std::memory_order_release);
+        h->magic = MAGIC;
+        owner_ = true;
+        return shared;
+    }
+
+    // Publisher, on the worker thread that will own shard `i` (after it
+    // is pinned): zeroed counters with the given frame budget
+    Shard* initShard(uint32_t i, uint64_t frameBudgetNs) {
+        Shard* shard = new (base_ + sizeof(Header) + i * sizeof(Shard)) Shard();
+        shard->frameBudgetNs = frameBudgetNs;
+        return shard;
+    }
+
+    // Viewer: map an existing segment read-only. False if absent or not ours.
+    bool openReadOnly(const std::string& name) {
+        close();
+#ifdef __linux__
+        std::string path = "/dev/shm/" + name;
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        off_t size = ::lseek(fd, 0, SEEK_END);
+        if (size >= static_cast<off_t>(sizeof(Header))) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) {
+                base_ = static_cast<char*>(p);
+                size_ = static_cast<size_t>(size);
+                mapped_ = true;
+            }
+        }
+        ::close(fd);
+        const Header* h = header();
+        if (h && (h->magic != MAGIC || h->version != VERSION || segmentSize(h->shards) > size_)) close();
+        return base_ != nullptr;
+#else
+        (void)name;
+        return false;
+#endif
+    }
+
+    // Publisher done: viewers see running == 0; the name is removed
+    void finish() {
+        if (owner_ && base_) header()->running.store(0, std::memory_order_relaxed);
+#ifdef __linux__
+        if (!path_.empty()) ::unlink(path_.c_str());
+#endif
+        path_.clear();
+    }
+
+    void close() {
+        if (!base_) return;
+        if (owner_) finish();
+#ifdef __linux__
+        if (mapped_) ::munmap(base_, size_);
+#endif
+        if (!mapped_) ::operator delete(base_, std::align_val_t(64));
+        base_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        owner_ = false;
+    }
+
+    bool valid() const { return base_ != nullptr; }
+    Header* header() { return reinterpret_cast<Header*>(base_); }
+    const Header* header() const { return reinterpret_cast<const Header*>(base_); }
+    uint32_t shardCount() const { return base_ ? header()->shards : 0; }
+    Shard* shard(uint32_t i) { return reinterpret_cast<Shard*>(base_ + sizeof(Header) + i * sizeof(Shard)); }
+    const Shard* shard(uint32_t i) const {
+        return reinterpret_cast<const Shard*>(base_ + sizeof(Header) + i * sizeof(Shard));
+    }
+
+private:
+    char* base_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    bool owner_ = false;
+    std::string path_;
+
+#ifdef __linux__
+    // Left behind by a publisher that no longer exists
+    static bool abandoned(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        // Raw bytes: Header holds an atomic, so it is not read() into
+        unsigned char bytes[sizeof(Header)];
+        bool read = ::read(fd, bytes, sizeof(bytes)) == static_cast<ssize_t>(sizeof(bytes));
+        ::close(fd);
+        uint32_t magic = 0;
+        int64_t pid = 0;
+        std::memcpy(&magic, bytes + offsetof(Header, magic), sizeof(magic));
+        std::memcpy(&pid, bytes + offsetof(Header, pid), sizeof(pid));
+        if (!read || magic != MAGIC) return false;
+        return ::kill(static_cast<pid_t>(pid), 0) != 0 && errno == ESRCH;
+    }
+#endif
+};
+
+} // namespace metrics
+} // namespace enen
@@ -12,15 +12,50 @@
  * - Puzzle 4: 1→4→2 (sequence)
  * - Puzzle 5: 3→8→4→1 (composition, deep)
  *
+ * Each wrapper runs on the IntgrNN engine by default; passing
+ * Backend::FLOAT swaps in the float32 reference network (backend.hpp)
+ * with the same topology and the same replay loop, for A/B comparison.
+ *
  * Experience Replay: Each network stores all training samples and
  * retrains on the complete history after each new sample. This is
  * real learning — the viewer watches genuine learning from scratch.
+ *
+ * Interruptible training: learn() runs the whole replay at once, but the
+ * same replay can be started with beginLearn() and advanced in slices with
+ * step(n). The training cursor (epoch, sample) survives between slices, so
+ * a host can spread learning over frames, cancel() it on a scene change, or
+ * restart it when a new trial arrives. Weights only change inside step(),
+ * one whole sample update at a time, so a decision made between slices
+ * always sees a consistent set of weights.
+ *
+ * Evolving backends (Backend::EVOLVED) have no per-sample step. For them
+ * the replay pass encodes the history once and runs one generation per
+ * epoch over all of it; step(n) runs whole generations, each counted as
+ * historySize() updates, and the pass ends early once every sample is
+ * answered correctly.
+ *
+ * Decision maps: puzzles with two meaningful inputs can score a whole
+ * DecisionGrid over those inputs in one batched inference call.
+ * weightsVersion() changes whenever the weights do, so callers can cache
+ * the grid between updates.
+ *
+ * Thread safety: all const methods (chooseA, isSafe, chooseAction,
+ * scoreA/B, decisionGrid, lastForward, ...) may be called from any number
+ * of threads at once, so one trained brain can be shared by many workers.
+ * Each call keeps its scratch on the stack or per thread (see backend.hpp
+ * for how each backend achieves this); no decision takes a lock.
+ * Non-const methods (learn, step, reset, ...) need exclusive access.
+ * lastForward() returns the last decision this network made on the
+ * calling thread.
  */
 
+#include "backend.hpp"
 #include <intgr_nn/intgr_nn.h>
 #include <memory>
 #include <cstdint>
 #include <algorithm>
+#include <atomic>
+#include <limits>
 #include <random>
 #include <vector>
 
@@ -36,13 +71,36 @@ inline bool interpretBool(uint8_t out) {
     return out > 128;
 }
 
+//=============================================================================
+// DecisionGrid - Network output over two inputs, each swept across 0-127
+//
+// Columns sweep x left to right, rows sweep y top (127) to bottom (0).
+//=============================================================================
+struct DecisionGrid {
+    static constexpr size_t COLS = 32;
+    static constexpr size_t ROWS = 8;
+    static constexpr size_t CELLS = COLS * ROWS;
+
+    uint8_t cells[ROWS][COLS] = {};  // Output per cell, >128 = true/A/safe
+
+    static int16_t xAt(size_t col) { return static_cast<int16_t>(col * 127 / (COLS - 1)); }
+    static int16_t yAt(size_t row) { return static_cast<int16_t>((ROWS - 1 - row) * 127 / (ROWS - 1)); }
+};
+
 //=============================================================================
 // Base wrapper with common functionality
 //=============================================================================
 class IntgrNNWrapper {
+public:
+    // Position of the replay pass in progress
+    struct TrainingCursor {
+        int epoch = 0;      // Current epoch (== epochs when idle)
+        size_t sample = 0;  // Next history sample within the epoch
+        int epochs = 0;     // Epochs in this pass
+    };
+
 protected:
-    // mutable: forward() is logically const (inference doesn't change the model)
-    mutable std::unique_ptr<intgr_nn::IntegerGD> net_;
+    std::unique_ptr<NetBackend> net_;
 
     static intgr_nn::Config defaultConfig() {
         intgr_nn::Config config;
@@ -50,22 +108,286 @@ protected:
         return config;
     }
 
+    IntgrNNWrapper(Backend backend, size_t inputs, size_t outputs)
+        : backend_(backend), inputs_(inputs), outputs_(outputs) {}
+
+    // Fill input/target tensors for history sample i
+    virtual void encodeSample(size_t i, intgr_nn::Tensor& input,
+                              intgr_nn::Tensor& target) const = 0;
+
+    // Decision forward (thread-safe). Records the trace, for this thread's
+    // lastForward(), as part of the same pass.
+    intgr_nn::Tensor infer(const intgr_nn::Tensor& input) const {
+        ForwardTrace& trace = threadTrace(traceId_, true);
+        trace = ForwardTrace{};
+        return net_->infer(input, inputs_, outputs_, trace);
+    }
+
+    // Score every grid cell in one batched forward.
+    // encode(x, y, row) fills the input row for one cell.
+    template <class Encode>
+    void inferGrid(DecisionGrid& grid, Encode encode) const {
+        thread_local std::vector<uint8_t> gridInputs;
+        thread_local std::vector<uint8_t> gridOutputs;
+        gridInputs.resize(DecisionGrid::CELLS * inputs_);
+        gridOutputs.resize(DecisionGrid::CELLS * outputs_);
+        for (size_t r = 0; r < DecisionGrid::ROWS; r++) {
+            for (size_t c = 0; c < DecisionGrid::COLS; c++) {
+                uint8_t* row = &gridInputs[(r * DecisionGrid::COLS + c) * inputs_];
+                encode(DecisionGrid::xAt(c), DecisionGrid::yAt(r), row);
+            }
+        }
+
+        net_->forwardBatch(gridInputs.data(), inputs_, DecisionGrid::CELLS,
+                           gridOutputs.data(), outputs_);
+
+        for (size_t r = 0; r < DecisionGrid::ROWS; r++) {
+            for (size_t c = 0; c < DecisionGrid::COLS; c++) {
+                grid.cells[r][c] = gridOutputs[(r * DecisionGrid::COLS + c) * outputs_];
+            }
+        }
+    }
+
+    // Restart the replay from the first sample (called after a new sample is added)
+    void beginReplay(int epochs) {
+        cursor_ = {0, 0, epochs};
+        replayEncoded_ = false;
+    }
+
+    // For samples added without a replay of their own (SequenceNet::addStep):
+    // the encoded history is stale, and a pass in progress restarts so its
+    // every epoch covers the new sample
+    void historyChanged() {
+        replayEncoded_ = false;
+        if (isTraining()) beginReplay(cursor_.epochs);
+    }
+
 public:
     virtual ~IntgrNNWrapper() = default;
 
+    // Movable, so a trained network can be handed between owners (e.g. to a
+    // worker Game and back). Needs exclusive access, like training.
+    // The traces of past decisions go with the network.
+    IntgrNNWrapper(IntgrNNWrapper&& other) noexcept
+        : net_(std::move(other.net_)), backend_(other.backend_),
+          inputs_(other.inputs_), outputs_(other.outputs_), cursor_(other.cursor_),
+          batchEpochs_(other.batchEpochs_), weightsVersion_(nextWeightsVersion()),
+          traceId_(other.traceId_),
+          replayInputs_(std::move(other.replayInputs_)),
+          replayTargets_(std::move(other.replayTargets_)), replayEncoded_(other.replayEncoded_) {
+        other.traceId_ = nextWeightsVersion();
+    }
+
+    IntgrNNWrapper& operator=(IntgrNNWrapper&& other) noexcept {
+        net_ = std::move(other.net_);
+        backend_ = other.backend_;
+        inputs_ = other.inputs_;
+        outputs_ = other.outputs_;
+        cursor_ = other.cursor_;
+        batchEpochs_ = other.batchEpochs_;
+        weightsVersion_ = nextWeightsVersion();
+        traceId_ = other.traceId_;
+        other.traceId_ = nextWeightsVersion();
+        replayInputs_ = std::move(other.replayInputs_);
+        replayTargets_ = std::move(other.replayTargets_);
+        replayEncoded_ = other.replayEncoded_;
+        return *this;
+    }
+
+    // Fresh random weights, no experience and the default batch policy
     void reset(uint32_t seed = 0) {
         if (seed == 0) seed = std::random_device{}();
+        cancel();
         net_->reinitialize(seed);
+        weightsVersion_ = nextWeightsVersion();
+        batchEpochs_ = 0;
         clearHistory();  // Also clear experience
     }
 
     // Subclasses implement these
     virtual void clearHistory() = 0;
     virtual size_t historySize() const = 0;
+    virtual size_t historyBytes() const = 0;  // Replay buffer capacity in bytes
+
+    // Run up to n sample updates of the current replay pass (evolving
+    // backends: at least one whole generation, which may exceed n).
+    // Returns the number of updates performed (0 when idle).
+    size_t step(size_t n = 1) {
+        size_t done = 0;
+        if (!isTraining() || historySize() == 0) {
+            cursor_.epoch = cursor_.epochs;
+            return done;
+        }
+
+        if (net_->evolves()) return evolveGenerations(n);
+
+        intgr_nn::Tensor input(1, inputs_);
+        intgr_nn::Tensor target(1, outputs_);
+        while (done < n && isTraining()) {
+            encodeSample(cursor_.sample, input, target);
+            auto output = net_->forward(input);
+            net_->backward(output, target);
+            done++;
+
+            if (++cursor_.sample >= historySize()) {
+                cursor_.sample = 0;
+                cursor_.epoch++;
+            }
+        }
+        if (done > 0) weightsVersion_ = nextWeightsVersion();
+        return done;
+    }
+
+    // Run the current replay pass to the end
+    void finishTraining() { step(std::numeric_limits<size_t>::max()); }
+
+    // Abandon the current replay pass. Samples stay in history and are
+    // replayed by the next beginLearn()/learn().
+    void cancel() { cursor_.epoch = cursor_.epochs; }
+
+    bool isTraining() const { return cursor_.epoch < cursor_.epochs; }
+    const TrainingCursor& cursor() const { return cursor_; }
+
+    // Sample updates left in the current replay pass
+    size_t remainingSteps() const {
+        if (!isTraining()) return 0;
+        size_t n = historySize();
+        return static_cast<size_t>(cursor_.epochs - cursor_.epoch) * n - cursor_.sample;
+    }
+
+    // Batch policy: epochs of the one replay a learnBatch() runs. 0 (the
+    // default) runs the network's per-trial count, as a single learn()
+    // would; larger batches may want more.
+    void setBatchEpochs(int epochs) { batchEpochs_ = epochs; }
+    int batchEpochs() const { return batchEpochs_; }
 
     size_t parameterCount() const { return net_->parameterCount(); }
     size_t modelSizeBytes() const { return net_->modelSizeBytes(); }
     double learningRate() const { return net_->learningRate(); }
+    Backend backend() const { return backend_; }
+
+    // Changes whenever the weights change (step(), reset() or a move).
+    // Unique across all wrappers, so (wrapper, version) identifies weights.
+    uint64_t weightsVersion() const { return weightsVersion_; }
+
+    // Introspection: activations of the last decision forward on the
+    // calling thread (training forwards are not traced; invalid if there
+    // was none), and per-layer weights where available
+    ForwardTrace lastForward() const {
+        return threadTrace(traceId_, false);
+    }
+    bool layerWeights(size_t layer, LayerWeights& out) const {
+        return net_->layerWeights(layer, out);
+    }
+
+private:
+    // step() for evolving backends: whole generations over the encoded history
+    size_t evolveGenerations(size_t n) {
+        size_t count = historySize();
+        if (!replayEncoded_) {
+            intgr_nn::Tensor input(1, inputs_);
+            intgr_nn::Tensor target(1, outputs_);
+            replayInputs_.resize(count * inputs_);
+            replayTargets_.resize(count * outputs_);
+            for (size_t i = 0; i < count; i++) {
+                encodeSample(i, input, target);
+                for (size_t k = 0; k < inputs_; k++) replayInputs_[i * inputs_ + k] = input.at_u8(0, k);
+                for (size_t k = 0; k < outputs_; k++) replayTargets_[i * outputs_ + k] = target.at_u8(0, k);
+            }
+            replayEncoded_ = true;
+        }
+
+        size_t done = 0;
+        while (done < n && isTraining()) {
+            bool solved = net_->evolve(replayInputs_.data(), replayTargets_.data(), count);
+            done += count;
+            cursor_.epoch = solved ? cursor_.epochs : cursor_.epoch + 1;
+        }
+        weightsVersion_ = nextWeightsVersion();
+        return done;
+    }
+
+    static uint64_t nextWeightsVersion() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    // The calling thread's trace for network `id`. The last few networks
+    // used on a thread keep theirs; `claim` takes the least recently used
+    // slot when `id` has none (otherwise an empty trace is returned).
+    static ForwardTrace& threadTrace(uint64_t id, bool claim) {
+        struct Slot {
+            uint64_t id = 0;
+            uint64_t used = 0;
+            ForwardTrace trace;
+        };
+        static constexpr size_t SLOTS = 8;
+        thread_local Slot slots[SLOTS];
+        thread_local uint64_t clock = 0;
+        thread_local ForwardTrace none;
+
+        Slot* oldest = &slots[0];
+        for (auto& slot : slots) {
+            if (slot.id == id) {
+                slot.used = ++clock;
+                return slot.trace;
+            }
+            if (slot.used < oldest->used) oldest = &slot;
+        }
+        if (!claim) return none = ForwardTrace{};
+        oldest->id = id;
+        oldest->used = ++clock;
+        return oldest->trace;
+    }
+
+    Backend backend_;
+    size_t inputs_;
+    size_t outputs_;
+    TrainingCursor cursor_;
+    int batchEpochs_ = 0;
+    uint64_t weightsVersion_ = nextWeightsVersion();
+    uint64_t traceId_ = nextWeightsVersion();  // Keys this network's per-thread traces
+    std::vector<uint8_t> replayInputs_;   // Evolving backends: history encoded per pass
+    std::vector<uint8_t> replayTargets_;
+    bool replayEncoded_ = false;
+};
+
+//=============================================================================
+// ReplayNet - Experience history and batched learning for one wrapper
+//
+// Sample is the wrapper's experience, fields in learn() order; every new
+// trial replays the whole history for EPOCHS_PER_TRIAL epochs.
+//=============================================================================
+template <class SampleT, int EPOCHS>
+class ReplayNet : public IntgrNNWrapper {
+public:
+    using Sample = SampleT;
+    static constexpr int EPOCHS_PER_TRIAL = EPOCHS;
+
+    // Add several samples and retrain on ALL history once, instead of once
+    // per sample (setBatchEpochs() sets for how long)
+    void learnBatch(const Sample* samples, size_t count) {
+        beginLearnBatch(samples, count);
+        finishTraining();
+    }
+
+    // An empty batch changes nothing
+    void beginLearnBatch(const Sample* samples, size_t count) {
+        if (count == 0) return;
+        history_.insert(history_.end(), samples, samples + count);
+        beginReplay(batchEpochs() > 0 ? batchEpochs() : EPOCHS_PER_TRIAL);
+    }
+
+    void clearHistory() override { history_.clear(); cancel(); }
+    size_t historySize() const override { return history_.size(); }
+    size_t historyBytes() const override { return history_.capacity() * sizeof(Sample); }
+
+protected:
+    // Experience history for replay
+    std::vector<Sample> history_;
+
+    ReplayNet(Backend backend, size_t inputs, size_t outputs)
+        : IntgrNNWrapper(backend, inputs, outputs) {}
 };
 
 //=============================================================================
@@ -74,20 +396,17 @@ public:
 // Output: chooseA (>128 = yes)
 // Goal: Learn that size matters, color doesn't
 //=============================================================================
-class GeneralizationNet : public IntgrNNWrapper {
-    // Experience history for replay
-    struct Sample {
-        int16_t sizeA, sizeB, colorA, colorB;
-        bool chooseA;
-    };
-    std::vector<Sample> history_;
-
-    static constexpr int EPOCHS_PER_TRIAL = 50;
+struct GeneralizationSample {
+    int16_t sizeA, sizeB, colorA, colorB;
+    bool chooseA;
+};
 
+class GeneralizationNet : public ReplayNet<GeneralizationSample, 50> {
 public:
-    GeneralizationNet() {
+    explicit GeneralizationNet(Backend backend = Backend::INTEGER)
+        : ReplayNet(backend, 4, 1) {
         // NO ETG - start with random weights
-        net_ = intgr_nn::IntegerGD::create(4, 8, 1, defaultConfig());
+        net_ = createNet(backend, 4, 8, 1, defaultConfig());
     }
 
     bool chooseA(int16_t sizeA, int16_t sizeB, int16_t colorA, int16_t colorB) const {
@@ -97,35 +416,40 @@ public:
         input.at_u8(0, 2) = scaleToU8(colorA);
         input.at_u8(0, 3) = scaleToU8(colorB);
 
-        auto output = net_->forward(input);
+        auto output = infer(input);
         return interpretBool(output.at_u8(0, 0));
     }
 
-    void learn(int16_t sizeA, int16_t sizeB, int16_t colorA, int16_t colorB, bool shouldChooseA) {
-        // Add to history
-        history_.push_back({sizeA, sizeB, colorA, colorB, shouldChooseA});
-
-        // Retrain on ALL history
-        for (int epoch = 0; epoch < EPOCHS_PER_TRIAL; epoch++) {
-            for (const auto& s : history_) {
-                intgr_nn::Tensor input(1, 4);
-                input.at_u8(0, 0) = scaleToU8(s.sizeA);
-                input.at_u8(0, 1) = scaleToU8(s.sizeB);
-                input.at_u8(0, 2) = scaleToU8(s.colorA);
-                input.at_u8(0, 3) = scaleToU8(s.colorB);
-
-                auto output = net_->forward(input);
+    // Pick-A output over sizeA (x) and sizeB (y) for the given colors
+    void decisionGrid(int16_t colorA, int16_t colorB, DecisionGrid& grid) const {
+        inferGrid(grid, [&](int16_t sizeA, int16_t sizeB, uint8_t* row) {
+            row[0] = scaleToU8(sizeA);
+            row[1] = scaleToU8(sizeB);
+            row[2] = scaleToU8(colorA);
+            row[3] = scaleToU8(colorB);
+        });
+    }
 
-                intgr_nn::Tensor target(1, 1);
-                target.at_u8(0, 0) = s.chooseA ? 255 : 0;
+    void learn(int16_t sizeA, int16_t sizeB, int16_t colorA, int16_t colorB, bool shouldChooseA) {
+        beginLearn(sizeA, sizeB, colorA, colorB, shouldChooseA);
+        finishTraining();
+    }
 
-                net_->backward(output, target);
-            }
-        }
+    // Add to history and start retraining on ALL history (advance with step())
+    void beginLearn(int16_t sizeA, int16_t sizeB, int16_t colorA, int16_t colorB, bool shouldChooseA) {
+        history_.push_back({sizeA, sizeB, colorA, colorB, shouldChooseA});
+        beginReplay(EPOCHS_PER_TRIAL);
     }
 
-    void clearHistory() override { history_.clear(); }
-    size_t historySize() const override { return history_.size(); }
+protected:
+    void encodeSample(size_t i, intgr_nn::Tensor& input, intgr_nn::Tensor& target) const override {
+        const auto& s = history_[i];
+        input.at_u8(0, 0) = scaleToU8(s.sizeA);
+        input.at_u8(0, 1) = scaleToU8(s.sizeB);
+        input.at_u8(0, 2) = scaleToU8(s.colorA);
+        input.at_u8(0, 3) = scaleToU8(s.colorB);
+        target.at_u8(0, 0) = s.chooseA ? 255 : 0;
+    }
 };
 
 //=============================================================================
@@ -134,18 +458,16 @@ public:
 // Output: chooseA (>128 = yes)
 // Goal: Learn that shape matters, color doesn't
 //=============================================================================
-class FeatureSelectionNet : public IntgrNNWrapper {
-    struct Sample {
-        int16_t colorA, shapeA, colorB, shapeB;
-        bool chooseA;
-    };
-    std::vector<Sample> history_;
-
-    static constexpr int EPOCHS_PER_TRIAL = 50;
+struct FeatureSelectionSample {
+    int16_t colorA, shapeA, colorB, shapeB;
+    bool chooseA;
+};
 
+class FeatureSelectionNet : public ReplayNet<FeatureSelectionSample, 50> {
 public:
-    FeatureSelectionNet() {
-        net_ = intgr_nn::IntegerGD::create(4, 8, 1, defaultConfig());
+    explicit FeatureSelectionNet(Backend backend = Backend::INTEGER)
+        : ReplayNet(backend, 4, 1) {
+        net_ = createNet(backend, 4, 8, 1, defaultConfig());
     }
 
     bool chooseA(int16_t colorA, int16_t shapeA, int16_t colorB, int16_t shapeB) const {
@@ -155,33 +477,29 @@ public:
         input.at_u8(0, 2) = scaleToU8(colorB);
         input.at_u8(0, 3) = scaleToU8(shapeB);
 
-        auto output = net_->forward(input);
+        auto output = infer(input);
         return interpretBool(output.at_u8(0, 0));
     }
 
     void learn(int16_t colorA, int16_t shapeA, int16_t colorB, int16_t shapeB, bool shouldChooseA) {
-        history_.push_back({colorA, shapeA, colorB, shapeB, shouldChooseA});
-
-        for (int epoch = 0; epoch < EPOCHS_PER_TRIAL; epoch++) {
-            for (const auto& s : history_) {
-                intgr_nn::Tensor input(1, 4);
-                input.at_u8(0, 0) = scaleToU8(s.colorA);
-                input.at_u8(0, 1) = scaleToU8(s.shapeA);
-                input.at_u8(0, 2) = scaleToU8(s.colorB);
-                input.at_u8(0, 3) = scaleToU8(s.shapeB);
-
-                auto output = net_->forward(input);
-
-                intgr_nn::Tensor target(1, 1);
-                target.at_u8(0, 0) = s.chooseA ? 255 : 0;
+        beginLearn(colorA, shapeA, colorB, shapeB, shouldChooseA);
+        finishTraining();
+    }
 
-                net_->backward(output, target);
-            }
-        }
+    void beginLearn(int16_t colorA, int16_t shapeA, int16_t colorB, int16_t shapeB, bool shouldChooseA) {
+        history_.push_back({colorA, shapeA, colorB, shapeB, shouldChooseA});
+        beginReplay(EPOCHS_PER_TRIAL);
     }
 
-    void clearHistory() override { history_.clear(); }
-    size_t historySize() const override { return history_.size(); }
+protected:
+    void encodeSample(size_t i, intgr_nn::Tensor& input, intgr_nn::Tensor& target) const override {
+        const auto& s = history_[i];
+        input.at_u8(0, 0) = scaleToU8(s.colorA);
+        input.at_u8(0, 1) = scaleToU8(s.shapeA);
+        input.at_u8(0, 2) = scaleToU8(s.colorB);
+        input.at_u8(0, 3) = scaleToU8(s.shapeB);
+        target.at_u8(0, 0) = s.chooseA ? 255 : 0;
+    }
 };
 
 //=============================================================================
@@ -191,19 +509,17 @@ public:
 // Goal: Learn XOR - requires hidden layer
 // NOTE: XOR is hard, needs ~1000 total epochs to converge
 //=============================================================================
-class XORNet : public IntgrNNWrapper {
-    struct Sample {
-        int16_t light, path;
-        bool safe;
-    };
-    std::vector<Sample> history_;
-
-    // XOR needs more epochs - it's a harder problem
-    static constexpr int EPOCHS_PER_TRIAL = 200;
+struct XORSample {
+    int16_t light, path;
+    bool safe;
+};
 
+// XOR needs more epochs - it's a harder problem
+class XORNet : public ReplayNet<XORSample, 200> {
 public:
-    XORNet() {
-        net_ = intgr_nn::IntegerGD::create(2, 4, 1, defaultConfig());
+    explicit XORNet(Backend backend = Backend::INTEGER)
+        : ReplayNet(backend, 2, 1) {
+        net_ = createNet(backend, 2, 4, 1, defaultConfig());
     }
 
     bool isSafe(int16_t light, int16_t path) const {
@@ -211,31 +527,35 @@ public:
         input.at_u8(0, 0) = scaleToU8(light);
         input.at_u8(0, 1) = scaleToU8(path);
 
-        auto output = net_->forward(input);
+        auto output = infer(input);
         return interpretBool(output.at_u8(0, 0));
     }
 
-    void learn(int16_t light, int16_t path, bool shouldBeSafe) {
-        history_.push_back({light, path, shouldBeSafe});
-
-        for (int epoch = 0; epoch < EPOCHS_PER_TRIAL; epoch++) {
-            for (const auto& s : history_) {
-                intgr_nn::Tensor input(1, 2);
-                input.at_u8(0, 0) = scaleToU8(s.light);
-                input.at_u8(0, 1) = scaleToU8(s.path);
-
-                auto output = net_->forward(input);
+    // Safe output over light (x) and path (y)
+    void decisionGrid(DecisionGrid& grid) const {
+        inferGrid(grid, [](int16_t light, int16_t path, uint8_t* row) {
+            row[0] = scaleToU8(light);
+            row[1] = scaleToU8(path);
+        });
+    }
 
-                intgr_nn::Tensor target(1, 1);
-                target.at_u8(0, 0) = s.safe ? 255 : 0;
+    void learn(int16_t light, int16_t path, bool shouldBeSafe) {
+        beginLearn(light, path, shouldBeSafe);
+        finishTraining();
+    }
 
-                net_->backward(output, target);
-            }
-        }
+    void beginLearn(int16_t light, int16_t path, bool shouldBeSafe) {
+        history_.push_back({light, path, shouldBeSafe});
+        beginReplay(EPOCHS_PER_TRIAL);
     }
 
-    void clearHistory() override { history_.clear(); }
-    size_t historySize() const override { return history_.size(); }
+protected:
+    void encodeSample(size_t i, intgr_nn::Tensor& input, intgr_nn::Tensor& target) const override {
+        const auto& s = history_[i];
+        input.at_u8(0, 0) = scaleToU8(s.light);
+        input.at_u8(0, 1) = scaleToU8(s.path);
+        target.at_u8(0, 0) = s.safe ? 255 : 0;
+    }
 };
 
 //=============================================================================
@@ -244,26 +564,24 @@ public:
 // Outputs: scoreA, scoreB (higher wins)
 // Goal: Learn A first, then B
 //=============================================================================
-class SequenceNet : public IntgrNNWrapper {
-    struct Sample {
-        int16_t lastAction;
-        int action;  // 0=A, 1=B
-        bool success;
-    };
-    std::vector<Sample> history_;
-
-    static constexpr int EPOCHS_PER_TRIAL = 50;
+struct SequenceSample {
+    int16_t lastAction;
+    int action;  // 0=A, 1=B
+    bool success;
+};
 
+class SequenceNet : public ReplayNet<SequenceSample, 50> {
 public:
-    SequenceNet() {
-        net_ = intgr_nn::IntegerGD::create(1, 4, 2, defaultConfig());
+    explicit SequenceNet(Backend backend = Backend::INTEGER)
+        : ReplayNet(backend, 1, 2) {
+        net_ = createNet(backend, 1, 4, 2, defaultConfig());
     }
 
-    int chooseAction(int16_t lastAction) {
+    int chooseAction(int16_t lastAction) const {
         intgr_nn::Tensor input(1, 1);
         input.at_u8(0, 0) = scaleToU8(lastAction);
 
-        auto output = net_->forward(input);
+        auto output = infer(input);
         uint8_t scoreA = output.at_u8(0, 0);
         uint8_t scoreB = output.at_u8(0, 1);
 
@@ -271,16 +589,16 @@ public:
     }
 
     // Overload for API compatibility (ignores availA/availB)
-    int chooseAction(int16_t lastAction, int16_t /*availA*/, int16_t /*availB*/) {
+    int chooseAction(int16_t lastAction, int16_t /*availA*/, int16_t /*availB*/) const {
         return chooseAction(lastAction);
     }
 
     // Get raw scores for display
-    void getScores(int16_t lastAction, uint8_t& scoreA, uint8_t& scoreB) {
+    void getScores(int16_t lastAction, uint8_t& scoreA, uint8_t& scoreB) const {
         intgr_nn::Tensor input(1, 1);
         input.at_u8(0, 0) = scaleToU8(lastAction);
 
-        auto output = net_->forward(input);
+        auto output = infer(input);
         scoreA = output.at_u8(0, 0);
         scoreB = output.at_u8(0, 1);
     }
@@ -289,41 +607,34 @@ public:
     int16_t scoreA(int16_t lastAction) const {
         intgr_nn::Tensor input(1, 1);
         input.at_u8(0, 0) = scaleToU8(lastAction);
-        auto output = net_->forward(input);
+        auto output = infer(input);
         return static_cast<int16_t>(output.at_u8(0, 0));
     }
 
     int16_t scoreB(int16_t lastAction) const {
         intgr_nn::Tensor input(1, 1);
         input.at_u8(0, 0) = scaleToU8(lastAction);
-        auto output = net_->forward(input);
+        auto output = infer(input);
         return static_cast<int16_t>(output.at_u8(0, 1));
     }
 
     void learnFromOutcome(int16_t lastAction, int action, bool success) {
+        beginLearnFromOutcome(lastAction, action, success);
+        finishTraining();
+    }
+
+    void beginLearnFromOutcome(int16_t lastAction, int action, bool success) {
         history_.push_back({lastAction, action, success});
+        beginReplay(EPOCHS_PER_TRIAL);
+    }
 
-        for (int epoch = 0; epoch < EPOCHS_PER_TRIAL; epoch++) {
-            for (const auto& s : history_) {
-                intgr_nn::Tensor input(1, 1);
-                input.at_u8(0, 0) = scaleToU8(s.lastAction);
-
-                auto output = net_->forward(input);
-
-                // Target: if success, reinforce chosen action
-                // if failure, reinforce opposite action
-                intgr_nn::Tensor target(1, 2);
-                if (s.success) {
-                    target.at_u8(0, 0) = (s.action == 0) ? 255 : 0;
-                    target.at_u8(0, 1) = (s.action == 1) ? 255 : 0;
-                } else {
-                    target.at_u8(0, 0) = (s.action == 0) ? 0 : 255;
-                    target.at_u8(0, 1) = (s.action == 1) ? 0 : 255;
-                }
-
-                net_->backward(output, target);
-            }
-        }
+    // A step that does not end the episode (A pressed, B still to come):
+    // buffered without a replay. The episode's last step, through
+    // learnFromOutcome(), replays it with the rest in one pass, instead of
+    // a full replay per step.
+    void addStep(int16_t lastAction, int action, bool success) {
+        history_.push_back({lastAction, action, success});
+        historyChanged();
     }
 
     // Overload for API compatibility (ignores availA/availB)
@@ -332,8 +643,21 @@ public:
         learnFromOutcome(lastAction, action, success);
     }
 
-    void clearHistory() override { history_.clear(); }
-    size_t historySize() const override { return history_.size(); }
+protected:
+    void encodeSample(size_t i, intgr_nn::Tensor& input, intgr_nn::Tensor& target) const override {
+        const auto& s = history_[i];
+        input.at_u8(0, 0) = scaleToU8(s.lastAction);
+
+        // Target: if success, reinforce chosen action
+        // if failure, reinforce opposite action
+        if (s.success) {
+            target.at_u8(0, 0) = (s.action == 0) ? 255 : 0;
+            target.at_u8(0, 1) = (s.action == 1) ? 255 : 0;
+        } else {
+            target.at_u8(0, 0) = (s.action == 0) ? 0 : 255;
+            target.at_u8(0, 1) = (s.action == 1) ? 0 : 255;
+        }
+    }
 };
 
 //=============================================================================
@@ -343,19 +667,17 @@ public:
 // Goal: Light ON = pick larger, Light OFF = pick smaller
 // Deep network (3→8→4→1) needs more training
 //=============================================================================
-class CompositionNet : public IntgrNNWrapper {
-    struct Sample {
-        int16_t light, sizeA, sizeB;
-        bool chooseA;
-    };
-    std::vector<Sample> history_;
-
-    // Deep network needs more epochs
-    static constexpr int EPOCHS_PER_TRIAL = 100;
+struct CompositionSample {
+    int16_t light, sizeA, sizeB;
+    bool chooseA;
+};
 
+// Deep network needs more epochs
+class CompositionNet : public ReplayNet<CompositionSample, 100> {
 public:
-    CompositionNet() {
-        net_ = intgr_nn::IntegerGD::createDeep(3, {8, 4}, 1, defaultConfig());
+    explicit CompositionNet(Backend backend = Backend::INTEGER)
+        : ReplayNet(backend, 3, 1) {
+        net_ = createDeepNet(backend, 3, 8, 4, 1, defaultConfig());
     }
 
     bool chooseA(int16_t light, int16_t sizeA, int16_t sizeB) const {
@@ -364,32 +686,37 @@ public:
         input.at_u8(0, 1) = scaleToU8(sizeA);
         input.at_u8(0, 2) = scaleToU8(sizeB);
 
-        auto output = net_->forward(input);
+        auto output = infer(input);
         return interpretBool(output.at_u8(0, 0));
     }
 
-    void learn(int16_t light, int16_t sizeA, int16_t sizeB, bool shouldChooseA) {
-        history_.push_back({light, sizeA, sizeB, shouldChooseA});
-
-        for (int epoch = 0; epoch < EPOCHS_PER_TRIAL; epoch++) {
-            for (const auto& s : history_) {
-                intgr_nn::Tensor input(1, 3);
-                input.at_u8(0, 0) = scaleToU8(s.light);
-                input.at_u8(0, 1) = scaleToU8(s.sizeA);
-                input.at_u8(0, 2) = scaleToU8(s.sizeB);
-
-                auto output = net_->forward(input);
+    // Pick-A output over sizeA (x) and sizeB (y) for the given light
+    void decisionGrid(int16_t light, DecisionGrid& grid) const {
+        inferGrid(grid, [&](int16_t sizeA, int16_t sizeB, uint8_t* row) {
+            row[0] = scaleToU8(light);
+            row[1] = scaleToU8(sizeA);
+            row[2] = scaleToU8(sizeB);
+        });
+    }
 
-                intgr_nn::Tensor target(1, 1);
-                target.at_u8(0, 0) = s.chooseA ? 255 : 0;
+    void learn(int16_t light, int16_t sizeA, int16_t sizeB, bool shouldChooseA) {
+        beginLearn(light, sizeA, sizeB, shouldChooseA);
+        finishTraining();
+    }
 
-                net_->backward(output, target);
-            }
-        }
+    void beginLearn(int16_t light, int16_t sizeA, int16_t sizeB, bool shouldChooseA) {
+        history_.push_back({light, sizeA, sizeB, shouldChooseA});
+        beginReplay(EPOCHS_PER_TRIAL);
     }
 
-    void clearHistory() override { history_.clear(); }
-    size_t historySize() const override { return history_.size(); }
+protected:
+    void encodeSample(size_t i, intgr_nn::Tensor& input, intgr_nn::Tensor& target) const override {
+        const auto& s = history_[i];
+        input.at_u8(0, 0) = scaleToU8(s.light);
+        input.at_u8(0, 1) = scaleToU8(s.sizeA);
+        input.at_u8(0, 2) = scaleToU8(s.sizeB);
+        target.at_u8(0, 0) = s.chooseA ? 255 : 0;
+    }
 };
 
 //=============================================================================
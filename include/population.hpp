@@ -0,0 +1,87 @@
+#pragma once
+/**
+ * Population runner for enen Demo
+ *
+ * Runs many independent creatures (one Game each) across worker threads.
+ * Built for multi-socket hosts:
+ * - Each worker thread is pinned to one core, cores grouped by NUMA node
+ * - Each worker constructs its own shard of Games after pinning, so the
+ *   networks, replay histories and RNG land on the worker's local node
+ *   (Linux first-touch policy; no libnuma dependency)
+ * - Workers only touch their own shard while stepping, and write their
+ *   stats once at the end, so steady state has no cross-node traffic
+ * - With metricsName set, each worker also publishes live counters to its
+ *   own shard of a shared-memory segment (metrics.hpp) for enen-top
+ *
+ * On single-node machines (or non-Linux hosts) everything reports node 0
+ * and pinning is skipped where the platform does not support it.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace enen {
+
+//=============================================================================
+// Host topology helpers (Linux sysfs; single-node fallback elsewhere)
+//=============================================================================
+namespace topology {
+    // CPUs this process may run on, in ascending order
+    std::vector<int> allowedCpus();
+
+    // Number of NUMA nodes (1 when unknown). Node numbers need not be
+    // contiguous, so a node's number may be >= nodeCount().
+    int nodeCount();
+
+    // NUMA node that owns a CPU (0 when unknown)
+    int nodeOfCpu(int cpu);
+
+    // Pin the calling thread to one CPU. Returns false if unsupported.
+    bool pinCurrentThread(int cpu);
+}
+
+struct PopulationConfig {
+    int creatures = 64;            // Games to run
+    int threads = 0;               // 0 = one per allowed CPU
+    bool pinThreads = true;        // Pin workers to cores
+    uint32_t baseSeed = 1;         // Creature i uses seed baseSeed + i
+    int maxTrialsPerPuzzle = 500;
+    std::string metricsName;       // Publish live metrics as /dev/shm/<name> ("" = off)
+    double frameBudgetMs = 1000.0 / 60;  // Trials slower than this count as frame overruns
+};
+
+// Throughput for one NUMA node
+struct NodeStats {
+    int node = 0;
+    int threads = 0;
+    int creatures = 0;
+    int completed = 0;       // Creatures that solved all five puzzles
+    long trials = 0;         // Trials run, including those of creatures that gave up
+    double busySeconds = 0;  // Slowest worker on this node
+
+    double trialsPerSecond() const {
+        return busySeconds > 0 ? trials / busySeconds : 0.0;
+    }
+};
+
+struct PopulationReport {
+    std::vector<NodeStats> nodes;  // One entry per node that ran workers
+    double wallSeconds = 0;
+    long totalTrials = 0;
+    int completed = 0;
+    bool pinned = false;           // All workers were pinned successfully
+    bool metricsShared = false;    // Live metrics were visible to enen-top
+};
+
+class PopulationRunner {
+public:
+    explicit PopulationRunner(const PopulationConfig& config) : config_(config) {}
+
+    PopulationReport run();
+
+private:
+    PopulationConfig config_;
+};
+
+} // namespace enen
@@ -10,6 +10,7 @@
  * 5. CompositionTrial - Combined context + size
  */
 
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 
@@ -308,35 +309,133 @@ struct LearningValidator {
     }
 };
 
+//=============================================================================
+// Sequential Test (SPRT) on trial outcomes
+// Wald's sequential probability ratio test between two success rates:
+//   H0: accuracy = p0 (failing, e.g. coin flip)
+//   H1: accuracy = p1 (mastered)
+// After each outcome the log-likelihood ratio is compared to thresholds
+// set by the error rates, so the test stops as soon as the evidence is
+// strong enough either way.
+//=============================================================================
+struct SequentialTest {
+    enum class Verdict { UNDECIDED, MASTERED, FAILING };
+
+    struct Config {
+        double p0 = 0.5;     // Accuracy when failing (chance on a two-way pick)
+        double p1 = 0.9;     // Accuracy when mastered
+        double alpha = 0.05; // P(declare MASTERED | failing)
+        double beta = 0.05;  // P(declare FAILING | mastered)
+    };
+
+    Config config;
+    double llr = 0.0;  // log P(outcomes | H1) - log P(outcomes | H0)
+    int trials = 0;
+
+    void record(bool success) {
+        llr += success ? std::log(config.p1 / config.p0)
+                       : std::log((1.0 - config.p1) / (1.0 - config.p0));
+        trials++;
+    }
+
+    double upperBound() const { return std::log((1.0 - config.beta) / config.alpha); }
+    double lowerBound() const { return std::log(config.beta / (1.0 - config.alpha)); }
+
+    Verdict verdict() const {
+        if (llr >= upperBound()) return Verdict::MASTERED;
+        if (llr <= lowerBound()) return Verdict::FAILING;
+        return Verdict::UNDECIDED;
+    }
+
+    bool settled() const { return verdict() != Verdict::UNDECIDED; }
+
+    void reset() {
+        llr = 0.0;
+        trials = 0;
+    }
+};
+
 //=============================================================================
 // Gauntlet State (for Puzzle 5)
 // With real training, add warmup phase where learning happens.
 // Warmup trials train the network but don't count toward score.
 // Scored trials count toward final score.
+//
+// Mode::FIXED (the demo) always runs every warmup and scored trial.
+// Mode::SEQUENTIAL stops each phase as soon as an SPRT settles it:
+// - Warmup ends early once mastery is settled. A FAILING verdict only
+//   means "still learning", so the test restarts on later trials.
+// - Scoring ends as soon as MASTERED or FAILING is settled.
+// Both phases keep their fixed lengths as upper bounds.
 //=============================================================================
 struct GauntletState {
+    enum class Mode { FIXED, SEQUENTIAL };
+
     int warmup_completed = 0;
     int scored_completed = 0;
     int correct = 0;
+    bool warmup_settled = false;  // SEQUENTIAL: warmup ended early
 
     static constexpr int WARMUP_TRIALS = 10;   // Learning phase, not scored
     static constexpr int SCORED_TRIALS = 20;   // These count
     static constexpr int TOTAL_TRIALS = WARMUP_TRIALS + SCORED_TRIALS;
 
-    bool inWarmup() const { return warmup_completed < WARMUP_TRIALS; }
+    // SEQUENTIAL mode (mode and test configs are kept across reset())
+    Mode mode = Mode::FIXED;
+    SequentialTest warmup_test;
+    SequentialTest scored_test;
+
+    bool inWarmup() const {
+        return !warmup_settled && warmup_completed < WARMUP_TRIALS;
+    }
 
     void recordOutcome(bool success) {
         if (inWarmup()) {
             warmup_completed++;
             // Still learning, success doesn't count yet
+            if (mode == Mode::SEQUENTIAL) {
+                warmup_test.record(success);
+                if (warmup_test.verdict() == SequentialTest::Verdict::MASTERED) {
+                    warmup_settled = true;
+                } else if (warmup_test.verdict() == SequentialTest::Verdict::FAILING) {
+                    warmup_test.reset();
+                }
+            }
         } else {
             scored_completed++;
             if (success) correct++;
+            if (mode == Mode::SEQUENTIAL) scored_test.record(success);
         }
     }
 
+    // Scored trials this gauntlet will run: SCORED_TRIALS, or fewer once
+    // a sequential test has settled
+    int scoredLimit() const {
+        if (mode == Mode::SEQUENTIAL && scored_test.settled()) return scored_completed;
+        return SCORED_TRIALS;
+    }
+
     bool isComplete() const {
-        return scored_completed >= SCORED_TRIALS;
+        return scored_completed >= scoredLimit();
+    }
+
+    // SEQUENTIAL: how scoring was settled (UNDECIDED if it ran to the limit)
+    SequentialTest::Verdict verdict() const { return scored_test.verdict(); }
+
+    // Score that passes a gauntlet scored to its limit: closer to the
+    // mastered accuracy (p1) than to the failing one (p0)
+    static int passPercent(const SequentialTest::Config& config) {
+        return static_cast<int>((config.p0 + config.p1) * 50.0 + 0.5);
+    }
+
+    // Complete and passed: a settled sequential test decides, otherwise
+    // the score against passPercent()
+    bool passed() const {
+        if (!isComplete()) return false;
+        if (mode == Mode::SEQUENTIAL && scored_test.settled()) {
+            return verdict() == SequentialTest::Verdict::MASTERED;
+        }
+        return scorePercent() >= passPercent(scored_test.config);
     }
 
     int scorePercent() const {
@@ -351,6 +450,9 @@ struct GauntletState {
         warmup_completed = 0;
         scored_completed = 0;
         correct = 0;
+        warmup_settled = false;
+        warmup_test.reset();
+        scored_test.reset();
     }
 };
 
@@ -367,4 +469,16 @@ enum class PuzzleType {
 
 constexpr int NUM_PUZZLES = 5;
 
+// Short name of a puzzle, as the demo titles it (tables and reports)
+inline const char* puzzleLabel(PuzzleType puzzle) {
+    switch (puzzle) {
+        case PuzzleType::GENERALIZATION: return "Size";
+        case PuzzleType::FEATURE_SELECTION: return "Exceptions";
+        case PuzzleType::XOR_CONTEXT: return "Context";
+        case PuzzleType::SEQUENCE: return "Order";
+        case PuzzleType::COMPOSITION: return "Everything";
+    }
+    return "?";
+}
+
 } // namespace enen
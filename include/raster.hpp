@@ -0,0 +1,151 @@
+#pragma once
+/**
+ * Text rasterizer for enen Demo
+ *
+ * Turns TextBuffer frames into 1-bit pixels with an embedded 5x7 bitmap
+ * font, so recordings need no terminal emulator or external tool:
+ * - glyph(): font lookup (printable ASCII; anything else draws blank)
+ * - CellRect / diffCells(): the character cells that changed between two
+ *   frames, so only that region is rasterized and encoded
+ * - rasterize(): pixels for a cell rectangle (0 = background, 1 = text)
+ *
+ * Each cell is 6x9 font pixels (glyph plus spacing), times `scale`.
+ */
+
+#include "frame.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace enen {
+namespace raster {
+
+constexpr int GLYPH_W = 5;
+constexpr int GLYPH_H = 7;
+constexpr int CELL_W = 6;  // Glyph + 1 column spacing
+constexpr int CELL_H = 9;  // Glyph + 1 row above, 1 below
+
+// Amber on near-black, as ansi::AMBER
+constexpr uint8_t BACKGROUND[3] = {12, 12, 10};
+constexpr uint8_t FOREGROUND[3] = {242, 178, 51};
+
+//=============================================================================
+// 5x7 font - ASCII 32..126, five columns per glyph, bit 0 = top row
+//=============================================================================
+inline const uint8_t* glyph(char c) {
+    static const uint8_t FONT[95][GLYPH_W] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00},  // ' ' !
+        {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14},  // " #
+        {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},  // $ %
+        {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00},  // & '
+        {0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00},  // ( )
+        {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},  // * +
+        {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08},  // , -
+        {0x00, 0x60, 0x60, 0x00, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},  // . /
+        {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},  // 0 1
+        {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31},  // 2 3
+        {0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39},  // 4 5
+        {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},  // 6 7
+        {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E},  // 8 9
+        {0x00, 0x36, 0x36, 0x00, 0x00}, {0x00, 0x56, 0x36, 0x00, 0x00},  // : ;
+        {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},  // < =
+        {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06},  // > ?
+        {0x32, 0x49, 0x79, 0x41, 0x3E}, {0x7E, 0x11, 0x11, 0x11, 0x7E},  // @ A
+        {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},  // B C
+        {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41},  // D E
+        {0x7F, 0x09, 0x09, 0x01, 0x01}, {0x3E, 0x41, 0x41, 0x51, 0x32},  // F G
+        {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},  // H I
+        {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41},  // J K
+        {0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x04, 0x02, 0x7F},  // L M
+        {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},  // N O
+        {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E},  // P Q
+        {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31},  // R S
+        {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},  // T U
+        {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x7F, 0x20, 0x18, 0x20, 0x7F},  // V W
+        {0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03},  // X Y
+        {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},  // Z [
+        {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00},  // \ ]
+        {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},  // ^ _
+        {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},  // ` a
+        {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20},  // b c
+        {0x38, 0x44, 0x44, 0x48, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18},  // d e
+        {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},  // f g
+        {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00},  // h i
+        {0x20, 0x40, 0x44, 0x3D, 0x00}, {0x7F, 0x10, 0x28, 0x44, 0x00},  // j k
+        {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},  // l m
+        {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},  // n o
+        {0x7C, 0x14, 0x14, 0x14, 0x08}, {0x08, 0x14, 0x14, 0x18, 0x7C},  // p q
+        {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},  // r s
+        {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C},  // t u
+        {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C},  // v w
+        {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},  // x y
+        {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},  // z {
+        {0x00, 0x00, 0x7F, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00},  // | }
+        {0x08, 0x04, 0x08, 0x10, 0x08},                                  // ~
+    };
+    unsigned char u = static_cast<unsigned char>(c);
+    return (u >= 32 && u < 127) ? FONT[u - 32] : FONT[0];
+}
+
+//=============================================================================
+// CellRect - A rectangle of character cells
+//=============================================================================
+struct CellRect {
+    int x = 0, y = 0;
+    int w = 0, h = 0;
+
+    bool empty() const { return w <= 0 || h <= 0; }
+
+    static CellRect full() { return {0, 0, terminal::WIDTH, terminal::HEIGHT}; }
+};
+
+// Bounding rectangle of the cells that differ between two frames
+inline CellRect diffCells(const TextBuffer& before, const TextBuffer& after) {
+    int x0 = terminal::WIDTH, y0 = terminal::HEIGHT, x1 = -1, y1 = -1;
+    for (int y = 0; y < terminal::HEIGHT; y++) {
+        const char* a = before.line(y);
+        const char* b = after.line(y);
+        for (int x = 0; x < terminal::WIDTH; x++) {
+            if (a[x] == b[x]) continue;
+            x0 = std::min(x0, x);
+            x1 = std::max(x1, x);
+            y0 = std::min(y0, y);
+            y1 = std::max(y1, y);
+        }
+    }
+    if (x1 < 0) return {};
+    return {x0, y0, x1 - x0 + 1, y1 - y0 + 1};
+}
+
+//=============================================================================
+// rasterize - Pixels for the cells in `rect`, row-major, one byte each
+//=============================================================================
+inline void rasterize(const TextBuffer& buffer, const CellRect& rect, int scale,
+                      std::vector<uint8_t>& pixels) {
+    int width = rect.w * CELL_W * scale;
+    int height = rect.h * CELL_H * scale;
+    pixels.assign(static_cast<size_t>(width) * height, 0);
+
+    for (int cy = 0; cy < rect.h; cy++) {
+        const char* line = buffer.line(rect.y + cy);
+        for (int cx = 0; cx < rect.w; cx++) {
+            const uint8_t* g = glyph(line[rect.x + cx]);
+            for (int gx = 0; gx < GLYPH_W; gx++) {
+                uint8_t column = g[gx];
+                if (column == 0) continue;
+                for (int gy = 0; gy < GLYPH_H; gy++) {
+                    if (!(column & (1 << gy))) continue;
+                    // Glyph sits one font pixel below the top of its cell
+                    int px = (cx * CELL_W + gx) * scale;
+                    int py = (cy * CELL_H + 1 + gy) * scale;
+                    for (int sy = 0; sy < scale; sy++) {
+                        std::fill_n(&pixels[static_cast<size_t>(py + sy) * width + px], scale, 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace raster
+} // namespace enen
@@ -7,10 +7,14 @@
  * - Trial section with choices, pick, result
  * - History showing recent trials
  * - Visual box in bottom-right
+ * - Decision heatmap under the brain box (size, context, everything)
  */
 
 #include "puzzles.hpp"
 #include "networks.hpp"
+#include "heatmap.hpp"
+#include "history.hpp"
+#include "text.hpp"
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -21,26 +25,6 @@ namespace enen {
 constexpr int TERM_WIDTH = 80;
 constexpr int TERM_HEIGHT = 24;
 
-// Trial history entry
-struct TrialRecord {
-    int trial_num;
-    bool correct;
-    std::string summary;  // Brief description
-};
-
-// Trial history - keeps last N trials
-class TrialHistory {
-public:
-    static constexpr int MAX_ENTRIES = 4;
-
-    void add(int trial_num, bool correct, const std::string& summary);
-    const std::vector<TrialRecord>& entries() const { return entries_; }
-    void clear() { entries_.clear(); }
-
-private:
-    std::vector<TrialRecord> entries_;
-};
-
 // Main renderer class
 class Renderer {
 public:
@@ -59,30 +43,30 @@ public:
     // what the network chose BEFORE learning, not after
     void drawPuzzle1(const MushroomTrial& trial, const GeneralizationNet& net,
                      bool choseA, bool correct,
-                     const TrialHistory& history, int trial_num,
+                     const History& history, int trial_num,
                      int successes, int required,
                      bool showContinue);
 
     void drawPuzzle2(const ShapeTrial& trial, const FeatureSelectionNet& net,
                      bool choseA, bool correct,
-                     const TrialHistory& history, int trial_num,
+                     const History& history, int trial_num,
                      int successes, int required,
                      bool showContinue);
 
     void drawPuzzle3(const XORTrial& trial, const XORNet& net,
                      bool predictedSafe, bool correct,
-                     const TrialHistory& history, int trial_num,
+                     const History& history, int trial_num,
                      int successes, int required,
                      bool showContinue);
 
     void drawPuzzle4(const SequencePuzzle& puzzle, const SequenceNet& net,
-                     const TrialHistory& history, int trial_num,
+                     const History& history, int trial_num,
                      int successes, int required,
                      bool showContinue);
 
     void drawPuzzle5(const CompositionTrial& trial, const CompositionNet& net,
                      bool choseA, bool correct,
-                     const TrialHistory& history, const GauntletState& gauntlet,
+                     const History& history, const GauntletState& gauntlet,
                      bool showContinue);
 
     // Draw intro/victory screens
@@ -90,12 +74,24 @@ public:
     void drawVictory(size_t totalModelBytes, int gauntletScore, int gauntletTotal);
     void drawPuzzleIntro(PuzzleType type);
 
+    // Draw a frame composed elsewhere (the arena)
+    void drawFrame(const TextBuffer& frame);
+
     // Flush output
     void flush();
 
+    // Deferred frames: while held, draw calls compose the frame in the
+    // buffer but flush() leaves it there; present() writes it out later.
+    // Lets the next trial be drawn ahead of time and shown on demand.
+    void holdFrames(bool hold) { hold_ = hold; }
+    bool framePending() const { return pending_; }
+    void present();
+
 private:
     // Buffer for double-buffered rendering
-    char buffer_[TERM_HEIGHT][TERM_WIDTH + 1];
+    TextBuffer buffer_;
+    bool hold_ = false;
+    bool pending_ = false;
 
     // Drawing primitives
     void clearBuffer();
@@ -111,7 +107,7 @@ private:
                             const IntgrNNWrapper& net, const char* arch,
                             const GauntletState& gauntlet);
     void drawProgressBar(int x, int y, int width, int value, int max);
-    void drawHistory(const TrialHistory& history, int startY);
+    void drawHistory(const History& history, int startY);
     void drawControls(int y, bool showContinue);
     void drawVisualBox(int x, int y, int w, int h);
 
@@ -123,9 +119,13 @@ private:
     void drawLightAndSizes(int boxX, int boxY, bool lightOn, int16_t sizeA, int16_t sizeB);
 
     // Brain diagram showing what enen sees, thinks, and decides
-    void drawBrainBox(int x, int y, PuzzleType puzzleType, size_t modelBytes);
+    void drawBrainBox(int x, int y, PuzzleType puzzleType, size_t modelBytes,
+                      const ForwardTrace* trace = nullptr);
     void drawBrainBoxPreview(int x, int y, PuzzleType puzzleType);  // For intro screens
 
+    // Learned decision boundary (cached until the net's weights change)
+    DecisionHeatmap heatmap_;
+
     // Completion message when puzzle is done
     void drawCompletionMessage(int y, PuzzleType type, int gauntletScore = 0, int gauntletTotal = 0);
 };
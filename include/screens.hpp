@@ -15,7 +15,7 @@
 #include "layout.hpp"
 #include "brain_diagram.hpp"
 #include "puzzles.hpp"
-#include <cstdio>
+#include "text.hpp"
 
 namespace enen {
 
@@ -40,10 +40,8 @@ inline void renderIntro1(TextBuffer& buffer, size_t totalBytes) {
 
     buffer.putString(layout::intro::CONTENT_X, y + 7, "After a few tries, it figures out the pattern.");
 
-    char byteLine[64];
-    std::snprintf(byteLine, sizeof(byteLine),
-                  "The twist: enen's entire brain is %zu bytes.", totalBytes);
-    buffer.putString(layout::intro::CONTENT_X, y + 10, byteLine);
+    text::put(buffer, layout::intro::CONTENT_X, y + 10, ENEN_FORMAT("The twist: enen's entire brain is {} bytes."),
+              totalBytes);
 
     buffer.putString(layout::intro::CONTENT_X, y + 12, "That's smaller than this sentence.");
 
@@ -177,16 +175,12 @@ inline void renderVictory(TextBuffer& buffer, size_t totalBytes,
     buffer.putString(x + 2, layout::victory::PUZZLES_START_Y + 4,
                      "Puzzle 5: Combine skills (context + comparison)");
 
-    char scoreLine[64];
     int percent = gauntletTotal > 0 ? (gauntletScore * 100) / gauntletTotal : 0;
-    std::snprintf(scoreLine, sizeof(scoreLine),
-                  "Final gauntlet score: %d/%d (%d%%)",
-                  gauntletScore, gauntletTotal, percent);
-    buffer.putString(20, layout::victory::SCORE_Y, scoreLine);
-
-    char sizeLine[64];
-    std::snprintf(sizeLine, sizeof(sizeLine), "Total brain size: %zu bytes", totalBytes);
-    buffer.putString(20, layout::victory::SIZE_Y, sizeLine);
+    text::put(buffer, 20, layout::victory::SCORE_Y, ENEN_FORMAT("Final gauntlet score: {}/{} ({}%)"),
+              gauntletScore, gauntletTotal, percent);
+
+    text::put(buffer, 20, layout::victory::SIZE_Y, ENEN_FORMAT("Total brain size: {} bytes"),
+              totalBytes);
     buffer.putString(20, layout::victory::SIZE_Y + 1,
                      "All learning happened live. No pre-training.");
 
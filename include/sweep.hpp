@@ -0,0 +1,132 @@
+#pragma once
+/**
+ * Multi-process seed sweeps for enen Demo
+ *
+ * A SweepCoordinator runs the full demo for a range of seeds in separate
+ * worker processes, so a crashing or hung seed only takes down its own
+ * worker:
+ * - Seeds are split into ranges and kept in a work queue. Each idle
+ *   worker is assigned the next range over a Unix-domain stream socket.
+ * - Workers send one SeedResult per seed and a DONE when the range is
+ *   finished.
+ * - A worker that dies (socket closed) or goes silent for longer than
+ *   the timeout (it is killed) has the unreported seeds of its range
+ *   put back at the front of the queue. Forked workers are replaced.
+ * - A seed that has killed maxAttempts workers is recorded as failed
+ *   and skipped.
+ *
+ * Workers are either forked by the coordinator (socketpair), or started
+ * separately and connected to listenPath. The second form stands in for
+ * workers on other hosts, and everything runs on one Linux machine.
+ * Messages are fixed-size structs in native byte order, because both
+ * ends run the same binary.
+ *
+ * Linux / POSIX only (fork, poll, AF_UNIX).
+ */
+
+#include "puzzles.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace enen {
+namespace sweep {
+
+//=============================================================================
+// Wire protocol
+//=============================================================================
+enum class MessageType : uint32_t {
+    HELLO = 1,   // Worker -> coordinator: ready (pid)
+    ASSIGN = 2,  // Coordinator -> worker: run a seed range
+    RESULT = 3,  // Worker -> coordinator: one seed finished
+    DONE = 4,    // Worker -> coordinator: range finished
+    STOP = 5,    // Coordinator -> worker: no more work, exit
+};
+
+// Fault injection for testing the coordinator (enen-sweep --crash-seed)
+struct FaultPlan {
+    uint32_t crashSeed = 0;  // Worker abort()s on this seed (0 = none)
+    uint32_t hangSeed = 0;   // Worker stops responding on this seed (0 = none)
+    bool onlyFirstAttempt = true;  // Succeed when the seed is retried
+};
+
+struct Assignment {
+    uint32_t firstSeed = 0;
+    uint32_t count = 0;
+    uint32_t attempt = 0;  // 0 on first try; retries of a requeued range count up
+    int32_t maxTrialsPerPuzzle = 500;
+    FaultPlan faults;
+};
+
+struct SeedResult {
+    uint32_t seed = 0;
+    int32_t worker = 0;             // pid
+    int32_t trials[NUM_PUZZLES] = {};  // -1 = puzzle not completed
+    float seconds[NUM_PUZZLES] = {};
+    int32_t gauntletPercent = 0;
+    uint8_t completed = 0;          // All five puzzles solved
+    uint8_t failed = 0;             // Seed crashed or hung every attempt
+    uint8_t reserved[2] = {};
+};
+
+//=============================================================================
+// Coordinator
+//=============================================================================
+struct SweepConfig {
+    uint32_t firstSeed = 1;
+    uint32_t seeds = 64;
+    uint32_t rangeSize = 4;       // Seeds per assignment
+    int workers = 0;              // Forked workers (0 = one per CPU; may be 0 with listenPath)
+    std::string listenPath;       // Also accept connecting workers here ("" = off)
+    int maxTrialsPerPuzzle = 500;
+    double timeoutSeconds = 30.0; // Silence before a worker is presumed hung
+    int maxAttempts = 2;          // Per seed, before it is recorded as failed
+    FaultPlan faults;
+};
+
+struct WorkerStats {
+    int pid = 0;
+    bool forked = false;
+    int seeds = 0;          // Results received
+    int ranges = 0;         // Ranges completed
+    bool lost = false;      // Died or was killed
+};
+
+struct SweepReport {
+    std::vector<SeedResult> results;  // One per seed, in seed order
+    std::vector<WorkerStats> workers;
+    int requeued = 0;                 // Ranges put back after a lost worker
+    int failedSeeds = 0;
+    double wallSeconds = 0.0;
+
+    // Trials to completion of one puzzle over completed seeds
+    double meanTrials(PuzzleType puzzle) const;
+    int completed() const;
+};
+
+class SweepCoordinator {
+public:
+    explicit SweepCoordinator(const SweepConfig& config) : config_(config) {}
+
+    // Runs until every seed has a result. False if that cannot happen: no
+    // worker could be started (or listenPath could not be bound), all
+    // workers were lost with none able to replace them, or poll() failed.
+    bool run(SweepReport& report);
+
+private:
+    SweepConfig config_;
+};
+
+//=============================================================================
+// Worker side
+//=============================================================================
+
+// Serve assignments on a connected socket until STOP or EOF. Returns the
+// process exit code.
+int runWorker(int fd);
+
+// Connect to a coordinator's listenPath and serve. Returns the exit code.
+int runRemoteWorker(const std::string& path);
+
+} // namespace sweep
+} // namespace enen
@@ -0,0 +1,188 @@
+#pragma once
+/**
+ * Text formatting for enen Demo screens
+ *
+ * Screens only format small integers and fixed strings, so printf-style
+ * parsing at every call is wasted work. Instead:
+ * - ENEN_FORMAT("TRIAL {}:") names a pattern whose "{}" fields are
+ *   counted at compile time and checked against the arguments
+ * - text::put() writes the pattern straight into a TextBuffer row;
+ *   text::format() into a char array (NUL-terminated, like snprintf)
+ * - Literal runs are split out at compile time and copied with known
+ *   lengths; integers go through std::to_chars
+ *
+ * Fields: "{}" for the natural width, "{:3}" right-aligned in 3 columns.
+ * Arguments may be integers, chars and C strings.
+ */
+
+#include "frame.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// A format pattern usable by text::put / text::format (string literal only)
+#define ENEN_FORMAT(literal)                                                   \
+    [] {                                                                       \
+        struct Pattern {                                                       \
+            static constexpr const char* text() { return literal; }           \
+        };                                                                     \
+        return Pattern{};                                                      \
+    }()
+
+namespace enen {
+namespace text {
+
+//=============================================================================
+// Pattern parsing (compile time)
+//=============================================================================
+namespace detail {
+
+// Number of fields, or -1 if the pattern is malformed
+constexpr int countFields(const char* s) {
+    int fields = 0;
+    for (; *s; s++) {
+        if (*s == '}') return -1;
+        if (*s != '{') continue;
+        s++;
+        if (*s == ':') {
+            s++;
+            if (*s < '1' || *s > '9') return -1;
+            while (*s >= '0' && *s <= '9') s++;
+        }
+        if (*s != '}') return -1;
+        fields++;
+    }
+    return fields;
+}
+
+// A literal run of the pattern, then the field after it (if any)
+struct Segment {
+    uint16_t start = 0;
+    uint16_t length = 0;
+    uint8_t width = 0;  // Field width, 0 = natural
+};
+
+template <int FIELDS>
+constexpr std::array<Segment, FIELDS + 1> split(const char* s) {
+    std::array<Segment, FIELDS + 1> segments{};
+    int i = 0;
+    uint16_t pos = 0;
+    uint16_t start = 0;
+    for (; s[pos]; pos++) {
+        if (s[pos] != '{') continue;
+        segments[i].start = start;
+        segments[i].length = static_cast<uint16_t>(pos - start);
+        pos++;
+        if (s[pos] == ':') {
+            int width = 0;
+            for (pos++; s[pos] >= '0' && s[pos] <= '9'; pos++) width = width * 10 + (s[pos] - '0');
+            segments[i].width = static_cast<uint8_t>(width);
+        }
+        start = static_cast<uint16_t>(pos + 1);
+        i++;
+    }
+    segments[i].start = start;
+    segments[i].length = static_cast<uint16_t>(pos - start);
+    return segments;
+}
+
+//=============================================================================
+// Writer - Appends to a fixed span, dropping whatever does not fit
+//=============================================================================
+class Writer {
+public:
+    Writer(char* out, int capacity) : out_(out), capacity_(capacity) {}
+
+    int length() const { return length_; }
+
+    void append(const char* text, int length) {
+        length = std::min(length, capacity_ - length_);
+        if (length <= 0) return;
+        std::memcpy(out_ + length_, text, length);
+        length_ += length;
+    }
+
+    void pad(int count) {
+        count = std::min(count, capacity_ - length_);
+        if (count <= 0) return;
+        std::memset(out_ + length_, ' ', count);
+        length_ += count;
+    }
+
+    void field(char c, int width) {
+        pad(width - 1);
+        append(&c, 1);
+    }
+
+    void field(const char* str, int width) {
+        int length = static_cast<int>(std::strlen(str));
+        pad(width - length);
+        append(str, length);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value> field(T value, int width) {
+        static_assert(!std::is_same<T, bool>::value, "format a bool as a string");
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        int length = static_cast<int>(result.ptr - digits);
+        pad(width - length);
+        append(digits, length);
+    }
+
+private:
+    char* out_;
+    int capacity_;
+    int length_ = 0;
+};
+
+template <typename Pattern, typename... Args>
+void write(Writer& writer, const Args&... args) {
+    constexpr int FIELDS = countFields(Pattern::text());
+    static_assert(FIELDS >= 0, "malformed format pattern");
+    static_assert(FIELDS == sizeof...(Args), "format pattern and arguments differ in count");
+    static constexpr auto SEGMENTS = split<FIELDS>(Pattern::text());
+
+    const char* text = Pattern::text();
+    int i = 0;
+    // Comma fold: each literal run, then its field, left to right
+    ((writer.append(text + SEGMENTS[i].start, SEGMENTS[i].length),
+      writer.field(args, SEGMENTS[i].width), i++), ...);
+    writer.append(text + SEGMENTS[FIELDS].start, SEGMENTS[FIELDS].length);
+}
+
+} // namespace detail
+
+//=============================================================================
+// put - Format into a TextBuffer row at (x, y), clipped to the row
+//
+// Returns the column after the last character written.
+//=============================================================================
+template <typename Pattern, typename... Args>
+int put(TextBuffer& buffer, int x, int y, Pattern, const Args&... args) {
+    char* row = buffer.span(x, y);
+    if (!row) return x;
+    detail::Writer writer(row, terminal::WIDTH - x);
+    detail::write<Pattern>(writer, args...);
+    return x + writer.length();
+}
+
+//=============================================================================
+// format - Format into `out` (size bytes including the NUL), truncating
+//
+// Returns the length written, excluding the NUL.
+//=============================================================================
+template <typename Pattern, typename... Args>
+int format(char* out, size_t size, Pattern, const Args&... args) {
+    if (size == 0) return 0;
+    detail::Writer writer(out, static_cast<int>(size - 1));
+    detail::write<Pattern>(writer, args...);
+    out[writer.length()] = '\0';
+    return writer.length();
+}
+
+} // namespace text
+} // namespace enen
@@ -0,0 +1,280 @@
+#pragma once
+/**
+ * Puzzle trial screens for enen Demo
+ *
+ * One renderer per puzzle, each filling a TextBuffer with a trial frame:
+ * - Header with title, rule, progress
+ * - Current trial details
+ * - Result (correct/wrong)
+ * - History of recent trials
+ * - Brain diagram (and decision heatmap where the puzzle has one)
+ *
+ * Renderers only read their arguments, so frames can be drawn on any
+ * thread from recorded state (see autorun.hpp).
+ */
+
+#include "frame.hpp"
+#include "layout.hpp"
+#include "brain_diagram.hpp"
+#include "heatmap.hpp"
+#include "history.hpp"
+#include "puzzles.hpp"
+#include "text.hpp"
+
+namespace enen {
+
+//=============================================================================
+// Puzzle 1: Size
+//=============================================================================
+inline void renderPuzzle1Trial(TextBuffer& buffer, const MushroomTrial& trial,
+                               bool choseA, bool correct, const History& history,
+                               int trialNum, int successes, size_t bytes,
+                               const ForwardTrace* trace, const DecisionHeatmap* heatmap,
+                               bool complete) {
+    buffer.clear();
+
+    // Header
+    buffer.putString(0, layout::header::TITLE_Y, "ENEN DEMO: SIZE");
+    buffer.drawHLine(0, layout::header::DIVIDER_Y, layout::LEFT_COLUMN_WIDTH, '=');
+    buffer.putString(0, layout::header::RULE_Y, "Rule: Bigger is safe. Ignore color.");
+    buffer.putString(0, layout::header::PROGRESS_Y, "Progress: ");
+    drawProgressBar(buffer, layout::header::PROGRESS_BAR_X, layout::header::PROGRESS_Y, successes, 4);
+    text::put(buffer, layout::header::PROGRESS_COUNT_X, layout::header::PROGRESS_Y, ENEN_FORMAT(" {}/4"),
+              successes);
+    buffer.drawHLine(0, layout::header::SECTION_END_Y, layout::LEFT_COLUMN_WIDTH, '-');
+
+    // Brain diagram
+    drawBrainDiagram(buffer, layout::brain::X, layout::brain::Y,
+                     PuzzleType::GENERALIZATION, bytes, trace);
+    if (heatmap) heatmap->draw(buffer, layout::heatmap::X, layout::heatmap::Y);
+
+    // Trial details
+    text::put(buffer, 0, layout::trial::LABEL_Y, ENEN_FORMAT("TRIAL {}:"), trialNum);
+
+    text::put(buffer, 0, layout::trial::OPTION_A_Y, ENEN_FORMAT("  [A] {}, size {}"),
+              MushroomTrial::colorName(trial.colorA), trial.sizeA);
+
+    text::put(buffer, 0, layout::trial::OPTION_B_Y, ENEN_FORMAT("  [B] {}, size {}"),
+              MushroomTrial::colorName(trial.colorB), trial.sizeB);
+
+    bool aIsLarger = trial.sizeA > trial.sizeB;
+    text::put(buffer, 0, layout::trial::PICK_Y, ENEN_FORMAT("  Pick: {} ({})"),
+              choseA ? 'A' : 'B', (choseA == aIsLarger) ? "larger" : "smaller");
+    buffer.putString(0, layout::trial::RESULT_Y, correct ? "  [OK] CORRECT" : "  [X] WRONG");
+
+    // History
+    buffer.drawHLine(0, layout::history::DIVIDER_Y, layout::LEFT_COLUMN_WIDTH, '-');
+    drawHistory(buffer, history, layout::history::LABEL_Y);
+
+    // Completion message
+    if (complete) {
+        buffer.putString(0, layout::completion::MESSAGE_Y, "enen learned: bigger is always safe.");
+    }
+
+    // Footer
+    buffer.drawHLine(0, layout::footer::DIVIDER_Y, terminal::WIDTH, '-');
+    buffer.putString(0, layout::footer::CONTROLS_Y,
+                     complete ? "[Enter] Continue    [Q] Quit" : "[Space] Next Trial    [Q] Quit");
+}
+
+//=============================================================================
+// Puzzle 2: Exceptions
+//=============================================================================
+inline void renderPuzzle2Trial(TextBuffer& buffer, const ShapeTrial& trial,
+                               bool choseA, bool correct, const History& history,
+                               int trialNum, int successes, size_t bytes,
+                               const ForwardTrace* trace, bool complete) {
+    buffer.clear();
+
+    buffer.putString(0, layout::header::TITLE_Y, "ENEN DEMO: EXCEPTIONS");
+    buffer.drawHLine(0, layout::header::DIVIDER_Y, layout::LEFT_COLUMN_WIDTH, '=');
+    buffer.putString(0, layout::header::RULE_Y, "Rule: Circle safe. Blue square best.");
+    buffer.putString(0, layout::header::PROGRESS_Y, "Progress: ");
+    drawProgressBar(buffer, layout::header::PROGRESS_BAR_X, layout::header::PROGRESS_Y, successes, 4);
+    text::put(buffer, layout::header::PROGRESS_COUNT_X, layout::header::PROGRESS_Y, ENEN_FORMAT(" {}/4"),
+              successes);
+    buffer.drawHLine(0, layout::header::SECTION_END_Y, layout::LEFT_COLUMN_WIDTH, '-');
+
+    drawBrainDiagram(buffer, layout::brain::X, layout::brain::Y,
+                     PuzzleType::FEATURE_SELECTION, bytes, trace);
+
+    text::put(buffer, 0, layout::trial::LABEL_Y, ENEN_FORMAT("TRIAL {}:"), trialNum);
+
+    text::put(buffer, 0, layout::trial::OPTION_A_Y, ENEN_FORMAT("  [A] {} {}"),
+              ShapeTrial::colorName(trial.colorA), ShapeTrial::shapeName(trial.shapeA));
+
+    text::put(buffer, 0, layout::trial::OPTION_B_Y, ENEN_FORMAT("  [B] {} {}"),
+              ShapeTrial::colorName(trial.colorB), ShapeTrial::shapeName(trial.shapeB));
+
+    int16_t pickedColor = choseA ? trial.colorA : trial.colorB;
+    int16_t pickedShape = choseA ? trial.shapeA : trial.shapeB;
+    text::put(buffer, 0, layout::trial::PICK_Y, ENEN_FORMAT("  Pick: {} ({} {})"),
+              choseA ? 'A' : 'B', ShapeTrial::colorName(pickedColor), ShapeTrial::shapeName(pickedShape));
+    buffer.putString(0, layout::trial::RESULT_Y, correct ? "  [OK] CORRECT" : "  [X] WRONG");
+
+    buffer.drawHLine(0, layout::history::DIVIDER_Y, layout::LEFT_COLUMN_WIDTH, '-');
+    drawHistory(buffer, history, layout::history::LABEL_Y);
+
+    if (complete) {
+        buffer.putString(0, layout::completion::MESSAGE_Y,
+                         "enen learned: circles safe, blue squares best.");
+    }
+
+    buffer.drawHLine(0, layout::footer::DIVIDER_Y, terminal::WIDTH, '-');
+    buffer.putString(0, layout::footer::CONTROLS_Y,
+                     complete ? "[Enter] Continue    [Q] Quit" : "[Space] Next Trial    [Q] Quit");
+}
+
+//=============================================================================
+// Puzzle 3: Context
+//=============================================================================
+inline void renderPuzzle3Trial(TextBuffer& buffer, const XORTrial& trial,
+                               bool predictedSafe, bool correct, const History& history,
+                               int trialNum, int successes, size_t bytes,
+                               const ForwardTrace* trace, const DecisionHeatmap* heatmap,
+                               bool complete) {
+    buffer.clear();
+
+    buffer.putString(0, layout::header::TITLE_Y, "ENEN DEMO: CONTEXT");
+    buffer.drawHLine(0, layout::header::DIVIDER_Y, layout::LEFT_COLUMN_WIDTH, '=');
+    buffer.putString(0, layout::header::RULE_Y, "Rule: ON=left, OFF=right.");
+    buffer.putString(0, layout::header::PROGRESS_Y, "Progress: ");
+    drawProgressBar(buffer, layout::header::PROGRESS_BAR_X, layout::header::PROGRESS_Y, successes, 4);
+    text::put(buffer, layout::header::PROGRESS_COUNT_X, layout::header::PROGRESS_Y, ENEN_FORMAT(" {}/4"),
+              successes);
+    buffer.drawHLine(0, layout::header::SECTION_END_Y, layout::LEFT_COLUMN_WIDTH, '-');
+
+    drawBrainDiagram(buffer, layout::brain::X, layout::brain::Y,
+                     PuzzleType::XOR_CONTEXT, bytes, trace);
+    if (heatmap) heatmap->draw(buffer, layout::heatmap::X, layout::heatmap::Y);
+
+    text::put(buffer, 0, layout::trial::LABEL_Y, ENEN_FORMAT("TRIAL {}:"), trialNum);
+
+    text::put(buffer, 0, layout::trial::OPTION_A_Y, ENEN_FORMAT("  Scenario: Light {}, Path {}"),
+              trial.lightOn ? "ON" : "OFF", trial.choosingRight ? "RIGHT" : "LEFT");
+
+    text::put(buffer, 0, layout::trial::OPTION_B_Y, ENEN_FORMAT("  enen predicts: {}"),
+              predictedSafe ? "SAFE" : "DANGER");
+
+    text::put(buffer, 0, layout::trial::PICK_Y, ENEN_FORMAT("  Reality: {} - {}"),
+              trial.isSafe ? "SAFE" : "DANGER", correct ? "[OK] Correct!" : "[X] Wrong!");
+
+    buffer.drawHLine(0, 11, layout::LEFT_COLUMN_WIDTH, '-');
+    drawHistory(buffer, history, 12);
+
+    if (complete) {
+        buffer.putString(0, 17, "enen learned: light flips the safe path.");
+    }
+
+    buffer.drawHLine(0, layout::footer::DIVIDER_Y, terminal::WIDTH, '-');
+    buffer.putString(0, layout::footer::CONTROLS_Y,
+                     complete ? "[Enter] Continue    [Q] Quit" : "[Space] Next Trial    [Q] Quit");
+}
+
+//=============================================================================
+// Puzzle 4: Order
+//=============================================================================
+inline void renderPuzzle4Trial(TextBuffer& buffer, int action, bool success, bool inProgress,
+                               const History& history, int trialNum, int successes,
+                               size_t bytes, const ForwardTrace* trace, bool complete) {
+    buffer.clear();
+
+    buffer.putString(0, layout::header::TITLE_Y, "ENEN DEMO: ORDER");
+    buffer.drawHLine(0, layout::header::DIVIDER_Y, layout::LEFT_COLUMN_WIDTH, '=');
+    buffer.putString(0, layout::header::RULE_Y, "Rule: A first, then B.");
+    buffer.putString(0, layout::header::PROGRESS_Y, "Progress: ");
+    drawProgressBar(buffer, layout::header::PROGRESS_BAR_X, layout::header::PROGRESS_Y, successes, 4);
+    text::put(buffer, layout::header::PROGRESS_COUNT_X, layout::header::PROGRESS_Y, ENEN_FORMAT(" {}/4"),
+              successes);
+    buffer.drawHLine(0, layout::header::SECTION_END_Y, layout::LEFT_COLUMN_WIDTH, '-');
+
+    drawBrainDiagram(buffer, layout::brain::X, layout::brain::Y,
+                     PuzzleType::SEQUENCE, bytes, trace);
+
+    text::put(buffer, 0, layout::trial::LABEL_Y, ENEN_FORMAT("TRIAL {}:"), trialNum);
+
+    text::put(buffer, 0, layout::trial::OPTION_A_Y, ENEN_FORMAT("  enen presses: {}"),
+              action == 0 ? 'A' : 'B');
+
+    if (inProgress) {
+        buffer.putString(0, layout::trial::OPTION_B_Y, "  Good start...");
+    } else if (success) {
+        buffer.putString(0, layout::trial::OPTION_B_Y, "  [OK] Door opens!");
+    } else {
+        buffer.putString(0, layout::trial::OPTION_B_Y, "  [X] Wrong order!");
+    }
+
+    buffer.drawHLine(0, layout::history::DIVIDER_Y, layout::LEFT_COLUMN_WIDTH, '-');
+    drawHistory(buffer, history, layout::history::LABEL_Y);
+
+    if (complete) {
+        buffer.putString(0, layout::completion::MESSAGE_Y, "enen learned: A first, then B.");
+    }
+
+    buffer.drawHLine(0, layout::footer::DIVIDER_Y, terminal::WIDTH, '-');
+    buffer.putString(0, layout::footer::CONTROLS_Y,
+                     complete ? "[Enter] Continue    [Q] Quit" : "[Space] Next Trial    [Q] Quit");
+}
+
+//=============================================================================
+// Puzzle 5: Everything (Composition Gauntlet)
+//=============================================================================
+inline void renderPuzzle5Trial(TextBuffer& buffer, const CompositionTrial& trial,
+                               bool choseA, bool correct, const History& history,
+                               const GauntletState& gauntlet, size_t bytes,
+                               const ForwardTrace* trace, const DecisionHeatmap* heatmap,
+                               bool complete) {
+    buffer.clear();
+
+    buffer.putString(0, layout::header::TITLE_Y, "ENEN DEMO: EVERYTHING");
+    buffer.drawHLine(0, layout::header::DIVIDER_Y, layout::LEFT_COLUMN_WIDTH, '=');
+    buffer.putString(0, layout::header::RULE_Y, "Rule: ON=bigger, OFF=smaller.");
+
+    if (gauntlet.inWarmup()) {
+        text::put(buffer, 0, layout::header::PROGRESS_Y, ENEN_FORMAT("Phase: WARMUP {}/{}"),
+                  gauntlet.warmup_completed, GauntletState::WARMUP_TRIALS);
+    } else {
+        text::put(buffer, 0, layout::header::PROGRESS_Y, ENEN_FORMAT("Phase: SCORED {}/{}"),
+                  gauntlet.scored_completed, gauntlet.scoredLimit());
+    }
+
+    if (!gauntlet.inWarmup()) {
+        text::put(buffer, 0, layout::header::SECTION_END_Y, ENEN_FORMAT("Score: {}/{} ({}%)"),
+                  gauntlet.correct, gauntlet.scored_completed, gauntlet.scorePercent());
+    }
+    buffer.drawHLine(0, 5, layout::LEFT_COLUMN_WIDTH, '-');
+
+    drawBrainDiagram(buffer, layout::brain::X, layout::brain::Y,
+                     PuzzleType::COMPOSITION, bytes, trace);
+    if (heatmap) heatmap->draw(buffer, layout::heatmap::X, layout::heatmap::Y);
+
+    int trialNum = gauntlet.currentTrials();
+    text::put(buffer, 0, 7, ENEN_FORMAT("TRIAL {}:"), trialNum);
+
+    text::put(buffer, 0, 8, ENEN_FORMAT("  Light: {} -> pick {}"),
+              trial.lightOn ? "ON" : "OFF", trial.lightOn ? "LARGER" : "SMALLER");
+
+    text::put(buffer, 0, 9, ENEN_FORMAT("  [A] size {}"), trial.sizeA);
+
+    text::put(buffer, 0, 10, ENEN_FORMAT("  [B] size {}"), trial.sizeB);
+
+    bool aIsLarger = trial.sizeA > trial.sizeB;
+    text::put(buffer, 0, 11, ENEN_FORMAT("  Pick: {} ({})"),
+              choseA ? 'A' : 'B', (choseA ? aIsLarger : !aIsLarger) ? "larger" : "smaller");
+    buffer.putString(0, 12, correct ? "  [OK] CORRECT" : "  [X] WRONG");
+
+    buffer.drawHLine(0, 14, layout::LEFT_COLUMN_WIDTH, '-');
+    drawHistory(buffer, history, 15);
+
+    if (complete) {
+        buffer.putString(0, 19, "enen learned: ON=bigger, OFF=smaller.");
+        text::put(buffer, 0, 20, ENEN_FORMAT("Final score: {}/{} ({}%)"),
+                  gauntlet.correct, gauntlet.scoredLimit(), gauntlet.scorePercent());
+    }
+
+    buffer.drawHLine(0, layout::footer::DIVIDER_Y, terminal::WIDTH, '-');
+    buffer.putString(0, layout::footer::CONTROLS_Y,
+                     complete ? "[Enter] to see final results..." : "[Space] Next Trial    [Q] Quit");
+}
+
+} // namespace enen
@@ -0,0 +1,277 @@
+#pragma once
+/**
+ * Workload capture and replay for enen Demo
+ *
+ * A workload is the sequence of trials a real session fed the engine,
+ * with the time between them, so benchmarks can replay what players
+ * actually produce instead of freshly generated trials:
+ * - Capture records each trial as it runs (Game::setCapture, enen --capture)
+ * - save()/load() use a compact file: a 16-byte header, then one 16-byte
+ *   record per trial, little-endian
+ * - Replayer applies records to its own networks with the same decide and
+ *   learn calls the game makes (enen-bench replay)
+ *
+ * Records keep the trial itself, not the engine's choice: replay re-decides
+ * on the networks being measured, then learns the recorded answer.
+ */
+
+#include "networks.hpp"
+#include "puzzles.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+namespace enen {
+namespace workload {
+
+constexpr char MAGIC[4] = {'E', 'N', 'W', 'L'};
+constexpr uint16_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t RECORD_SIZE = 16;
+
+// Record flags
+constexpr uint8_t SESSION_START = 1 << 0;  // All networks start untrained here
+constexpr uint8_t PUZZLE_RESET = 1 << 1;   // This puzzle's network was reset
+
+//=============================================================================
+// Record - One trial (one button press for Sequence)
+//=============================================================================
+struct Record {
+    uint32_t gapMicros = 0;  // Since the previous trial started (0 for the first)
+    uint8_t puzzle = 0;      // PuzzleType
+    uint8_t flags = 0;
+    uint8_t answer = 0;      // correctIsA / isSafe / Sequence outcome
+    uint8_t action = 0;      // Sequence: button pressed (0 = A, 1 = B)
+    int16_t value[4] = {};   // Trial fields, per puzzle (see Capture::add)
+
+    PuzzleType type() const { return static_cast<PuzzleType>(puzzle); }
+};
+
+//=============================================================================
+// Capture - Records trials with their timing as a session runs
+//=============================================================================
+class Capture {
+public:
+    // Following records start from untrained networks
+    void beginSession() { pending_ |= SESSION_START; started_ = false; }
+
+    // The current puzzle's network was reset before the next trial
+    void resetPuzzle() { pending_ |= PUZZLE_RESET; }
+
+    // sizeA, sizeB, colorA, colorB
+    void add(const MushroomTrial& t) {
+        push(PuzzleType::GENERALIZATION, t.correctIsA, 0, {t.sizeA, t.sizeB, t.colorA, t.colorB});
+    }
+    // colorA, shapeA, colorB, shapeB
+    void add(const ShapeTrial& t) {
+        push(PuzzleType::FEATURE_SELECTION, t.correctIsA, 0, {t.colorA, t.shapeA, t.colorB, t.shapeB});
+    }
+    // lightOn, choosingRight
+    void add(const XORTrial& t) {
+        push(PuzzleType::XOR_CONTEXT, t.isSafe, 0, {t.lightOn, t.choosingRight, 0, 0});
+    }
+    // lightOn, sizeA, sizeB
+    void add(const CompositionTrial& t) {
+        push(PuzzleType::COMPOSITION, t.correctIsA, 0, {t.lightOn, t.sizeA, t.sizeB, 0});
+    }
+    // lastAction
+    void addSequenceStep(int16_t lastAction, int action, bool success) {
+        push(PuzzleType::SEQUENCE, success, static_cast<uint8_t>(action), {lastAction, 0, 0, 0});
+    }
+
+    const std::vector<Record>& records() const { return records_; }
+    void clear() { records_.clear(); pending_ = SESSION_START; started_ = false; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<Record> records_;
+    uint8_t pending_ = SESSION_START;
+    bool started_ = false;
+    Clock::time_point last_;
+
+    void push(PuzzleType puzzle, bool answer, uint8_t action, std::initializer_list<int> values) {
+        Clock::time_point now = Clock::now();
+        Record r;
+        if (started_) {
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(now - last_).count();
+            r.gapMicros = micros > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(micros);
+        }
+        r.puzzle = static_cast<uint8_t>(puzzle);
+        r.flags = pending_;
+        r.answer = answer ? 1 : 0;
+        r.action = action;
+        int i = 0;
+        for (int v : values) r.value[i++] = static_cast<int16_t>(v);
+        records_.push_back(r);
+
+        pending_ = 0;
+        started_ = true;
+        last_ = now;
+    }
+};
+
+//=============================================================================
+// File format
+//=============================================================================
+namespace detail {
+
+inline void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+inline void put32(uint8_t* p, uint32_t v) {
+    put16(p, static_cast<uint16_t>(v));
+    put16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+inline uint16_t get16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+inline uint32_t get32(const uint8_t* p) { return get16(p) | (static_cast<uint32_t>(get16(p + 2)) << 16); }
+
+} // namespace detail
+
+// Write records to `path`. False on I/O error.
+inline bool save(const char* path, const std::vector<Record>& records) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+
+    uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, 4);
+    detail::put16(header + 4, VERSION);
+    detail::put16(header + 6, RECORD_SIZE);
+    detail::put32(header + 8, static_cast<uint32_t>(records.size()));
+    std::fwrite(header, 1, HEADER_SIZE, file);
+
+    for (const Record& r : records) {
+        uint8_t out[RECORD_SIZE];
+        detail::put32(out, r.gapMicros);
+        out[4] = r.puzzle;
+        out[5] = r.flags;
+        out[6] = r.answer;
+        out[7] = r.action;
+        for (int i = 0; i < 4; i++) detail::put16(out + 8 + 2 * i, static_cast<uint16_t>(r.value[i]));
+        std::fwrite(out, 1, RECORD_SIZE, file);
+    }
+
+    bool ok = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && ok;
+}
+
+// Append the records in `path` to `out`. False if missing, truncated or
+// not a workload file.
+inline bool load(const char* path, std::vector<Record>& out) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+
+    uint8_t header[HEADER_SIZE];
+    bool ok = std::fread(header, 1, HEADER_SIZE, file) == HEADER_SIZE &&
+              std::memcmp(header, MAGIC, 4) == 0 && detail::get16(header + 4) == VERSION &&
+              detail::get16(header + 6) == RECORD_SIZE;
+    uint32_t count = ok ? detail::get32(header + 8) : 0;
+
+    size_t first = out.size();
+    for (uint32_t n = 0; ok && n < count; n++) {
+        uint8_t in[RECORD_SIZE];
+        if (std::fread(in, 1, RECORD_SIZE, file) != RECORD_SIZE) {
+            ok = false;
+            break;
+        }
+        Record r;
+        r.gapMicros = detail::get32(in);
+        r.puzzle = in[4];
+        r.flags = in[5];
+        r.answer = in[6];
+        r.action = in[7];
+        for (int i = 0; i < 4; i++) r.value[i] = static_cast<int16_t>(detail::get16(in + 8 + 2 * i));
+        if (r.puzzle >= NUM_PUZZLES) {
+            ok = false;
+            break;
+        }
+        out.push_back(r);
+    }
+    std::fclose(file);
+
+    if (!ok) out.resize(first);
+    return ok;
+}
+
+//=============================================================================
+// Replayer - The engine work of each recorded trial, on its own networks
+//=============================================================================
+class Replayer {
+public:
+    // Networks are reinitialized from `seed` at every session start
+    explicit Replayer(uint32_t seed = 1, Backend backend = Backend::INTEGER)
+        : gen_net_(backend), feat_net_(backend), xor_net_(backend),
+          seq_net_(backend), comp_net_(backend), seed_(seed ? seed : 1) {}
+
+    // Decide, then learn the recorded answer. Returns whether the decision
+    // matched it (Sequence: whether the replayed choice was the recorded press).
+    bool apply(const Record& r) {
+        if (r.flags & SESSION_START) {
+            for (int p = 0; p < NUM_PUZZLES; p++) net(static_cast<PuzzleType>(p)).reset(seed_ + p);
+        } else if (r.flags & PUZZLE_RESET) {
+            net(r.type()).reset(seed_ + r.puzzle);
+        }
+
+        const int16_t* v = r.value;
+        bool answer = r.answer != 0;
+        switch (r.type()) {
+            case PuzzleType::GENERALIZATION: {
+                bool choseA = gen_net_.chooseA(v[0], v[1], v[2], v[3]);
+                gen_net_.learn(v[0], v[1], v[2], v[3], answer);
+                return choseA == answer;
+            }
+            case PuzzleType::FEATURE_SELECTION: {
+                bool choseA = feat_net_.chooseA(v[0], v[1], v[2], v[3]);
+                feat_net_.learn(v[0], v[1], v[2], v[3], answer);
+                return choseA == answer;
+            }
+            case PuzzleType::XOR_CONTEXT: {
+                XORTrial t{v[0] != 0, v[1] != 0, answer};
+                bool safe = xor_net_.isSafe(t.lightInput(), t.pathInput());
+                xor_net_.learn(t.lightInput(), t.pathInput(), answer);
+                return safe == answer;
+            }
+            case PuzzleType::SEQUENCE: {
+                int action = seq_net_.chooseAction(v[0]);
+                // A correct A is the first step of an episode, buffered
+                // until its B (or failure) ends it, as in Game
+                if (answer && r.action == 0) seq_net_.addStep(v[0], r.action, answer);
+                else seq_net_.learnFromOutcome(v[0], r.action, answer);
+                return action == r.action;
+            }
+            case PuzzleType::COMPOSITION: {
+                CompositionTrial t{v[0] != 0, v[1], v[2], answer};
+                bool choseA = comp_net_.chooseA(t.lightInput(), t.sizeA, t.sizeB);
+                comp_net_.learn(t.lightInput(), t.sizeA, t.sizeB, answer);
+                return choseA == answer;
+            }
+        }
+        return false;
+    }
+
+    IntgrNNWrapper& net(PuzzleType type) {
+        switch (type) {
+            case PuzzleType::GENERALIZATION: return gen_net_;
+            case PuzzleType::FEATURE_SELECTION: return feat_net_;
+            case PuzzleType::XOR_CONTEXT: return xor_net_;
+            case PuzzleType::SEQUENCE: return seq_net_;
+            case PuzzleType::COMPOSITION: break;
+        }
+        return comp_net_;
+    }
+
+private:
+    GeneralizationNet gen_net_;
+    FeatureSelectionNet feat_net_;
+    XORNet xor_net_;
+    SequenceNet seq_net_;
+    CompositionNet comp_net_;
+    uint32_t seed_;
+};
+
+} // namespace workload
+} // namespace enen
@@ -0,0 +1,96 @@
+/**
+ * enen Demo: Engine Benchmarks
+ *
+ * Usage:
+ *   ./enen-bench <mode> [options]
+ *
+ * Each mode lives in its own src/bench_<mode>.cpp.
+ */
+
+#include "bench.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+//=============================================================================
+// Allocation counting (replaces global operator new for this binary)
+//=============================================================================
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+uint64_t enen::bench::allocationCount() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+//=============================================================================
+// Mode dispatch
+//=============================================================================
+namespace {
+
+struct Mode {
+    const char* name;
+    const char* description;
+    int (*run)(int argc, char** argv);
+};
+
+const Mode MODES[] = {
+    {"backend", "IntgrNN vs float32: decision/learn latency, trials-to-mastery, memory",
+     enen::bench::runBackendBench},
+    {"heatmap", "Decision heatmap: batched grid re-score vs cached redraw per frame",
+     enen::bench::runHeatmapBench},
+    {"gauntlet", "Composition gauntlet: fixed length vs sequential (SPRT) early stop",
+     enen::bench::runGauntletBench},
+    {"demo", "Full demo: five puzzles one after another vs one thread each",
+     enen::bench::runDemoBench},
+    {"autorun", "Autorun casts: simulate once, render frames on 1..N threads",
+     enen::bench::runAutorunBench},
+    {"cast", "Cast output: gzip ratio and throughput, stdio vs async file writers",
+     enen::bench::runCastBench},
+    {"render", "Rendering: composition per screen, cast encoding, autorun time split",
+     enen::bench::runRenderBench},
+    {"replay", "Captured workloads replayed at recorded or max speed: latency percentiles",
+     enen::bench::runReplayBench},
+    {"pool", "Per-run setup: fresh Game vs reinitialized GamePool game, time and allocations",
+     enen::bench::runPoolBench},
+    {"evo", "Gradient replay vs int8 (1+lambda) evolution: trials to mastery, wall time",
+     enen::bench::runEvoBench},
+    {"batch", "learn() per sample vs learnBatch() of k: replay updates, time, accuracy",
+     enen::bench::runBatchBench},
+    {"paired", "Two learner settings on common random numbers: paired differences, 95% CI",
+     enen::bench::runPairedBench},
+};
+
+void usage(const char* argv0) {
+    std::fprintf(stderr, "Usage: %s <mode> [options]\n\nModes:\n", argv0);
+    for (const auto& mode : MODES) {
+        std::fprintf(stderr, "  %-10s %s\n", mode.name, mode.description);
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+    for (const auto& mode : MODES) {
+        if (std::strcmp(argv[1], mode.name) == 0) {
+            return mode.run(argc - 1, argv + 1);
+        }
+    }
+    usage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,73 @@
+/**
+ * enen-bench autorun: two-phase cast generation
+ *
+ * Simulates a batch of demo variants (one per seed) into frame logs, then
+ * renders the logs into asciinema events with 1, 2, 4, ... threads up to
+ * the hardware thread count. Reports simulation time, render time and
+ * speedup per thread count, and checks every rendering is byte-identical
+ * to the single-threaded one.
+ *
+ * Options:
+ *   --variants N   demo variants (seeds) in the batch (default 8)
+ */
+
+#include "autorun.hpp"
+#include "bench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using namespace enen;
+using bench::Stopwatch;
+
+int bench::runAutorunBench(int argc, char** argv) {
+    int variants = 8;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--variants") == 0 && i + 1 < argc) {
+            variants = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench autorun [--variants N]\n");
+            return 2;
+        }
+    }
+
+    // Phase 1: simulate every variant
+    Stopwatch sw;
+    std::vector<FrameLog> logs;
+    size_t frames = 0;
+    for (int v = 0; v < variants; v++) {
+        logs.push_back(simulateDemo(42 + static_cast<uint32_t>(v)));
+        frames += logs.back().size();
+    }
+    double simMs = sw.seconds() * 1000.0;
+
+    int hw = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    printf("Autorun: simulate, then render casts in parallel\n");
+    printf("================================================\n");
+    printf("Variants: %d, frames: %zu, hardware threads: %d\n", variants, frames, hw);
+    printf("Simulation: %.1f ms (sequential per variant)\n\n", simMs);
+
+    printf("  %-8s %12s %12s %10s %10s\n", "threads", "render ms", "frames/s", "speedup", "output");
+
+    std::vector<std::vector<std::string>> reference;
+    double baseMs = 0.0;
+    for (int threads = 1; ; threads = std::min(threads * 2, hw)) {
+        sw.restart();
+        std::vector<std::vector<std::string>> casts;
+        for (const auto& log : logs) casts.push_back(renderCast(log, threads));
+        double ms = sw.seconds() * 1000.0;
+
+        if (threads == 1) {
+            reference = casts;
+            baseMs = ms;
+        }
+        printf("  %-8d %12.1f %12.0f %9.2fx %10s\n", threads, ms,
+               ms > 0 ? frames / (ms / 1000.0) : 0.0, ms > 0 ? baseMs / ms : 0.0,
+               casts == reference ? "identical" : "DIFFERS");
+        if (threads >= hw) break;
+    }
+    return 0;
+}
@@ -0,0 +1,231 @@
+/**
+ * enen-bench backend: IntgrNN vs float32 reference
+ *
+ * Puts numbers behind the integer-network design choice. Both backends run
+ * the same wrappers, topologies and experience-replay loop; only the
+ * network underneath differs.
+ *
+ * Reports per puzzle:
+ * - Decision latency (one chooseA/isSafe/chooseAction call)
+ * - Learn latency (one learn() call, i.e. a full replay pass)
+ * - Trials to mastery (Game::runPuzzleToCompletion over a seed sweep)
+ * And per creature: model bytes and replay-buffer bytes after the demo.
+ *
+ * Options: --seeds N (default 20), --trials N latency trials (default 30)
+ */
+
+#include "bench.hpp"
+#include "game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+namespace {
+
+constexpr int DECISION_REPEATS = 200;  // Calls per timed decision sample
+
+struct PuzzleLatency {
+    Samples decideNs;
+    Samples learnUs;
+};
+
+// Time decisions and learning on a fresh network, driven like Game does
+void measureLatency(Backend backend, int puzzle, uint32_t seed, int trials,
+                    PuzzleLatency& out) {
+    RNG rng(seed);
+    volatile bool sink = false;
+
+    switch (static_cast<PuzzleType>(puzzle)) {
+        case PuzzleType::GENERALIZATION: {
+            GeneralizationNet net(backend);
+            net.reset(seed);
+            for (int i = 0; i < trials; i++) {
+                auto t = MushroomTrial::generate(rng);
+                Stopwatch sw;
+                for (int r = 0; r < DECISION_REPEATS; r++) {
+                    sink = net.chooseA(t.sizeA, t.sizeB, t.colorA, t.colorB);
+                }
+                out.decideNs.add(sw.micros() * 1000.0 / DECISION_REPEATS);
+                sw.restart();
+                net.learn(t.sizeA, t.sizeB, t.colorA, t.colorB, t.correctIsA);
+                out.learnUs.add(sw.micros());
+            }
+            break;
+        }
+        case PuzzleType::FEATURE_SELECTION: {
+            FeatureSelectionNet net(backend);
+            net.reset(seed);
+            for (int i = 0; i < trials; i++) {
+                auto t = ShapeTrial::generate(rng);
+                Stopwatch sw;
+                for (int r = 0; r < DECISION_REPEATS; r++) {
+                    sink = net.chooseA(t.colorA, t.shapeA, t.colorB, t.shapeB);
+                }
+                out.decideNs.add(sw.micros() * 1000.0 / DECISION_REPEATS);
+                sw.restart();
+                net.learn(t.colorA, t.shapeA, t.colorB, t.shapeB, t.correctIsA);
+                out.learnUs.add(sw.micros());
+            }
+            break;
+        }
+        case PuzzleType::XOR_CONTEXT: {
+            XORNet net(backend);
+            net.reset(seed);
+            for (int i = 0; i < trials; i++) {
+                auto t = XORTrial::generate(rng);
+                Stopwatch sw;
+                for (int r = 0; r < DECISION_REPEATS; r++) {
+                    sink = net.isSafe(t.lightInput(), t.pathInput());
+                }
+                out.decideNs.add(sw.micros() * 1000.0 / DECISION_REPEATS);
+                sw.restart();
+                net.learn(t.lightInput(), t.pathInput(), t.isSafe);
+                out.learnUs.add(sw.micros());
+            }
+            break;
+        }
+        case PuzzleType::SEQUENCE: {
+            SequenceNet net(backend);
+            net.reset(seed);
+            SequencePuzzle puzzle;
+            for (int i = 0; i < trials; i++) {
+                int16_t last = puzzle.lastActionInput();
+                int action = 0;
+                Stopwatch sw;
+                for (int r = 0; r < DECISION_REPEATS; r++) {
+                    action = net.chooseAction(last);
+                }
+                out.decideNs.add(sw.micros() * 1000.0 / DECISION_REPEATS);
+                puzzle.pressButton(action);
+                if (puzzle.inProgress()) {
+                    net.addStep(last, action, true);  // Learned when the episode ends
+                    continue;
+                }
+                sw.restart();
+                net.learnFromOutcome(last, action, !puzzle.isFail());
+                out.learnUs.add(sw.micros());
+                puzzle.reset();
+            }
+            break;
+        }
+        case PuzzleType::COMPOSITION: {
+            CompositionNet net(backend);
+            net.reset(seed);
+            for (int i = 0; i < trials; i++) {
+                auto t = CompositionTrial::generate(rng);
+                Stopwatch sw;
+                for (int r = 0; r < DECISION_REPEATS; r++) {
+                    sink = net.chooseA(t.lightInput(), t.sizeA, t.sizeB);
+                }
+                out.decideNs.add(sw.micros() * 1000.0 / DECISION_REPEATS);
+                sw.restart();
+                net.learn(t.lightInput(), t.sizeA, t.sizeB, t.correctIsA);
+                out.learnUs.add(sw.micros());
+            }
+            break;
+        }
+    }
+    (void)sink;
+}
+
+struct BackendReport {
+    PuzzleLatency latency[NUM_PUZZLES];
+    Samples trials[NUM_PUZZLES];
+    int failures[NUM_PUZZLES] = {};
+    size_t modelBytes = 0;
+    Samples replayBytes;
+};
+
+void runBackend(Backend backend, int seeds, int latencyTrials, int maxTrials,
+                BackendReport& report) {
+    for (int s = 0; s < seeds; s++) {
+        uint32_t seed = 1000 + static_cast<uint32_t>(s);
+
+        for (int p = 0; p < NUM_PUZZLES; p++) {
+            measureLatency(backend, p, seed, latencyTrials, report.latency[p]);
+        }
+
+        Game game(seed, backend);
+        for (int p = 0; p < NUM_PUZZLES; p++) {
+            int trials = game.runPuzzleToCompletion(maxTrials);
+            if (trials > 0) {
+                report.trials[p].add(trials);
+            } else {
+                report.failures[p]++;
+            }
+            if (p < NUM_PUZZLES - 1) game.nextPuzzle();
+        }
+
+        const auto& st = game.state();
+        report.modelBytes = st.totalModelBytes();
+        report.replayBytes.add(static_cast<double>(
+            st.gen_net.historyBytes() + st.feat_net.historyBytes() + st.xor_net.historyBytes() +
+            st.seq_net.historyBytes() + st.comp_net.historyBytes()));
+    }
+}
+
+void printReport(Backend backend, BackendReport& r, int seeds) {
+    printf("\n%s\n", backendName(backend));
+    printf("  %-11s %12s %12s %12s %14s\n",
+           "Puzzle", "decide (ns)", "learn (us)", "learn p99", "trials (fail)");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        printf("  %-11s %12.0f %12.1f %12.1f %8.1f (%d/%d)\n",
+               puzzleLabel(static_cast<PuzzleType>(p)),
+               r.latency[p].decideNs.mean(),
+               r.latency[p].learnUs.mean(),
+               r.latency[p].learnUs.percentile(99),
+               r.trials[p].mean(), r.failures[p], seeds);
+    }
+    printf("  Memory per creature: %zu model bytes + %.0f replay bytes (sizeof GameState %zu)\n",
+           r.modelBytes, r.replayBytes.mean(), sizeof(GameState));
+}
+
+} // anonymous namespace
+
+int bench::runBackendBench(int argc, char** argv) {
+    int seeds = 20;
+    int latencyTrials = 30;
+    int maxTrials = 500;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seeds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+            latencyTrials = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench backend [--seeds N] [--trials N]\n");
+            return 2;
+        }
+    }
+
+    printf("Backend Comparison: IntgrNN vs float32\n");
+    printf("======================================\n");
+    printf("Seeds: %d, latency trials per puzzle: %d, max trials to mastery: %d\n",
+           seeds, latencyTrials, maxTrials);
+
+    BackendReport integer;
+    BackendReport floating;
+    runBackend(Backend::INTEGER, seeds, latencyTrials, maxTrials, integer);
+    runBackend(Backend::FLOAT, seeds, latencyTrials, maxTrials, floating);
+
+    printReport(Backend::INTEGER, integer, seeds);
+    printReport(Backend::FLOAT, floating, seeds);
+
+    printf("\nRatios (float / IntgrNN)\n");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        double d = integer.latency[p].decideNs.mean();
+        double l = integer.latency[p].learnUs.mean();
+        double t = integer.trials[p].mean();
+        printf("  %-11s decide %.2fx  learn %.2fx  trials %.2fx\n", puzzleLabel(static_cast<PuzzleType>(p)),
+               d > 0 ? floating.latency[p].decideNs.mean() / d : 0.0,
+               l > 0 ? floating.latency[p].learnUs.mean() / l : 0.0,
+               t > 0 ? floating.trials[p].mean() / t : 0.0);
+    }
+    printf("  Model bytes %.2fx\n",
+           integer.modelBytes > 0 ? static_cast<double>(floating.modelBytes) / integer.modelBytes : 0.0);
+    return 0;
+}
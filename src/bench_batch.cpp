@@ -0,0 +1,177 @@
+/**
+ * enen-bench batch: k separate learn() calls vs one learnBatch() of k
+ *
+ * Streams the same samples into two networks from the same seed: one
+ * learn() per sample (a full replay of the history each), and one
+ * learnBatch() per group of k (one replay for the group). The batch
+ * replay runs the policy's epochs: the network's per-trial count (x1),
+ * or a multiple of it. Reports replay updates, learn time and accuracy
+ * on held-out trials once every sample has been learned, so the saving
+ * can be weighed against what it costs in learning.
+ *
+ * Options:
+ *   --samples N   samples streamed per run (default 48)
+ *   --seeds N     runs per row (default 10)
+ *   --float       run on the float32 reference backend
+ */
+
+#include "bench.hpp"
+#include "networks.hpp"
+#include "puzzles.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+namespace {
+
+constexpr int HELD_OUT = 200;
+const int BATCH_SIZES[] = {1, 2, 4, 8, 16};
+const int EPOCH_MULTIPLES[] = {1, 2};  // Batch policy: x per-trial epochs
+
+struct Result {
+    Samples updates;
+    Samples ms;
+    Samples accuracy;  // Percent of held-out trials right
+};
+
+// Feeds `samples` to the network k at a time (k = 0: one learn() each),
+// then scores it
+template <class Net, class Learn, class Score>
+void run(Net& net, const std::vector<typename Net::Sample>& samples, size_t k, int epochs,
+         Learn learn, Score score, Result& out) {
+    net.setBatchEpochs(epochs);
+    size_t updates = 0;
+    Stopwatch sw;
+    if (k == 0) {
+        for (const auto& sample : samples) updates += learn(net, sample);
+    } else {
+        for (size_t i = 0; i < samples.size(); i += k) {
+            size_t count = std::min(k, samples.size() - i);
+            net.beginLearnBatch(&samples[i], count);
+            updates += net.remainingSteps();
+            net.finishTraining();
+        }
+    }
+    out.ms.add(sw.seconds() * 1000.0);
+    out.updates.add(static_cast<double>(updates));
+    out.accuracy.add(score(net));
+}
+
+template <class Net, class Generate, class Learn, class Score>
+void benchPuzzle(const char* name, Backend backend, int sampleCount, int seeds,
+                 Generate generate, Learn learn, Score score) {
+    constexpr int epochsPerTrial = Net::EPOCHS_PER_TRIAL;
+    printf("\n%s (%d epochs per trial, %d samples)\n", name, epochsPerTrial, sampleCount);
+    printf("  %-20s %12s %10s %10s %10s\n", "", "updates", "ms", "accuracy", "speedup");
+
+    Result separate;
+    Result batched[sizeof(BATCH_SIZES) / sizeof(int)][sizeof(EPOCH_MULTIPLES) / sizeof(int)];
+    for (int s = 0; s < seeds; s++) {
+        uint32_t seed = 6000 + static_cast<uint32_t>(s);
+        RNG rng(seed);
+        std::vector<typename Net::Sample> samples;
+        for (int i = 0; i < sampleCount; i++) samples.push_back(generate(rng));
+
+        Net reference(backend);
+        reference.reset(seed);
+        run(reference, samples, 0, 0, learn, score, separate);
+        for (size_t b = 0; b < sizeof(BATCH_SIZES) / sizeof(int); b++) {
+            for (size_t e = 0; e < sizeof(EPOCH_MULTIPLES) / sizeof(int); e++) {
+                Net net(backend);
+                net.reset(seed);
+                run(net, samples, BATCH_SIZES[b], EPOCH_MULTIPLES[e] * epochsPerTrial, learn,
+                    score, batched[b][e]);
+            }
+        }
+    }
+
+    double baseMs = separate.ms.mean();
+    printf("  %-20s %12.0f %10.2f %9.1f%% %9.2fx\n", "learn() x1", separate.updates.mean(),
+           baseMs, separate.accuracy.mean(), 1.0);
+    for (size_t b = 0; b < sizeof(BATCH_SIZES) / sizeof(int); b++) {
+        for (size_t e = 0; e < sizeof(EPOCH_MULTIPLES) / sizeof(int); e++) {
+            Result& r = batched[b][e];
+            char label[32];
+            std::snprintf(label, sizeof(label), "learnBatch(%d) x%d", BATCH_SIZES[b],
+                          EPOCH_MULTIPLES[e]);
+            printf("  %-20s %12.0f %10.2f %9.1f%% %9.2fx\n", label, r.updates.mean(),
+                   r.ms.mean(), r.accuracy.mean(), r.ms.mean() > 0 ? baseMs / r.ms.mean() : 0.0);
+        }
+    }
+}
+
+} // anonymous namespace
+
+int bench::runBatchBench(int argc, char** argv) {
+    int sampleCount = 48;
+    int seeds = 10;
+    Backend backend = Backend::INTEGER;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            sampleCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seeds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--float") == 0) {
+            backend = Backend::FLOAT;
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench batch [--samples N] [--seeds N] [--float]\n");
+            return 2;
+        }
+    }
+
+    printf("Batched learning: learn() per sample vs learnBatch() of k (%s)\n", backendName(backend));
+    printf("==============================================================\n");
+    printf("Seeds: %d, accuracy on %d held-out trials after the last sample\n", seeds, HELD_OUT);
+
+    benchPuzzle<GeneralizationNet>(
+        puzzleLabel(PuzzleType::GENERALIZATION), backend, sampleCount, seeds,
+        [](RNG& rng) {
+            auto t = MushroomTrial::generate(rng);
+            return GeneralizationNet::Sample{t.sizeA, t.sizeB, t.colorA, t.colorB, t.correctIsA};
+        },
+        [](GeneralizationNet& net, const GeneralizationNet::Sample& s) {
+            net.beginLearn(s.sizeA, s.sizeB, s.colorA, s.colorB, s.chooseA);
+            size_t updates = net.remainingSteps();
+            net.finishTraining();
+            return updates;
+        },
+        [](const GeneralizationNet& net) {
+            RNG rng(99);
+            int right = 0;
+            for (int i = 0; i < HELD_OUT; i++) {
+                auto t = MushroomTrial::generate(rng);
+                right += net.chooseA(t.sizeA, t.sizeB, t.colorA, t.colorB) == t.correctIsA;
+            }
+            return 100.0 * right / HELD_OUT;
+        });
+
+    benchPuzzle<XORNet>(
+        puzzleLabel(PuzzleType::XOR_CONTEXT), backend, sampleCount, seeds,
+        [](RNG& rng) {
+            auto t = XORTrial::generate(rng);
+            return XORNet::Sample{t.lightInput(), t.pathInput(), t.isSafe};
+        },
+        [](XORNet& net, const XORNet::Sample& s) {
+            net.beginLearn(s.light, s.path, s.safe);
+            size_t updates = net.remainingSteps();
+            net.finishTraining();
+            return updates;
+        },
+        [](const XORNet& net) {
+            RNG rng(99);
+            int right = 0;
+            for (int i = 0; i < HELD_OUT; i++) {
+                auto t = XORTrial::generate(rng);
+                right += net.isSafe(t.lightInput(), t.pathInput()) == t.isSafe;
+            }
+            return 100.0 * right / HELD_OUT;
+        });
+    return 0;
+}
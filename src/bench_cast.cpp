@@ -0,0 +1,164 @@
+/**
+ * enen-bench cast: compressed cast output
+ *
+ * Renders a batch of demo variants to cast text once, then streams it
+ * through CastStream with each compression: none, gzip (zlib when built
+ * with it) and the in-tree gzip encoder. Reports compression ratio,
+ * producer throughput (what frame generation sees), writer-thread encode
+ * throughput, and how long the producer stalled on the writer.
+ *
+ * With zlib, each gzip stream is also inflated and compared to the input.
+ *
+ * Then the uncompressed text is written out three ways: blocking stdio
+ * (fwrite + fflush per chunk, as frames used to be), and AsyncWriter with
+ * its writer thread and with io_uring. Reports what the producer sees,
+ * the final drain, and whether the file matches.
+ *
+ * Options:
+ *   --variants N   demo variants (seeds) in the batch (default 8)
+ */
+
+#include "async_writer.hpp"
+#include "autorun.hpp"
+#include "bench.hpp"
+#include "cast_stream.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace enen;
+using bench::Stopwatch;
+
+namespace {
+
+std::vector<uint8_t> readAll(std::FILE* file) {
+    std::vector<uint8_t> bytes;
+    std::rewind(file);
+    uint8_t chunk[65536];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + n);
+    return bytes;
+}
+
+// "ok" / "MISMATCH" against the original text, or "-" if it can't be checked
+const char* verify(Compression compression, const std::vector<uint8_t>& encoded,
+                   const std::string& original) {
+    if (compression == Compression::NONE) {
+        return std::equal(encoded.begin(), encoded.end(), original.begin(), original.end())
+                   ? "ok" : "MISMATCH";
+    }
+#ifdef ENEN_HAVE_ZLIB
+    z_stream stream = {};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) return "MISMATCH";
+    std::string decoded(original.size() + 1, '\0');
+    stream.next_in = const_cast<Bytef*>(encoded.data());
+    stream.avail_in = static_cast<uInt>(encoded.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&decoded[0]);
+    stream.avail_out = static_cast<uInt>(decoded.size());
+    int status = inflate(&stream, Z_FINISH);
+    decoded.resize(stream.total_out);
+    inflateEnd(&stream);
+    return (status == Z_STREAM_END && decoded == original) ? "ok" : "MISMATCH";
+#else
+    return "-";
+#endif
+}
+
+} // anonymous namespace
+
+int bench::runCastBench(int argc, char** argv) {
+    int variants = 8;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--variants") == 0 && i + 1 < argc) {
+            variants = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench cast [--variants N]\n");
+            return 2;
+        }
+    }
+
+    // Cast text for the batch, in the block sizes autorun writes
+    std::vector<std::string> chunks;
+    size_t total = 0;
+    for (int v = 0; v < variants; v++) {
+        for (auto& chunk : renderCast(simulateDemo(42 + static_cast<uint32_t>(v)))) {
+            total += chunk.size();
+            chunks.push_back(std::move(chunk));
+        }
+    }
+    std::string original;
+    original.reserve(total);
+    for (const auto& chunk : chunks) original += chunk;
+
+    printf("Cast Output: streaming compression on a writer thread\n");
+    printf("=====================================================\n");
+    printf("Variants: %d, cast text: %.2f MB, block: %zu KB\n\n",
+           variants, total / 1e6, CastStream::BLOCK_SIZE / 1024);
+    printf("  %-15s %10s %7s %12s %12s %10s %8s\n",
+           "Compression", "bytes", "ratio", "produce MB/s", "encode MB/s", "stall ms", "check");
+
+    for (Compression compression : {Compression::NONE, Compression::GZIP, Compression::GZIP_BUILTIN}) {
+        std::FILE* file = std::tmpfile();
+        if (!file) {
+            std::fprintf(stderr, "Cannot create a temporary file\n");
+            return 1;
+        }
+
+        Stopwatch sw;
+        CastStream stream(file, compression);
+        for (const auto& chunk : chunks) stream.write(chunk);
+        double produceSeconds = sw.seconds();  // Until the last block is handed off
+        stream.close();
+
+        const auto& stats = stream.stats();
+        std::vector<uint8_t> encoded = readAll(file);
+        std::fclose(file);
+
+        printf("  %-15s %10llu %6.1fx %12.1f %12.1f %10.2f %8s\n", compressionName(compression),
+               static_cast<unsigned long long>(stats.bytesOut), stats.ratio(),
+               produceSeconds > 0 ? total / produceSeconds / 1e6 : 0.0,
+               stats.encodeMBps(), stats.stallSeconds * 1000.0,
+               verify(compression, encoded, original));
+    }
+
+    printf("\nOutput path: producer time per chunk written to a file\n");
+    printf("  %-15s %12s %10s %10s %10s %8s\n",
+           "Writer", "produce MB/s", "stall ms", "drain ms", "total ms", "check");
+    for (int mode = 0; mode < 3; mode++) {
+        std::FILE* file = std::tmpfile();
+        if (!file) {
+            std::fprintf(stderr, "Cannot create a temporary file\n");
+            return 1;
+        }
+
+        const char* name = "stdio";
+        double produceSeconds = 0.0, stallMs = 0.0, drainMs = 0.0;
+        Stopwatch sw;
+        if (mode == 0) {
+            for (const auto& chunk : chunks) {
+                std::fwrite(chunk.data(), 1, chunk.size(), file);
+                std::fflush(file);
+            }
+            produceSeconds = sw.seconds();
+        } else {
+            AsyncWriter writer(fileno(file), mode == 1 ? IoBackend::THREAD : IoBackend::IO_URING);
+            for (const auto& chunk : chunks) writer.write(chunk);
+            produceSeconds = sw.seconds();
+            writer.close();
+            name = writer.backend() == IoBackend::IO_URING
+                       ? (writer.stats().registeredBuffers ? "io_uring fixed" : "io_uring")
+                       : "thread";
+            stallMs = writer.stats().stallSeconds * 1000.0;
+            drainMs = writer.stats().drainSeconds * 1000.0;
+        }
+        double totalSeconds = sw.seconds();
+
+        std::vector<uint8_t> written = readAll(file);
+        std::fclose(file);
+        printf("  %-15s %12.1f %10.2f %10.2f %10.2f %8s\n", name,
+               produceSeconds > 0 ? total / produceSeconds / 1e6 : 0.0, stallMs, drainMs,
+               totalSeconds * 1000.0, verify(Compression::NONE, written, original));
+    }
+    return 0;
+}
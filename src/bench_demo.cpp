@@ -0,0 +1,87 @@
+/**
+ * enen-bench demo: full demo, sequential vs one thread per puzzle
+ *
+ * Runs all five puzzles for each seed with Game::runFullDemo (one after
+ * another) and Game::runFullDemoParallel (one thread each). Reports wall
+ * time per demo for both, and per puzzle in the parallel run: the parallel
+ * demo can finish no sooner than its slowest puzzle.
+ *
+ * The two modes draw trials differently (the parallel run gives each
+ * puzzle its own RNG substream), so trial counts are comparable only in
+ * distribution, not seed by seed.
+ *
+ * Options:
+ *   --seeds N   seeds in the sweep (default 10)
+ *   --float     run on the float32 reference backend
+ */
+
+#include "bench.hpp"
+#include "game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+int bench::runDemoBench(int argc, char** argv) {
+    int seeds = 10;
+    Backend backend = Backend::INTEGER;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seeds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--float") == 0) {
+            backend = Backend::FLOAT;
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench demo [--seeds N] [--float]\n");
+            return 2;
+        }
+    }
+
+    printf("Full Demo: sequential vs parallel puzzles (%s)\n", backendName(backend));
+    printf("==============================================\n");
+    printf("Seeds: %d, hardware threads: %u\n", seeds, std::thread::hardware_concurrency());
+
+    Samples seqMs, parMs;
+    Samples puzzleMs[NUM_PUZZLES];
+    Samples puzzleTrials[NUM_PUZZLES];
+    int seqCompleted = 0, parCompleted = 0;
+
+    for (int i = 0; i < seeds; i++) {
+        uint32_t seed = 7000 + static_cast<uint32_t>(i);
+
+        Game sequential(seed, backend);
+        Stopwatch sw;
+        if (sequential.runFullDemo()) seqCompleted++;
+        seqMs.add(sw.seconds() * 1000.0);
+
+        Game parallel(seed, backend);
+        sw.restart();
+        if (parallel.runFullDemoParallel()) parCompleted++;
+        parMs.add(sw.seconds() * 1000.0);
+
+        for (int p = 0; p < NUM_PUZZLES; p++) {
+            const auto& result = parallel.puzzleResult(static_cast<PuzzleType>(p));
+            puzzleMs[p].add(result.seconds * 1000.0);
+            puzzleTrials[p].add(result.trials);
+        }
+    }
+
+    printf("\n  %-11s %10s %10s %10s\n", "Mode", "completed", "ms", "ms p99");
+    printf("  %-11s %7d/%-2d %10.1f %10.1f\n", "sequential", seqCompleted, seeds,
+           seqMs.mean(), seqMs.percentile(99));
+    printf("  %-11s %7d/%-2d %10.1f %10.1f\n", "parallel", parCompleted, seeds,
+           parMs.mean(), parMs.percentile(99));
+    printf("  Speedup: %.2fx\n", parMs.total() > 0 ? seqMs.total() / parMs.total() : 0.0);
+
+    printf("\n  Parallel, per puzzle:\n");
+    printf("  %-20s %10s %10s\n", "Puzzle", "trials", "ms");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        printf("  %-20s %10.1f %10.1f\n", puzzleLabel(static_cast<PuzzleType>(p)),
+               puzzleTrials[p].mean(), puzzleMs[p].mean());
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * enen-bench evo: gradient replay vs (1+lambda) evolution
+ *
+ * Runs every puzzle for a seed sweep on three backends with the same
+ * wrappers and replay buffers: IntgrNN and float32, which learn() with a
+ * gradient step per sample per epoch, and the int8 evolved network
+ * (evolved_nn.hpp), which scores lambda mutants on the whole buffer per
+ * generation and stops a pass once every sample is right. Reports trials
+ * to mastery and wall time per puzzle; the evolved network is meant for
+ * the tiny ones (XOR context, 17 weights; sequence, 18).
+ *
+ * Then times a generation on its own for growing lambda, scored on the
+ * calling thread and on every CPU, to show where parallel scoring starts
+ * to pay for its threads.
+ *
+ * Options:
+ *   --seeds N        seeds in the sweep (default 20)
+ *   --max-trials N   per puzzle (default 500)
+ */
+
+#include "bench.hpp"
+#include "game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+namespace {
+
+const Backend BACKENDS[] = {Backend::INTEGER, Backend::FLOAT, Backend::EVOLVED};
+constexpr int NUM_BACKENDS = 3;
+
+struct PuzzleStats {
+    Samples trials;
+    Samples ms;
+    int failures = 0;
+};
+
+void runSweep(Backend backend, int seeds, int maxTrials, PuzzleStats (&out)[NUM_PUZZLES]) {
+    for (int s = 0; s < seeds; s++) {
+        Game game(5000 + static_cast<uint32_t>(s), backend);
+        for (int p = 0; p < NUM_PUZZLES; p++) {
+            Stopwatch sw;
+            int trials = game.runPuzzleToCompletion(maxTrials);
+            out[p].ms.add(sw.seconds() * 1000.0);
+            if (trials > 0) out[p].trials.add(trials);
+            else out[p].failures++;
+            if (p < NUM_PUZZLES - 1) game.nextPuzzle();
+        }
+    }
+}
+
+// Generations per second on an XOR-shaped network (2-4-1) over a replay
+// buffer of `samples` rows
+double generationsPerSecond(int lambda, int threads, size_t samples) {
+    EvolutionConfig config;
+    config.offspring = lambda;
+    config.threads = threads;
+    config.parallelWork = 0;  // Always use the threads asked for
+    EvolvedMLP net(2, {4}, 1, config);
+    net.reinitialize(77);
+
+    RNG rng(99);
+    std::vector<uint8_t> inputs(samples * 2);
+    std::vector<uint8_t> targets(samples);
+    for (size_t r = 0; r < samples; r++) {
+        auto t = XORTrial::generate(rng);
+        inputs[r * 2] = scaleToU8(t.lightInput());
+        inputs[r * 2 + 1] = scaleToU8(t.pathInput());
+        targets[r] = t.isSafe ? 255 : 0;
+    }
+
+    int generations = 0;
+    Stopwatch sw;
+    while (sw.seconds() < 0.2) {
+        for (int g = 0; g < 10; g++) net.evolve(inputs.data(), targets.data(), samples);
+        generations += 10;
+    }
+    return generations / sw.seconds();
+}
+
+} // anonymous namespace
+
+int bench::runEvoBench(int argc, char** argv) {
+    int seeds = 20;
+    int maxTrials = 500;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seeds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-trials") == 0 && i + 1 < argc) {
+            maxTrials = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench evo [--seeds N] [--max-trials N]\n");
+            return 2;
+        }
+    }
+
+    printf("Learners: gradient replay vs (1+lambda) evolution\n");
+    printf("==================================================\n");
+    printf("Seeds: %d, max trials per puzzle: %d\n", seeds, maxTrials);
+
+    PuzzleStats stats[NUM_BACKENDS][NUM_PUZZLES];
+    for (int b = 0; b < NUM_BACKENDS; b++) runSweep(BACKENDS[b], seeds, maxTrials, stats[b]);
+
+    printf("\n  %-11s", "Puzzle");
+    for (Backend backend : BACKENDS) printf(" %24s", backendName(backend));
+    printf("\n  %-11s", "");
+    for (int b = 0; b < NUM_BACKENDS; b++) printf(" %8s %6s %8s", "trials", "fail", "ms");
+    printf("\n");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        printf("  %-11s", puzzleLabel(static_cast<PuzzleType>(p)));
+        for (int b = 0; b < NUM_BACKENDS; b++) {
+            printf(" %8.1f %6d %8.2f", stats[b][p].trials.mean(), stats[b][p].failures,
+                   stats[b][p].ms.mean());
+        }
+        printf("\n");
+    }
+
+    printf("\n  Evolved vs IntgrNN (time, trials):\n");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        double ms = stats[0][p].ms.mean();
+        double trials = stats[0][p].trials.mean();
+        printf("  %-11s %.2fx  %.2fx\n", puzzleLabel(static_cast<PuzzleType>(p)),
+               ms > 0 ? stats[2][p].ms.mean() / ms : 0.0,
+               trials > 0 ? stats[2][p].trials.mean() / trials : 0.0);
+    }
+
+    int cpus = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    printf("\n  Generation rate, XOR net, 64-sample replay (%d CPUs):\n", cpus);
+    printf("  %-8s %14s %14s\n", "lambda", "1 thread/s", "all CPUs/s");
+    for (int lambda : {8, 64, 512}) {
+        printf("  %-8d %14.0f %14.0f\n", lambda, generationsPerSecond(lambda, 1, 64),
+               generationsPerSecond(lambda, cpus, 64));
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * enen-bench gauntlet: fixed-length vs sequential (SPRT) Composition gauntlet
+ *
+ * Runs puzzle 5 for each seed twice from the same network weights and the
+ * same trial stream: once with the fixed 10 + 20 trials, once with
+ * GauntletState::Mode::SEQUENTIAL. Reports trials and wall time per
+ * gauntlet (almost all of it is CompositionNet::learn), how each
+ * sequential run was settled, and how often the SPRT verdict agrees with
+ * the fixed-length score.
+ *
+ * Options:
+ *   --seeds N      seeds in the sweep (default 30)
+ *   --float        run on the float32 reference backend
+ *   --p0 P --p1 P  failing / mastered accuracy (default 0.5 / 0.9)
+ *   --alpha A --beta B  error rates (default 0.05 / 0.05)
+ */
+
+#include "bench.hpp"
+#include "game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+namespace {
+
+struct GauntletRun {
+    int trials = 0;
+    double seconds = 0.0;
+    int scorePercent = 0;
+    SequentialTest::Verdict verdict = SequentialTest::Verdict::UNDECIDED;
+};
+
+GauntletRun runGauntlet(uint32_t seed, Backend backend, GauntletState::Mode mode,
+                        const SequentialTest::Config& config) {
+    Game game(seed, backend);
+    for (int p = 0; p < NUM_PUZZLES - 1; p++) game.nextPuzzle();
+
+    auto& s = game.state();
+    s.comp_net.reset(seed);
+    s.gauntlet.mode = mode;
+    s.gauntlet.warmup_test.config = config;
+    s.gauntlet.scored_test.config = config;
+
+    GauntletRun run;
+    Stopwatch sw;
+    run.trials = game.runPuzzleToCompletion(GauntletState::TOTAL_TRIALS);
+    run.seconds = sw.seconds();
+    run.scorePercent = s.gauntlet.scorePercent();
+    run.verdict = s.gauntlet.verdict();
+    return run;
+}
+
+} // anonymous namespace
+
+int bench::runGauntletBench(int argc, char** argv) {
+    int seeds = 30;
+    Backend backend = Backend::INTEGER;
+    SequentialTest::Config config;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seeds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--float") == 0) {
+            backend = Backend::FLOAT;
+        } else if (std::strcmp(argv[i], "--p0") == 0 && i + 1 < argc) {
+            config.p0 = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--p1") == 0 && i + 1 < argc) {
+            config.p1 = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            config.alpha = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--beta") == 0 && i + 1 < argc) {
+            config.beta = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench gauntlet [--seeds N] [--float] "
+                                 "[--p0 P] [--p1 P] [--alpha A] [--beta B]\n");
+            return 2;
+        }
+    }
+
+    printf("Composition Gauntlet: fixed vs sequential (%s)\n", backendName(backend));
+    printf("==============================================\n");
+    printf("Seeds: %d, SPRT p0=%.2f p1=%.2f alpha=%.3f beta=%.3f\n",
+           seeds, config.p0, config.p1, config.alpha, config.beta);
+
+    Samples fixedTrials, seqTrials, fixedMs, seqMs;
+    int mastered = 0, failing = 0, undecided = 0, agree = 0;
+
+    // Score a fixed run as "mastered" when it is closer to p1 than to p0
+    int passPercent = GauntletState::passPercent(config);
+
+    for (int i = 0; i < seeds; i++) {
+        uint32_t seed = 5000 + static_cast<uint32_t>(i);
+        auto fixed = runGauntlet(seed, backend, GauntletState::Mode::FIXED, config);
+        auto seq = runGauntlet(seed, backend, GauntletState::Mode::SEQUENTIAL, config);
+
+        fixedTrials.add(fixed.trials);
+        seqTrials.add(seq.trials);
+        fixedMs.add(fixed.seconds * 1000.0);
+        seqMs.add(seq.seconds * 1000.0);
+
+        bool fixedPass = fixed.scorePercent >= passPercent;
+        bool seqPass = seq.verdict == SequentialTest::Verdict::MASTERED ||
+                       (seq.verdict == SequentialTest::Verdict::UNDECIDED &&
+                        seq.scorePercent >= passPercent);
+        switch (seq.verdict) {
+            case SequentialTest::Verdict::MASTERED: mastered++; break;
+            case SequentialTest::Verdict::FAILING: failing++; break;
+            case SequentialTest::Verdict::UNDECIDED: undecided++; break;
+        }
+        if (fixedPass == seqPass) agree++;
+    }
+
+    printf("\n  %-11s %10s %10s %10s\n", "Mode", "trials", "ms", "ms p99");
+    printf("  %-11s %10.1f %10.1f %10.1f\n", "fixed",
+           fixedTrials.mean(), fixedMs.mean(), fixedMs.percentile(99));
+    printf("  %-11s %10.1f %10.1f %10.1f\n", "sequential",
+           seqTrials.mean(), seqMs.mean(), seqMs.percentile(99));
+
+    double savedTrials = fixedTrials.total() - seqTrials.total();
+    double savedMs = fixedMs.total() - seqMs.total();
+    printf("\n  Saved: %.0f trials (%.0f%%), %.1f ms learn time (%.0f%%)\n",
+           savedTrials, fixedTrials.total() > 0 ? 100.0 * savedTrials / fixedTrials.total() : 0.0,
+           savedMs, fixedMs.total() > 0 ? 100.0 * savedMs / fixedMs.total() : 0.0);
+    printf("  Sequential verdicts: %d mastered, %d failing, %d ran to the limit\n",
+           mastered, failing, undecided);
+    printf("  Agreement with fixed-length score (pass >= %d%%): %d/%d\n",
+           passPercent, agree, seeds);
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * enen-bench heatmap: decision-map cost per frame
+ *
+ * Times the two paths a frame can take through DecisionHeatmap:
+ * - miss: weights changed, so the whole grid is re-scored in one batched
+ *   forward and the text rows rebuilt
+ * - hit:  weights unchanged, the cached rows are copied into the frame
+ * Plus the same grid scored one decision at a time, for comparison.
+ *
+ * Options: --frames N (default 200)
+ */
+
+#include "bench.hpp"
+#include "heatmap.hpp"
+#include "layout.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+namespace {
+
+void runHeatmap(Backend backend, int frames) {
+    CompositionNet net(backend);
+    net.reset(1);
+    RNG rng(1);
+    for (int i = 0; i < 10; i++) {
+        auto t = CompositionTrial::generate(rng);
+        net.learn(t.lightInput(), t.sizeA, t.sizeB, t.correctIsA);
+    }
+
+    DecisionHeatmap heatmap;
+    TextBuffer buffer;
+    Samples missUs, hitUs, singleUs;
+    volatile bool sink = false;
+
+    for (int f = 0; f < frames; f++) {
+        int16_t light = (f & 1) ? 127 : 0;  // Alternate to force a re-score
+
+        Stopwatch sw;
+        heatmap.update(net, light);
+        heatmap.draw(buffer, layout::heatmap::X, layout::heatmap::Y);
+        missUs.add(sw.micros());
+
+        sw.restart();
+        heatmap.update(net, light);
+        heatmap.draw(buffer, layout::heatmap::X, layout::heatmap::Y);
+        hitUs.add(sw.micros());
+
+        sw.restart();
+        for (size_t r = 0; r < DecisionGrid::ROWS; r++) {
+            for (size_t c = 0; c < DecisionGrid::COLS; c++) {
+                sink = net.chooseA(light, DecisionGrid::xAt(c), DecisionGrid::yAt(r));
+            }
+        }
+        singleUs.add(sw.micros());
+    }
+    (void)sink;
+
+    printf("  %-8s miss %8.1f us (p99 %8.1f)  hit %6.2f us (p99 %6.2f)  unbatched %8.1f us\n",
+           backendName(backend), missUs.mean(), missUs.percentile(99),
+           hitUs.mean(), hitUs.percentile(99), singleUs.mean());
+}
+
+} // anonymous namespace
+
+int bench::runHeatmapBench(int argc, char** argv) {
+    int frames = 200;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench heatmap [--frames N]\n");
+            return 2;
+        }
+    }
+
+    printf("Decision Heatmap: %zux%zu grid (%zu cells), %d frames\n",
+           DecisionGrid::COLS, DecisionGrid::ROWS, DecisionGrid::CELLS, frames);
+    printf("=======================================================\n");
+    runHeatmap(Backend::INTEGER, frames);
+    runHeatmap(Backend::FLOAT, frames);
+    return 0;
+}
@@ -0,0 +1,191 @@
+/**
+ * enen-bench paired: two learner settings compared on common random numbers
+ *
+ * Each seed is run under both settings with GameState::seedPaired(seed):
+ * the same starting weights and, in every puzzle, the same trial stream.
+ * The per-seed differences (A - B) in trials to mastery and wall time
+ * (almost all of it learn()) then cancel what the seed itself decides -
+ * how kind the trial stream is, how lucky the weights - and only the
+ * setting is left. Reports the mean difference with a 95% confidence
+ * interval, next to the interval the same number of runs gives unpaired
+ * (B on a disjoint set of seeds, as separate sweeps used to be compared),
+ * and how many times more unpaired runs that interval would need.
+ *
+ * Settings: int, float or evolved (the backend), with ",seq" for the
+ * sequential (SPRT) Composition gauntlet. A run that does not master a
+ * puzzle counts as --max-trials trials.
+ *
+ * Options:
+ *   --a SETTING      first setting (default int)
+ *   --b SETTING      second setting (default float)
+ *   --seeds N        pairs (default 20)
+ *   --max-trials N   per puzzle (default 500)
+ */
+
+#include "bench.hpp"
+#include "game.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+namespace {
+
+constexpr int ALL = NUM_PUZZLES;  // Row index of the whole demo
+
+struct Setting {
+    Backend backend = Backend::INTEGER;
+    GauntletState::Mode gauntlet = GauntletState::Mode::FIXED;
+    std::string name;
+};
+
+bool parseSetting(const char* text, Setting& out) {
+    std::string spec = text;
+    out.name = spec;
+    std::string backend = spec.substr(0, spec.find(','));
+    std::string rest = spec.size() > backend.size() ? spec.substr(backend.size() + 1) : "";
+    if (backend == "int") out.backend = Backend::INTEGER;
+    else if (backend == "float") out.backend = Backend::FLOAT;
+    else if (backend == "evolved") out.backend = Backend::EVOLVED;
+    else return false;
+    if (rest == "seq") out.gauntlet = GauntletState::Mode::SEQUENTIAL;
+    else if (!rest.empty()) return false;
+    return true;
+}
+
+// Trials and milliseconds per puzzle of one run (index ALL: the sum)
+struct Run {
+    double trials[NUM_PUZZLES + 1] = {};
+    double ms[NUM_PUZZLES + 1] = {};
+};
+
+Run runDemo(const Setting& setting, uint32_t seed, int maxTrials) {
+    Game game(seed, setting.backend);
+    game.state().gauntlet.mode = setting.gauntlet;
+    game.state().seedPaired(seed);
+
+    Run run;
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        Stopwatch sw;
+        int trials = game.runPuzzleToCompletion(maxTrials);
+        run.ms[p] = sw.seconds() * 1000.0;
+        run.trials[p] = trials > 0 ? trials : maxTrials;
+        run.trials[ALL] += run.trials[p];
+        run.ms[ALL] += run.ms[p];
+        game.nextPuzzle();
+    }
+    return run;
+}
+
+// Two-sided 95% Student t quantile
+double tQuantile(size_t df) {
+    static const double TABLE[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (df == 0) return 0.0;
+    if (df <= 30) return TABLE[df - 1];
+    return df <= 60 ? 2.000 : df <= 120 ? 1.980 : 1.960;
+}
+
+struct Comparison {
+    Samples a, b, unpairedB, diff;
+};
+
+void printComparison(const char* title, Comparison (&rows)[NUM_PUZZLES + 1], const char* unit) {
+    printf("\n%s, A - B (95%% CI)\n", title);
+    printf("  %-11s %9s %9s %22s %22s %9s\n", "Puzzle", "A", "B", "paired", "unpaired",
+           "runs x");
+    for (int p = 0; p <= NUM_PUZZLES; p++) {
+        Comparison& c = rows[p];
+        size_t n = c.diff.size();
+        double pairedHalf = tQuantile(n - 1) * std::sqrt(c.diff.variance() / n);
+        // Welch interval on n independent runs per side
+        double va = c.a.variance() / n;
+        double vb = c.unpairedB.variance() / n;
+        double df = (va + vb) > 0 ? (va + vb) * (va + vb) /
+                                        (va * va / (n - 1) + vb * vb / (n - 1)) : 1.0;
+        double unpairedHalf = tQuantile(static_cast<size_t>(df)) * std::sqrt(va + vb);
+        // Runs the unpaired design needs for the paired interval's width
+        double factor = c.diff.variance() > 0
+                            ? (c.a.variance() + c.unpairedB.variance()) / c.diff.variance() : 0.0;
+
+        char paired[32], unpaired[32];
+        std::snprintf(paired, sizeof(paired), "%+.1f +- %.1f%s", c.diff.mean(), pairedHalf,
+                      std::fabs(c.diff.mean()) > pairedHalf ? " *" : "  ");
+        std::snprintf(unpaired, sizeof(unpaired), "%+.1f +- %.1f%s",
+                      c.a.mean() - c.unpairedB.mean(), unpairedHalf,
+                      std::fabs(c.a.mean() - c.unpairedB.mean()) > unpairedHalf ? " *" : "  ");
+        printf("  %-11s %9.1f %9.1f %22s %22s ", p == ALL ? "All" : puzzleLabel(static_cast<PuzzleType>(p)), c.a.mean(),
+               c.b.mean(), paired, unpaired);
+        if (factor > 0) printf("%8.1fx\n", factor);
+        else printf("%9s\n", "-");
+    }
+    printf("  (%s; * = interval excludes 0)\n", unit);
+}
+
+} // anonymous namespace
+
+int bench::runPairedBench(int argc, char** argv) {
+    Setting a, b;
+    parseSetting("int", a);
+    parseSetting("float", b);
+    int seeds = 20;
+    int maxTrials = 500;
+
+    for (int i = 1; i < argc; i++) {
+        bool ok = true;
+        if (std::strcmp(argv[i], "--a") == 0 && i + 1 < argc) {
+            ok = parseSetting(argv[++i], a);
+        } else if (std::strcmp(argv[i], "--b") == 0 && i + 1 < argc) {
+            ok = parseSetting(argv[++i], b);
+        } else if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seeds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-trials") == 0 && i + 1 < argc) {
+            maxTrials = std::atoi(argv[++i]);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "Usage: enen-bench paired [--a SETTING] [--b SETTING] "
+                                 "[--seeds N] [--max-trials N]\n"
+                                 "  SETTING: int|float|evolved[,seq]\n");
+            return 2;
+        }
+    }
+    if (seeds < 2) seeds = 2;
+
+    printf("Paired comparison: A = %s, B = %s\n", a.name.c_str(), b.name.c_str());
+    printf("=====================================\n");
+    printf("Pairs: %d (same weights and trial stream per seed), max trials per puzzle: %d\n",
+           seeds, maxTrials);
+
+    Comparison trials[NUM_PUZZLES + 1], ms[NUM_PUZZLES + 1];
+    for (int s = 0; s < seeds; s++) {
+        uint32_t seed = 7000 + static_cast<uint32_t>(s);
+        Run ra = runDemo(a, seed, maxTrials);
+        Run rb = runDemo(b, seed, maxTrials);
+        Run rbUnpaired = runDemo(b, seed + static_cast<uint32_t>(seeds), maxTrials);
+        for (int p = 0; p <= NUM_PUZZLES; p++) {
+            trials[p].a.add(ra.trials[p]);
+            trials[p].b.add(rb.trials[p]);
+            trials[p].unpairedB.add(rbUnpaired.trials[p]);
+            trials[p].diff.add(ra.trials[p] - rb.trials[p]);
+            ms[p].a.add(ra.ms[p]);
+            ms[p].b.add(rb.ms[p]);
+            ms[p].unpairedB.add(rbUnpaired.ms[p]);
+            ms[p].diff.add(ra.ms[p] - rb.ms[p]);
+        }
+    }
+
+    printComparison("Trials to mastery", trials, "trials");
+    printComparison("Wall time", ms, "ms");
+    printf("\n  runs x: unpaired runs needed per paired run for the same interval width\n");
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * enen-bench pool: per-run setup, fresh Game vs pooled Game
+ *
+ * Runs the full demo for each seed twice: once on a newly constructed
+ * Game (what game_test and the sweep workers used to do per seed), and
+ * once on a Game taken from a GamePool, reinitialized in place with the
+ * networks and replay buffers of the previous run. Reports setup time and
+ * allocations per run for both, and the whole run time, so the setup cost
+ * can be compared with the work it precedes.
+ *
+ * Options:
+ *   --seeds N        seeds per side (default 20)
+ *   --max-trials N   per puzzle (default 500)
+ *   --float          run on the float32 reference backend
+ */
+
+#include "bench.hpp"
+#include "game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+namespace {
+
+struct Side {
+    Samples setupUs;
+    Samples setupAllocs;
+    Samples runMs;
+    Samples replayBytes;  // Replay capacity held when the run starts
+    int completed = 0;
+};
+
+size_t replayCapacity(const GameState& s) {
+    return s.gen_net.historyBytes() + s.feat_net.historyBytes() + s.xor_net.historyBytes() +
+           s.seq_net.historyBytes() + s.comp_net.historyBytes();
+}
+
+void record(Side& side, Game& game, double setupUs, uint64_t allocs, int maxTrials) {
+    side.setupUs.add(setupUs);
+    side.setupAllocs.add(static_cast<double>(allocs));
+    side.replayBytes.add(static_cast<double>(replayCapacity(game.state())));
+    Stopwatch sw;
+    if (game.runFullDemo(maxTrials)) side.completed++;
+    side.runMs.add(sw.seconds() * 1000.0);
+}
+
+void printSide(const char* name, Side& side, int seeds) {
+    printf("  %-7s %7d/%-3d %10.1f %10.1f %10.1f %12.0f %10.1f\n", name, side.completed, seeds,
+           side.setupUs.mean(), side.setupUs.percentile(99), side.setupAllocs.mean(),
+           side.replayBytes.mean(), side.runMs.mean());
+}
+
+} // anonymous namespace
+
+int bench::runPoolBench(int argc, char** argv) {
+    int seeds = 20;
+    int maxTrials = 500;
+    Backend backend = Backend::INTEGER;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            seeds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-trials") == 0 && i + 1 < argc) {
+            maxTrials = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--float") == 0) {
+            backend = Backend::FLOAT;
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench pool [--seeds N] [--max-trials N] [--float]\n");
+            return 2;
+        }
+    }
+
+    printf("Game Setup: fresh Game vs GamePool (%s)\n", backendName(backend));
+    printf("=======================================\n");
+    printf("Seeds: %d, max trials per puzzle: %d\n", seeds, maxTrials);
+
+    Side fresh, pooled;
+
+    for (int i = 0; i < seeds; i++) {
+        uint32_t seed = 9000 + static_cast<uint32_t>(i);
+        uint64_t allocs = allocationCount();
+        Stopwatch sw;
+        auto game = std::make_unique<Game>(seed, backend);
+        double us = sw.micros();
+        record(fresh, *game, us, allocationCount() - allocs, maxTrials);
+    }
+
+    // One warm game, as a sweep worker has after its first seed
+    GamePool pool(backend, 1);
+    for (int i = 0; i < seeds; i++) {
+        uint32_t seed = 9000 + static_cast<uint32_t>(i);
+        uint64_t allocs = allocationCount();
+        Stopwatch sw;
+        auto game = pool.acquire(seed);
+        double us = sw.micros();
+        record(pooled, *game, us, allocationCount() - allocs, maxTrials);
+        pool.release(std::move(game));
+    }
+
+    printf("\n  %-7s %11s %10s %10s %10s %12s %10s\n", "Setup", "completed", "us", "us p99",
+           "allocs", "replay B", "run ms");
+    printSide("fresh", fresh, seeds);
+    printSide("pooled", pooled, seeds);
+
+    double freshShare = fresh.runMs.total() > 0
+                            ? fresh.setupUs.total() / 1000.0 / fresh.runMs.total() * 100.0 : 0.0;
+    double pooledShare = pooled.runMs.total() > 0
+                             ? pooled.setupUs.total() / 1000.0 / pooled.runMs.total() * 100.0 : 0.0;
+    printf("\n  Setup share of run time: fresh %.2f%%, pooled %.2f%%\n", freshShare, pooledShare);
+    printf("  Setup speedup: %.1fx, allocations saved per run: %.1f\n",
+           pooled.setupUs.total() > 0 ? fresh.setupUs.total() / pooled.setupUs.total() : 0.0,
+           fresh.setupAllocs.mean() - pooled.setupAllocs.mean());
+    return 0;
+}
@@ -0,0 +1,508 @@
+/**
+ * enen-bench render: the presentation side, frame by frame
+ *
+ * Sections:
+ * - Formatting: the formatted text of a puzzle frame two ways - snprintf
+ *   into a stack buffer then putString (how the screens used to do it),
+ *   and text.hpp straight into the rows. Both must produce the same frame.
+ * - Screens: TextBuffer composition of every screen type (intros, each
+ *   renderPuzzleNTrial, victory, the brain diagram) from a simulated demo,
+ *   and the interactive Renderer::drawPuzzleN on the same trials
+ * - Output: FrameWriter encoding into a counting memory sink, and
+ *   Renderer::flush into the null device
+ * - Autorun: one cast end to end, split into simulation, composition and
+ *   encoding
+ * - Arena: a 16-creature arena frame (arena.hpp) after every tick of a
+ *   run, against the one millisecond budget per frame
+ * Each reports time and allocations per frame (global operator new).
+ *
+ * Options:
+ *   --frames N   formatting frames (default 20000)
+ *   --reps N     passes over the demo's frames per screen (default 50)
+ *   --seed N     demo seed (default 42)
+ */
+
+#include "arena.hpp"
+#include "autorun.hpp"
+#include "bench.hpp"
+#include "history.hpp"
+#include "renderer.hpp"
+#include "text.hpp"
+#include "trial_screens.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#define dup _dup
+#define dup2 _dup2
+#define close _close
+#define open _open
+#define NULL_DEVICE "NUL"
+#else
+#include <unistd.h>
+#define NULL_DEVICE "/dev/null"
+#endif
+
+using namespace enen;
+using bench::Stopwatch;
+
+namespace {
+
+struct Frame {
+    MushroomTrial trial;
+    bool choseA;
+    bool correct;
+    int trialNum;
+    int successes;
+};
+
+// A history entry as it was kept before the ring
+struct Entry {
+    int trialNum;
+    bool correct;
+    char summary[48];
+};
+
+void composeSnprintf(TextBuffer& buffer, const Frame& f, const Entry* entries, int count) {
+    char countBuf[16];
+    std::snprintf(countBuf, sizeof(countBuf), " %d/4", f.successes);
+    buffer.putString(layout::header::PROGRESS_COUNT_X, layout::header::PROGRESS_Y, countBuf);
+
+    char lineBuf[64];
+    std::snprintf(lineBuf, sizeof(lineBuf), "TRIAL %d:", f.trialNum);
+    buffer.putString(0, layout::trial::LABEL_Y, lineBuf);
+    std::snprintf(lineBuf, sizeof(lineBuf), "  [A] %s, size %d",
+                  MushroomTrial::colorName(f.trial.colorA), f.trial.sizeA);
+    buffer.putString(0, layout::trial::OPTION_A_Y, lineBuf);
+    std::snprintf(lineBuf, sizeof(lineBuf), "  [B] %s, size %d",
+                  MushroomTrial::colorName(f.trial.colorB), f.trial.sizeB);
+    buffer.putString(0, layout::trial::OPTION_B_Y, lineBuf);
+    bool aIsLarger = f.trial.sizeA > f.trial.sizeB;
+    std::snprintf(lineBuf, sizeof(lineBuf), "  Pick: %c (%s)",
+                  f.choseA ? 'A' : 'B', (f.choseA == aIsLarger) ? "larger" : "smaller");
+    buffer.putString(0, layout::trial::PICK_Y, lineBuf);
+
+    buffer.putString(0, layout::history::LABEL_Y, "HISTORY:");
+    for (int i = 0; i < count; i++) {
+        const Entry& e = entries[count - 1 - i];
+        char line[80];  // Whole line, then cut at 50 as before
+        std::snprintf(line, sizeof(line), "  Trial %d: %s %s",
+                      e.trialNum, e.correct ? "[OK]" : "[X]", e.summary);
+        if (std::strlen(line) > 50) line[50] = '\0';
+        buffer.putString(0, layout::history::LABEL_Y + 1 + i, line);
+    }
+}
+
+void composeText(TextBuffer& buffer, const Frame& f, const History& history) {
+    text::put(buffer, layout::header::PROGRESS_COUNT_X, layout::header::PROGRESS_Y,
+              ENEN_FORMAT(" {}/4"), f.successes);
+
+    text::put(buffer, 0, layout::trial::LABEL_Y, ENEN_FORMAT("TRIAL {}:"), f.trialNum);
+    text::put(buffer, 0, layout::trial::OPTION_A_Y, ENEN_FORMAT("  [A] {}, size {}"),
+              MushroomTrial::colorName(f.trial.colorA), f.trial.sizeA);
+    text::put(buffer, 0, layout::trial::OPTION_B_Y, ENEN_FORMAT("  [B] {}, size {}"),
+              MushroomTrial::colorName(f.trial.colorB), f.trial.sizeB);
+    bool aIsLarger = f.trial.sizeA > f.trial.sizeB;
+    text::put(buffer, 0, layout::trial::PICK_Y, ENEN_FORMAT("  Pick: {} ({})"),
+              f.choseA ? 'A' : 'B', (f.choseA == aIsLarger) ? "larger" : "smaller");
+
+    drawHistory(buffer, history, layout::history::LABEL_Y);
+}
+
+//=============================================================================
+// Formatting - snprintf lines vs text.hpp
+//=============================================================================
+void benchFormatting(int frames) {
+    // Trials and the history as it stands at each frame, built up front
+    RNG rng(1);
+    std::vector<Frame> trials;
+    std::vector<Entry> entries;
+    std::vector<History> histories;
+    History history;
+    for (int f = 0; f < frames; f++) {
+        Frame frame;
+        frame.trial = MushroomTrial::generate(rng);
+        frame.choseA = rng.next() % 2;
+        frame.correct = frame.choseA == frame.trial.correctIsA;
+        frame.trialNum = f + 1;
+        frame.successes = f % 5;
+        trials.push_back(frame);
+
+        Entry entry;
+        entry.trialNum = frame.trialNum;
+        entry.correct = frame.correct;
+        std::snprintf(entry.summary, sizeof(entry.summary), "%s(%d) vs %s(%d)",
+                      MushroomTrial::colorName(frame.trial.colorA), frame.trial.sizeA,
+                      MushroomTrial::colorName(frame.trial.colorB), frame.trial.sizeB);
+        entries.push_back(entry);
+        history.add(entry.trialNum, entry.correct, entry.summary);
+        histories.push_back(history);
+    }
+
+    auto window = [&](int f, int& count) {
+        count = std::min(f + 1, static_cast<int>(History::MAX_ENTRIES));
+        return &entries[f + 1 - count];
+    };
+
+    // Same frames either way
+    TextBuffer a, b;
+    int mismatches = 0;
+    for (int f = 0; f < frames; f++) {
+        int count;
+        const Entry* recent = window(f, count);
+        a.clear();
+        b.clear();
+        composeSnprintf(a, trials[f], recent, count);
+        composeText(b, trials[f], histories[f]);
+        for (int y = 0; y < terminal::HEIGHT; y++) {
+            if (std::memcmp(a.line(y), b.line(y), terminal::WIDTH) != 0) {
+                mismatches++;
+                break;
+            }
+        }
+    }
+
+    TextBuffer buffer;
+    Stopwatch sw;
+    for (int f = 0; f < frames; f++) {
+        int count;
+        const Entry* recent = window(f, count);
+        composeSnprintf(buffer, trials[f], recent, count);
+    }
+    double snprintfNs = sw.seconds() * 1e9 / frames;
+
+    sw.restart();
+    for (int f = 0; f < frames; f++) composeText(buffer, trials[f], histories[f]);
+    double textNs = sw.seconds() * 1e9 / frames;
+
+    printf("Formatting: the formatted lines of a puzzle 1 frame, %d frames\n", frames);
+    printf("  %-10s %10.0f ns/frame\n", "snprintf", snprintfNs);
+    printf("  %-10s %10.0f ns/frame  (%.1fx)\n", "text", textNs,
+           textNs > 0 ? snprintfNs / textNs : 0.0);
+    printf("  Output: %s\n\n", mismatches == 0 ? "identical" : "DIFFERS");
+}
+
+//=============================================================================
+// Screens - Composition per screen type
+//=============================================================================
+struct Cost {
+    double ns = 0.0;      // Per frame
+    double allocs = 0.0;  // Per frame
+};
+
+// Call draw(i) for i in [0, count), `reps` times over
+template <class Draw>
+Cost measure(size_t count, int reps, Draw draw) {
+    uint64_t allocs = bench::allocationCount();
+    Stopwatch sw;
+    for (int r = 0; r < reps; r++) {
+        for (size_t i = 0; i < count; i++) draw(i);
+    }
+    double frames = static_cast<double>(count) * reps;
+    return {sw.seconds() * 1e9 / frames, (bench::allocationCount() - allocs) / frames};
+}
+
+void printCost(const char* label, size_t frames, const Cost& cost) {
+    printf("  %-22s %6zu %12.0f %12.0f %10.2f\n", label, frames, cost.ns,
+           cost.ns > 0 ? 1e9 / cost.ns : 0.0, cost.allocs);
+}
+
+void printCostHeader() {
+    printf("  %-22s %6s %12s %12s %10s\n", "", "frames", "ns/frame", "frames/s", "allocs");
+}
+
+const char* screenLabel(const FrameRecord& frame) {
+    switch (frame.screen) {
+        case FrameRecord::Screen::INTRO_1: return "intro 1";
+        case FrameRecord::Screen::INTRO_2: return "intro 2";
+        case FrameRecord::Screen::PUZZLE_INTRO: return "puzzle intro";
+        case FrameRecord::Screen::VICTORY: return "victory";
+        case FrameRecord::Screen::TRIAL: break;
+    }
+    switch (frame.puzzle) {
+        case PuzzleType::GENERALIZATION: return "renderPuzzle1Trial";
+        case PuzzleType::FEATURE_SELECTION: return "renderPuzzle2Trial";
+        case PuzzleType::XOR_CONTEXT: return "renderPuzzle3Trial";
+        case PuzzleType::SEQUENCE: return "renderPuzzle4Trial";
+        case PuzzleType::COMPOSITION: return "renderPuzzle5Trial";
+    }
+    return "?";
+}
+
+const PuzzleType PUZZLES[] = {
+    PuzzleType::GENERALIZATION, PuzzleType::FEATURE_SELECTION, PuzzleType::XOR_CONTEXT,
+    PuzzleType::SEQUENCE, PuzzleType::COMPOSITION,
+};
+
+void benchScreens(const FrameLog& log, int reps) {
+    printf("Screens: TextBuffer composition, %d passes over the demo's frames\n", reps);
+    printCostHeader();
+
+    // Frames grouped by screen, in order of first appearance
+    std::vector<const char*> labels;
+    std::vector<std::vector<const FrameRecord*>> groups;
+    for (const auto& frame : log) {
+        const char* label = screenLabel(frame);
+        auto it = std::find(labels.begin(), labels.end(), label);
+        if (it == labels.end()) {
+            labels.push_back(label);
+            groups.emplace_back();
+            it = labels.end() - 1;
+        }
+        groups[it - labels.begin()].push_back(&frame);
+    }
+
+    TextBuffer buffer;
+    for (size_t g = 0; g < groups.size(); g++) {
+        const auto& group = groups[g];
+        printCost(labels[g], group.size(),
+                  measure(group.size(), reps, [&](size_t i) { renderFrame(buffer, *group[i]); }));
+    }
+
+    // The diagram on its own, one per puzzle, with the trace lit
+    const ForwardTrace* trace = nullptr;
+    for (const auto& frame : log) {
+        if (frame.screen == FrameRecord::Screen::TRIAL && frame.trace.valid()) {
+            trace = &frame.trace;
+            break;
+        }
+    }
+    printCost("drawBrainDiagram", 5, measure(5, reps, [&](size_t i) {
+        drawBrainDiagram(buffer, layout::brain::X, layout::brain::Y, PUZZLES[i], 1234, trace);
+    }));
+
+    printCost("all frames", log.size(),
+              measure(log.size(), reps, [&](size_t i) { renderFrame(buffer, log[i]); }));
+    printf("\n");
+}
+
+//=============================================================================
+// Output - FrameWriter into memory, Renderer into the null device
+//=============================================================================
+
+// Counts what it is given, keeps nothing
+class CountingSink : public CastSink {
+public:
+    using CastSink::write;
+    void write(const char*, size_t size) override { bytes += size; }
+    uint64_t bytes = 0;
+};
+
+// Points stdout at the null device while in scope
+class NullStdout {
+public:
+    NullStdout() {
+        std::fflush(stdout);
+        saved_ = dup(1);
+        int null = open(NULL_DEVICE, O_WRONLY);
+        dup2(null, 1);
+        close(null);
+    }
+    ~NullStdout() {
+        std::fflush(stdout);
+        dup2(saved_, 1);
+        close(saved_);
+    }
+
+private:
+    int saved_;
+};
+
+// Renderer::drawPuzzleN for a recorded trial (frames held, not printed)
+void drawWithRenderer(Renderer& renderer, const FrameRecord& frame, GeneralizationNet& genNet,
+                      FeatureSelectionNet& featNet, XORNet& xorNet, SequenceNet& seqNet,
+                      CompositionNet& compNet) {
+    switch (frame.puzzle) {
+        case PuzzleType::GENERALIZATION:
+            renderer.drawPuzzle1(frame.mushroom, genNet, frame.choice, frame.correct, frame.history,
+                                 frame.trialNum, frame.successes, 4, frame.complete);
+            break;
+        case PuzzleType::FEATURE_SELECTION:
+            renderer.drawPuzzle2(frame.shape, featNet, frame.choice, frame.correct, frame.history,
+                                 frame.trialNum, frame.successes, 4, frame.complete);
+            break;
+        case PuzzleType::XOR_CONTEXT:
+            renderer.drawPuzzle3(frame.xorTrial, xorNet, frame.choice, frame.correct, frame.history,
+                                 frame.trialNum, frame.successes, 4, frame.complete);
+            break;
+        case PuzzleType::SEQUENCE: {
+            SequencePuzzle puzzle;
+            if (frame.inProgress) puzzle.pressButton(0);
+            renderer.drawPuzzle4(puzzle, seqNet, frame.history, frame.trialNum, frame.successes, 4,
+                                 frame.complete);
+            break;
+        }
+        case PuzzleType::COMPOSITION:
+            renderer.drawPuzzle5(frame.composition, compNet, frame.choice, frame.correct,
+                                 frame.history, frame.gauntlet, frame.complete);
+            break;
+    }
+}
+
+void benchOutput(const FrameLog& log, int reps) {
+    // Composed once; only the output path is timed
+    std::vector<TextBuffer> buffers(log.size());
+    for (size_t i = 0; i < log.size(); i++) renderFrame(buffers[i], log[i]);
+
+    CountingSink sink;
+    FrameWriter writer(&sink);
+    Cost encode = measure(log.size(), reps, [&](size_t i) {
+        writer.outputFrame(buffers[i], log[i].pause);
+    });
+    double castBytes = static_cast<double>(sink.bytes) / (log.size() * reps);
+
+    // Renderer: compose the trial frames, then write each to the terminal
+    std::vector<const FrameRecord*> trials;
+    for (const auto& frame : log) {
+        if (frame.screen == FrameRecord::Screen::TRIAL) trials.push_back(&frame);
+    }
+    GeneralizationNet genNet;
+    FeatureSelectionNet featNet;
+    XORNet xorNet;
+    SequenceNet seqNet;
+    CompositionNet compNet;
+    Cost compose, flush;
+    {
+        NullStdout quiet;
+        Renderer renderer;
+        renderer.holdFrames(true);
+        compose = measure(trials.size(), reps, [&](size_t i) {
+            drawWithRenderer(renderer, *trials[i], genNet, featNet, xorNet, seqNet, compNet);
+        });
+        renderer.holdFrames(false);
+        flush = measure(trials.size(), reps, [&](size_t) { renderer.flush(); });
+    }
+    // Home cursor, then each row and its newline
+    double terminalBytes = 3 + terminal::HEIGHT * (terminal::WIDTH + 1);
+
+    printf("Output: %d passes\n", reps);
+    printf("  %-22s %6s %12s %12s %10s %10s\n", "", "frames", "ns/frame", "frames/s", "allocs",
+           "bytes");
+    printf("  %-22s %6zu %12.0f %12.0f %10.2f %10.0f\n", "FrameWriter (memory)", log.size(),
+           encode.ns, encode.ns > 0 ? 1e9 / encode.ns : 0.0, encode.allocs, castBytes);
+    printf("  %-22s %6zu %12.0f %12.0f %10.2f %10s\n", "Renderer::drawPuzzleN", trials.size(),
+           compose.ns, compose.ns > 0 ? 1e9 / compose.ns : 0.0, compose.allocs, "-");
+    printf("  %-22s %6zu %12.0f %12.0f %10.2f %10.0f\n", "Renderer::flush (null)", trials.size(),
+           flush.ns, flush.ns > 0 ? 1e9 / flush.ns : 0.0, flush.allocs, terminalBytes);
+    printf("\n");
+}
+
+//=============================================================================
+// Autorun - One cast end to end, single thread
+//=============================================================================
+void benchAutorun(uint32_t seed) {
+    uint64_t allocs = bench::allocationCount();
+    Stopwatch sw;
+    FrameLog log = simulateDemo(seed);
+    double simulateMs = sw.seconds() * 1000.0;
+    uint64_t simulateAllocs = bench::allocationCount() - allocs;
+
+    std::vector<double> times = frameTimes(log);
+    TextBuffer buffer;
+    std::string cast;
+    double composeMs = 0.0, encodeMs = 0.0;
+    uint64_t composeAllocs = 0, encodeAllocs = 0;
+    for (size_t i = 0; i < log.size(); i++) {
+        allocs = bench::allocationCount();
+        sw.restart();
+        renderFrame(buffer, log[i]);
+        composeMs += sw.seconds() * 1000.0;
+        composeAllocs += bench::allocationCount() - allocs;
+
+        allocs = bench::allocationCount();
+        sw.restart();
+        FrameWriter::appendFrame(cast, buffer, times[i], i == 0);
+        encodeMs += sw.seconds() * 1000.0;
+        encodeAllocs += bench::allocationCount() - allocs;
+    }
+
+    double totalMs = simulateMs + composeMs + encodeMs;
+    double frames = static_cast<double>(log.size());
+    auto row = [&](const char* label, double ms, uint64_t allocCount) {
+        printf("  %-22s %10.2f ms %6.1f%% %10.2f\n", label, ms,
+               totalMs > 0 ? 100.0 * ms / totalMs : 0.0, allocCount / frames);
+    };
+
+    printf("Autorun: seed %u, %zu frames, %zu cast bytes (%.0f/frame)\n", seed, log.size(),
+           cast.size(), cast.size() / frames);
+    printf("  %-22s %13s %7s %10s\n", "", "time", "share", "allocs");
+    row("simulation", simulateMs, simulateAllocs);
+    row("composition", composeMs, composeAllocs);
+    row("encoding", encodeMs, encodeAllocs);
+    printf("  %-22s %10.2f ms  %.0f frames/s\n", "total", totalMs,
+           totalMs > 0 ? frames / (totalMs / 1000.0) : 0.0);
+}
+
+//=============================================================================
+// Arena - 16 tiles per frame, every tick of one run
+//=============================================================================
+void benchArena(uint32_t seed, int reps) {
+    ArenaConfig config;
+    config.baseSeed = seed;
+    config.puzzle = PuzzleType::COMPOSITION;  // The busiest tiles
+    Arena arena(config);
+
+    bench::Samples renderNs, tickMs;
+    double allocs = 0.0;
+    TextBuffer buffer;
+    std::string cast;
+    while (true) {
+        Cost cost = measure(1, reps, [&](size_t) { arena.render(buffer); });
+        renderNs.add(cost.ns);
+        allocs += cost.allocs;
+        FrameWriter::appendFrame(cast, buffer, arena.ticks() * timing::ARENA_TICK,
+                                 arena.ticks() == 0);
+
+        Stopwatch sw;
+        if (!arena.tick()) break;
+        tickMs.add(sw.seconds() * 1000.0);
+    }
+
+    double frames = static_cast<double>(renderNs.size());
+    printf("Arena: %d creatures, composition, %zu frames, %zu cast bytes (%.0f/frame)\n",
+           arena.creatureCount(), renderNs.size(), cast.size(), cast.size() / frames);
+    printf("  %-22s %10.0f ns mean %10.0f ns p99 %10.0f ns max %8.2f allocs\n", "render",
+           renderNs.mean(), renderNs.percentile(99), renderNs.percentile(100), allocs / frames);
+    printf("  %-22s %10.2f ms mean %10.2f ms p99\n", "tick (16 trials)", tickMs.mean(),
+           tickMs.percentile(99));
+    printf("  Render budget 1 ms/frame: %s (worst frame %.1f%% of it)\n",
+           renderNs.percentile(100) < 1e6 ? "met" : "MISSED", renderNs.percentile(100) / 1e4);
+}
+
+} // anonymous namespace
+
+int bench::runRenderBench(int argc, char** argv) {
+    int frames = 20000;
+    int reps = 50;
+    uint32_t seed = 42;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            reps = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench render [--frames N] [--reps N] [--seed N]\n");
+            return 2;
+        }
+    }
+
+    printf("Rendering: composition, output and encoding per frame\n");
+    printf("=====================================================\n");
+    benchFormatting(frames);
+
+    FrameLog log = simulateDemo(seed);
+    benchScreens(log, reps);
+    benchOutput(log, reps);
+    benchAutorun(seed);
+    printf("\n");
+    benchArena(seed, reps);
+    return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * enen-bench replay: captured workloads against the engine
+ *
+ * Replays workload files (enen --capture FILE, or Game::setCapture) on
+ * fresh networks: each record is decided and learned exactly as the game
+ * did it. Without files, one full Game session is captured first and
+ * replayed, so the mode always has something to run.
+ *
+ * Speeds:
+ *   max        back to back; latency = service time
+ *   recorded   each trial starts at its recorded offset; latency counts
+ *              from that scheduled start, so time spent behind schedule
+ *              is included (no coordinated omission)
+ *   X          recorded gaps divided by X (2 = twice as fast)
+ *
+ * Options:
+ *   --speed S      max | recorded | X (default max)
+ *   --repeat N     replay the workload N times (default 1)
+ *   --seed S       network seed, and the Game seed when capturing (default 7)
+ *   --float        run on the float32 reference backend
+ *   --save FILE    write the self-captured workload to FILE
+ */
+
+#include "bench.hpp"
+#include "game.hpp"
+#include "workload.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace enen;
+using bench::Samples;
+using bench::Stopwatch;
+
+namespace {
+
+std::vector<workload::Record> captureSession(uint32_t seed, Backend backend) {
+    workload::Capture capture;
+    Game game(seed, backend);
+    game.setCapture(&capture);
+    game.runFullDemo(500);
+    return capture.records();
+}
+
+void printRow(const char* name, Samples& s) {
+    printf("%-14s %7zu %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", name, s.size(), s.mean(),
+           s.percentile(50), s.percentile(90), s.percentile(99), s.percentile(99.9),
+           s.percentile(100));
+}
+
+} // anonymous namespace
+
+int bench::runReplayBench(int argc, char** argv) {
+    std::vector<const char*> files;
+    double speed = 0.0;  // 0 = max
+    int repeat = 1;
+    uint32_t seed = 7;
+    Backend backend = Backend::INTEGER;
+    const char* savePath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            const char* s = argv[++i];
+            if (std::strcmp(s, "max") == 0) speed = 0.0;
+            else if (std::strcmp(s, "recorded") == 0) speed = 1.0;
+            else speed = std::atof(s);
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--float") == 0) {
+            backend = Backend::FLOAT;
+        } else if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (argv[i][0] != '-') {
+            files.push_back(argv[i]);
+        } else {
+            std::fprintf(stderr, "Usage: enen-bench replay [FILE...] [--speed max|recorded|X] "
+                                 "[--repeat N] [--seed S] [--float] [--save FILE]\n");
+            return 2;
+        }
+    }
+    if (repeat < 1) repeat = 1;
+    if (speed < 0.0) speed = 0.0;
+
+    std::vector<workload::Record> records;
+    if (files.empty()) {
+        records = captureSession(seed, backend);
+        printf("Workload: captured one Game session (seed %u)\n", seed);
+        if (savePath && !workload::save(savePath, records)) {
+            std::fprintf(stderr, "Could not write %s\n", savePath);
+            return 1;
+        }
+    } else {
+        for (const char* file : files) {
+            if (!workload::load(file, records)) {
+                std::fprintf(stderr, "Not a workload file (or truncated): %s\n", file);
+                return 1;
+            }
+        }
+        printf("Workload: %zu file%s\n", files.size(), files.size() == 1 ? "" : "s");
+    }
+
+    uint64_t recordedMicros = 0;
+    int sessions = 0;
+    for (const auto& r : records) {
+        recordedMicros += r.gapMicros;
+        if (r.flags & workload::SESSION_START) sessions++;
+    }
+    printf("Trials: %zu in %d session%s, %.1f ms as recorded (%zu bytes on disk)\n", records.size(),
+           sessions, sessions == 1 ? "" : "s", recordedMicros / 1e3,
+           workload::HEADER_SIZE + records.size() * workload::RECORD_SIZE);
+    char speedName[32];
+    if (speed == 0.0) std::snprintf(speedName, sizeof(speedName), "max");
+    else if (speed == 1.0) std::snprintf(speedName, sizeof(speedName), "recorded");
+    else std::snprintf(speedName, sizeof(speedName), "%gx recorded", speed);
+    printf("Speed: %s, backend: %s, repeat: %d\n\n", speedName, backendName(backend), repeat);
+    if (records.empty()) return 0;
+
+    using Clock = std::chrono::steady_clock;
+    Samples latency[NUM_PUZZLES];
+    Samples all;
+    Samples service;
+    double maxBehind = 0.0;
+    int agreed = 0;
+
+    Stopwatch wall;
+    for (int rep = 0; rep < repeat; rep++) {
+        workload::Replayer replayer(seed, backend);
+        Clock::time_point scheduled = Clock::now();
+        for (const auto& r : records) {
+            if (speed > 0.0) {
+                scheduled += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double, std::micro>(r.gapMicros / speed));
+                std::this_thread::sleep_until(scheduled);
+            }
+            Clock::time_point start = Clock::now();
+            if (speed == 0.0) scheduled = start;
+            if (replayer.apply(r)) agreed++;
+            Clock::time_point done = Clock::now();
+
+            double us = std::chrono::duration<double, std::micro>(done - scheduled).count();
+            double serviceUs = std::chrono::duration<double, std::micro>(done - start).count();
+            latency[r.puzzle].add(us);
+            all.add(us);
+            service.add(serviceUs);
+            if (us - serviceUs > maxBehind) maxBehind = us - serviceUs;
+        }
+    }
+    double seconds = wall.seconds();
+
+    printf("Latency per trial (us)%s\n", speed > 0.0 ? ", from scheduled start" : "");
+    printf("%-14s %7s %9s %9s %9s %9s %9s %9s\n", "Puzzle", "trials", "mean", "p50", "p90",
+           "p99", "p99.9", "max");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        if (latency[p].size() > 0) printRow(puzzleLabel(static_cast<PuzzleType>(p)), latency[p]);
+    }
+    printRow("All", all);
+    if (speed > 0.0) {
+        printRow("(service)", service);
+        printf("\nMost behind schedule: %.1f us\n", maxBehind);
+    }
+
+    printf("\nThroughput: %.0f trials/s over %.2f s\n", all.size() / seconds, seconds);
+    printf("Decisions matching the recorded answer: %.1f%%\n", 100.0 * agreed / all.size());
+    return 0;
+}
@@ -1,40 +1,65 @@
 /**
  * Debug test to trace puzzle failures
+ *
+ * Prints what the network saw and how it responded on every trial, using
+ * the wrappers' introspection API (lastForward, layerWeights).
+ *
+ * Usage:
+ *   ./enen-debug-test           # IntgrNN: inputs and outputs
+ *   ./enen-debug-test --float   # float32 reference: also hidden units and weights
  */
 
 #include "game.hpp"
+#include "brain_diagram.hpp"
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 
 using namespace enen;
 
-void debugPuzzle2() {
+// How much the first layer listens to each input: sum of |w| over hidden units
+float inputAttention(const IntgrNNWrapper& net, size_t input) {
+    LayerWeights w;
+    if (!net.layerWeights(0, w) || input >= w.inputs) return -1.0f;
+    float sum = 0.0f;
+    for (size_t j = 0; j < w.outputs; j++) sum += std::fabs(w.at(j, input));
+    return sum;
+}
+
+// Activity line from the brain diagram, without the box borders
+const char* activity(const IntgrNNWrapper& net) {
+    static char line[42];
+    if (!net.lastForward().valid()) return "(no forward yet)";
+    formatActivityLine(line, net.lastForward());
+    line[40] = '\0';
+    return line + 2;
+}
+
+void debugPuzzle2(Backend backend) {
     printf("\n=== Debug Puzzle 2 (Feature Selection) ===\n");
 
-    Game game(54321);  // Different seed
+    Game game(54321, backend);  // Different seed
     game.nextPuzzle();  // Skip to puzzle 2
 
     auto& s = game.state();
 
     for (int i = 0; i < 50; i++) {
-        // Get current weights and trial data before decision
-        int w_color = s.feat_net.colorAttention();
-        int w_shape = s.feat_net.shapeAttention();
-
-        // Store weights for score calculation
-        int16_t wc = s.feat_net.w_color;
-        int16_t ws = s.feat_net.w_shape;
-
         bool completed = game.runTrial();
 
-        // After trial, show trial data
-        auto& t = s.current_shape;
-        int16_t scoreA = (wc * t.colorA + ws * t.shapeA) / 128;
-        int16_t scoreB = (wc * t.colorB + ws * t.shapeB) / 128;
+        // Attention after learning: color inputs are 0 and 2, shape 1 and 3
+        float color = inputAttention(s.feat_net, 0) + inputAttention(s.feat_net, 2);
+        float shape = inputAttention(s.feat_net, 1) + inputAttention(s.feat_net, 3);
 
-        printf("Trial %2d: colA=%3d colB=%3d shpA=%3d shpB=%3d | scA=%4d scB=%4d | correct=%c fail=%d succ=%d %s\n",
-               i+1, t.colorA, t.colorB, t.shapeA, t.shapeB,
-               scoreA, scoreB,
-               t.correctIsA ? 'A' : 'B',
+        auto& t = s.current_shape;
+        const auto& trace = s.feat_net.lastForward();
+        int out = trace.valid() ? trace.units[trace.outputLayer()][0] : -1;  // -1: no forward
+        printf("Trial %2d: colA=%3d colB=%3d shpA=%3d shpB=%3d | out=%3d correct=%c | %s",
+               i+1, t.colorA, t.colorB, t.shapeA, t.shapeB, out,
+               t.correctIsA ? 'A' : 'B', activity(s.feat_net));
+        if (color >= 0) {
+            printf(" | attn color=%.2f shape=%.2f", color, shape);
+        }
+        printf(" | fail=%d succ=%d %s\n",
                s.validator.failures, s.validator.successes,
                completed ? "DONE!" : "");
 
@@ -42,10 +67,10 @@ void debugPuzzle2() {
     }
 }
 
-void debugPuzzle4() {
+void debugPuzzle4(Backend backend) {
     printf("\n=== Debug Puzzle 4 (Sequence) ===\n");
 
-    Game game(12345);
+    Game game(12345, backend);
     game.nextPuzzle();  // Skip to puzzle 2
     game.nextPuzzle();  // Skip to puzzle 3
     game.nextPuzzle();  // Skip to puzzle 4
@@ -59,10 +84,8 @@ void debugPuzzle4() {
 
         bool completed = game.runTrial();
 
-        printf("Trial %2d: last=%3d scoreA=%4d scoreB=%4d | wA=%4d wB=%4d bA=%4d bB=%4d | fail=%d succ=%d %s\n",
-               i+1, last, scoreA, scoreB,
-               s.seq_net.wA_last, s.seq_net.wB_last,
-               s.seq_net.bA, s.seq_net.bB,
+        printf("Trial %2d: last=%3d scoreA=%4d scoreB=%4d | %s | fail=%d succ=%d %s\n",
+               i+1, last, scoreA, scoreB, activity(s.seq_net),
                s.validator.failures, s.validator.successes,
                completed ? "DONE!" : "");
 
@@ -70,10 +93,10 @@ void debugPuzzle4() {
     }
 }
 
-void debugPuzzle5() {
+void debugPuzzle5(Backend backend) {
     printf("\n=== Debug Puzzle 5 (Composition) ===\n");
 
-    Game game(1768016321);  // A seed that failed
+    Game game(1768016321, backend);  // A seed that failed
     for (int i = 0; i < 4; i++) game.nextPuzzle();  // Skip to puzzle 5
 
     auto& s = game.state();
@@ -82,21 +105,28 @@ void debugPuzzle5() {
         bool completed = game.runTrial();
 
         auto& t = s.current_composition;
-        printf("Trial %2d: light=%s sA=%3d sB=%3d correct=%c | fail=%d succ=%d (need %d) %s\n",
+        printf("Trial %2d: light=%s sA=%3d sB=%3d correct=%c | %s | warmup=%d scored=%d correct=%d %s\n",
                i+1, t.lightOn ? "ON " : "OFF",
                t.sizeA, t.sizeB,
                t.correctIsA ? 'A' : 'B',
-               s.validator.failures, s.validator.successes,
-               s.validator.requiredSuccesses(),
+               activity(s.comp_net),
+               s.gauntlet.warmup_completed, s.gauntlet.scored_completed,
+               s.gauntlet.correct,
                completed ? "DONE!" : "");
 
         if (completed) break;
     }
 }
 
-int main() {
-    debugPuzzle2();
-    debugPuzzle4();
-    debugPuzzle5();
+int main(int argc, char** argv) {
+    Backend backend = Backend::INTEGER;
+    if (argc > 1 && std::strcmp(argv[1], "--float") == 0) {
+        backend = Backend::FLOAT;
+    }
+    printf("Backend: %s\n", backendName(backend));
+
+    debugPuzzle2(backend);
+    debugPuzzle4(backend);
+    debugPuzzle5(backend);
     return 0;
 }
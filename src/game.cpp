@@ -3,11 +3,53 @@
  */
 
 #include "game.hpp"
+#include "metrics.hpp"
+#include "workload.hpp"
+#include <chrono>
 #include <cstdio>
+#include <memory>
+#include <thread>
+#include <utility>
 
 namespace enen {
 
-Game::Game(uint32_t seed) : state_(seed) {}
+namespace {
+
+// Exchange the network one puzzle trains between two game states
+void swapNetwork(PuzzleType type, GameState& a, GameState& b) {
+    switch (type) {
+        case PuzzleType::GENERALIZATION:
+            std::swap(a.gen_net, b.gen_net);
+            break;
+        case PuzzleType::FEATURE_SELECTION:
+            std::swap(a.feat_net, b.feat_net);
+            break;
+        case PuzzleType::XOR_CONTEXT:
+            std::swap(a.xor_net, b.xor_net);
+            break;
+        case PuzzleType::SEQUENCE:
+            std::swap(a.seq_net, b.seq_net);
+            break;
+        case PuzzleType::COMPOSITION:
+            std::swap(a.comp_net, b.comp_net);
+            break;
+    }
+}
+
+uint64_t nanosSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // anonymous namespace
+
+Game::Game(uint32_t seed, Backend backend) : state_(seed, backend) {}
+
+void Game::reinitialize(uint32_t seed) {
+    state_.reinitialize(seed);
+    results_ = {};
+    if (capture_) capture_->beginSession();
+}
 
 void Game::emit(EventType type, const std::string& msg, bool success) {
     if (callback_) {
@@ -16,6 +58,28 @@ void Game::emit(EventType type, const std::string& msg, bool success) {
 }
 
 bool Game::runTrial() {
+    if (!metrics_) return runCurrentTrial();
+
+    auto start = std::chrono::steady_clock::now();
+    PuzzleType puzzle = state_.current_puzzle;
+    bool complete = runCurrentTrial();
+    metrics_->recordTrial(nanosSince(start));
+    if (complete) metrics_->recordMastery(puzzle);
+    return complete;
+}
+
+template <class Learn>
+void Game::learnTimed(const IntgrNNWrapper& net, Learn learn) {
+    if (!metrics_) {
+        learn();
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    learn();
+    metrics_->recordLearn(nanosSince(start), net.historySize());
+}
+
+bool Game::runCurrentTrial() {
     switch (state_.current_puzzle) {
         case PuzzleType::GENERALIZATION:
             return runPuzzle1Trial();
@@ -31,9 +95,15 @@ bool Game::runTrial() {
     return false;
 }
 
+void Game::setCapture(workload::Capture* capture) {
+    capture_ = capture;
+    if (capture_) capture_->beginSession();
+}
+
 void Game::resetPuzzle() {
     state_.reset();
     state_.resetNetwork();
+    if (capture_) capture_->resetPuzzle();
     emit(EventType::TRIAL_START, "--- RESET ---");
 }
 
@@ -48,13 +118,23 @@ int Game::runPuzzleToCompletion(int maxTrials) {
             return i + 1;
         }
     }
+    if (metrics_) metrics_->recordGaveUp();
     return -1;  // Failed to complete
 }
 
+PuzzleResult Game::runTimedPuzzle(int maxTrials) {
+    auto start = std::chrono::steady_clock::now();
+    PuzzleResult result;
+    result.trials = runPuzzleToCompletion(maxTrials);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
 bool Game::runFullDemo(int maxTrialsPerPuzzle) {
+    results_.fill(PuzzleResult{});
     for (int p = 0; p < NUM_PUZZLES; p++) {
-        int trials = runPuzzleToCompletion(maxTrialsPerPuzzle);
-        if (trials < 0) {
+        results_[p] = runTimedPuzzle(maxTrialsPerPuzzle);
+        if (results_[p].trials < 0) {
             return false;  // Failed
         }
         if (p < NUM_PUZZLES - 1) {
@@ -65,6 +145,79 @@ bool Game::runFullDemo(int maxTrialsPerPuzzle) {
     return true;
 }
 
+bool Game::runFullDemoParallel(int maxTrialsPerPuzzle) {
+    // One worker Game per puzzle, each on its own RNG substream and
+    // holding this game's network for that puzzle while it trains
+    struct Lane {
+        std::unique_ptr<Game> game;
+        std::vector<GameEvent> events;
+    };
+    std::array<Lane, NUM_PUZZLES> lanes;
+
+    uint32_t base = state_.rng.next();
+    Backend backend = state_.gen_net.backend();
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        auto type = static_cast<PuzzleType>(p);
+        Lane& lane = lanes[p];
+        lane.game = std::make_unique<Game>(substreamSeed(base, p), backend);
+
+        GameState& ls = lane.game->state_;
+        ls.current_puzzle = type;
+        ls.gauntlet = state_.gauntlet;  // Keep mode and test configuration
+        swapNetwork(type, state_, ls);
+
+        if (callback_) {
+            auto* events = &lane.events;
+            lane.game->setEventCallback([events](const GameEvent& e) { events->push_back(e); });
+        }
+    }
+
+    results_.fill(PuzzleResult{});
+    std::vector<std::thread> workers;
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        workers.emplace_back([this, &lanes, p, maxTrialsPerPuzzle] {
+            results_[p] = lanes[p].game->runTimedPuzzle(maxTrialsPerPuzzle);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    // Merge: networks back, then each puzzle's final state and events in order
+    bool allCompleted = true;
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        auto type = static_cast<PuzzleType>(p);
+        GameState& ls = lanes[p].game->state_;
+        swapNetwork(type, state_, ls);
+        if (results_[p].trials < 0) allCompleted = false;
+
+        switch (type) {
+            case PuzzleType::GENERALIZATION:
+                state_.current_mushroom = ls.current_mushroom;
+                break;
+            case PuzzleType::FEATURE_SELECTION:
+                state_.current_shape = ls.current_shape;
+                break;
+            case PuzzleType::XOR_CONTEXT:
+                state_.current_xor = ls.current_xor;
+                break;
+            case PuzzleType::SEQUENCE:
+                state_.seq_puzzle = ls.seq_puzzle;
+                state_.validator = ls.validator;
+                break;
+            case PuzzleType::COMPOSITION:
+                state_.current_composition = ls.current_composition;
+                state_.gauntlet = ls.gauntlet;
+                state_.puzzle_complete = ls.puzzle_complete;
+                break;
+        }
+
+        for (const auto& e : lanes[p].events) emit(e.type, e.message, e.success);
+    }
+
+    state_.current_puzzle = PuzzleType::COMPOSITION;
+    state_.demo_complete = allCompleted;
+    return allCompleted;
+}
+
 //=============================================================================
 // Puzzle 1: Generalization
 //=============================================================================
@@ -75,6 +228,7 @@ bool Game::runPuzzle1Trial() {
     bool adversarial = s.validator.isFirstTrial();
     s.current_mushroom = MushroomTrial::generate(s.rng, adversarial);
     const auto& trial = s.current_mushroom;
+    if (capture_) capture_->add(trial);
 
     // enen makes a choice — honest evaluation
     bool choseA = s.gen_net.chooseA(trial.sizeA, trial.sizeB, trial.colorA, trial.colorB);
@@ -97,7 +251,9 @@ bool Game::runPuzzle1Trial() {
     }
 
     // Always learn - IntgrNN handles gradient computation
-    s.gen_net.learn(trial.sizeA, trial.sizeB, trial.colorA, trial.colorB, trial.correctIsA);
+    learnTimed(s.gen_net, [&] {
+        s.gen_net.learn(trial.sizeA, trial.sizeB, trial.colorA, trial.colorB, trial.correctIsA);
+    });
 
     // Record outcome and check for learning
     s.validator.recordOutcome(correct);
@@ -119,6 +275,7 @@ bool Game::runPuzzle2Trial() {
     bool adversarial = s.validator.isFirstTrial();
     s.current_shape = ShapeTrial::generate(s.rng, adversarial);
     const auto& trial = s.current_shape;
+    if (capture_) capture_->add(trial);
 
     // Honest evaluation
     bool choseA = s.feat_net.chooseA(trial.colorA, trial.shapeA, trial.colorB, trial.shapeB);
@@ -152,7 +309,9 @@ bool Game::runPuzzle2Trial() {
     }
 
     // Always learn
-    s.feat_net.learn(trial.colorA, trial.shapeA, trial.colorB, trial.shapeB, trial.correctIsA);
+    learnTimed(s.feat_net, [&] {
+        s.feat_net.learn(trial.colorA, trial.shapeA, trial.colorB, trial.shapeB, trial.correctIsA);
+    });
 
     s.validator.recordOutcome(correct);
     if (s.validator.hasLearned()) {
@@ -170,6 +329,7 @@ bool Game::runPuzzle3Trial() {
     auto& s = state_;
     s.current_xor = XORTrial::generate(s.rng);
     const auto& trial = s.current_xor;
+    if (capture_) capture_->add(trial);
 
     // enen predicts safety — honest evaluation
     bool predictedSafe = s.xor_net.isSafe(trial.lightInput(), trial.pathInput());
@@ -191,7 +351,9 @@ bool Game::runPuzzle3Trial() {
     }
 
     // Always learn
-    s.xor_net.learn(trial.lightInput(), trial.pathInput(), trial.isSafe);
+    learnTimed(s.xor_net, [&] {
+        s.xor_net.learn(trial.lightInput(), trial.pathInput(), trial.isSafe);
+    });
 
     s.validator.recordOutcome(correct);
     if (s.validator.hasLearned()) {
@@ -217,11 +379,12 @@ bool Game::runPuzzle4Trial() {
     emit(EventType::CHOICE_MADE, msg);
 
     s.seq_puzzle.pressButton(action);
+    if (capture_) capture_->addSequenceStep(last, action, !s.seq_puzzle.isFail());
 
     if (s.seq_puzzle.isSuccess()) {
         // Honest evaluation — if enen succeeded, it succeeded
         emit(EventType::OUTCOME, "SUCCESS! Door opens!", true);
-        s.seq_net.learnFromOutcome(last, action, true);
+        learnTimed(s.seq_net, [&] { s.seq_net.learnFromOutcome(last, action, true); });
         s.validator.recordOutcome(true);
         s.seq_puzzle.reset();
 
@@ -232,13 +395,13 @@ bool Game::runPuzzle4Trial() {
         }
     } else if (s.seq_puzzle.isFail()) {
         emit(EventType::OUTCOME, "FAIL! Wrong order!", false);
-        s.seq_net.learnFromOutcome(last, action, false);
+        learnTimed(s.seq_net, [&] { s.seq_net.learnFromOutcome(last, action, false); });
         s.validator.recordOutcome(false);
         s.seq_puzzle.reset();
     } else {
         // In progress (pressed A, now need B)
         emit(EventType::OUTCOME, "Good start — now press B", true);
-        s.seq_net.learnFromOutcome(last, action, true);
+        s.seq_net.addStep(last, action, true);  // Learned when the episode ends
     }
     return false;
 }
@@ -246,6 +409,7 @@ bool Game::runPuzzle4Trial() {
 //=============================================================================
 // Puzzle 5: Composition Gauntlet
 // 10 warmup trials (learning), then 20 scored trials
+// (fewer when gauntlet.mode is SEQUENTIAL and a phase settles early)
 //=============================================================================
 bool Game::runPuzzle5Trial() {
     auto& s = state_;
@@ -258,6 +422,7 @@ bool Game::runPuzzle5Trial() {
 
     s.current_composition = CompositionTrial::generate(s.rng);
     const auto& trial = s.current_composition;
+    if (capture_) capture_->add(trial);
 
     bool choseA = s.comp_net.chooseA(trial.lightInput(), trial.sizeA, trial.sizeB);
     bool correct = (choseA == trial.correctIsA);
@@ -270,7 +435,7 @@ bool Game::runPuzzle5Trial() {
                  trial.lightOn ? "ON" : "OFF", trial.sizeA, trial.sizeB);
     } else {
         snprintf(msg, sizeof(msg), "Scored %d/%d: Light %s, sizes %d vs %d",
-                 s.gauntlet.scored_completed + 1, GauntletState::SCORED_TRIALS,
+                 s.gauntlet.scored_completed + 1, s.gauntlet.scoredLimit(),
                  trial.lightOn ? "ON" : "OFF", trial.sizeA, trial.sizeB);
     }
     emit(EventType::TRIAL_START, msg);
@@ -280,7 +445,9 @@ bool Game::runPuzzle5Trial() {
     emit(EventType::OUTCOME, msg, correct);
 
     // Always learn (this is the key - training happens here)
-    s.comp_net.learn(trial.lightInput(), trial.sizeA, trial.sizeB, trial.correctIsA);
+    learnTimed(s.comp_net, [&] {
+        s.comp_net.learn(trial.lightInput(), trial.sizeA, trial.sizeB, trial.correctIsA);
+    });
 
     // Record in gauntlet
     s.gauntlet.recordOutcome(correct);
@@ -289,7 +456,7 @@ bool Game::runPuzzle5Trial() {
     if (s.gauntlet.isComplete()) {
         s.puzzle_complete = true;
         snprintf(msg, sizeof(msg), "GAUNTLET COMPLETE! Score: %d/%d (%d%%)",
-                 s.gauntlet.correct, GauntletState::SCORED_TRIALS,
+                 s.gauntlet.correct, s.gauntlet.scoredLimit(),
                  s.gauntlet.scorePercent());
         emit(EventType::PUZZLE_COMPLETE, msg);
         return true;
@@ -297,4 +464,43 @@ bool Game::runPuzzle5Trial() {
     return false;
 }
 
+//=============================================================================
+// GamePool
+//=============================================================================
+
+GamePool::GamePool(Backend backend, size_t preconstructed) : backend_(backend) {
+    free_.reserve(preconstructed);
+    for (size_t i = 0; i < preconstructed; i++) {
+        free_.push_back(std::make_unique<Game>(12345, backend));
+    }
+}
+
+std::unique_ptr<Game> GamePool::acquire(uint32_t seed) {
+    std::unique_ptr<Game> game;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (!free_.empty()) {
+            game = std::move(free_.back());
+            free_.pop_back();
+        }
+    }
+    if (!game) return std::make_unique<Game>(seed, backend_);
+    game->reinitialize(seed);
+    return game;
+}
+
+void GamePool::release(std::unique_ptr<Game> game) {
+    if (!game) return;
+    game->setEventCallback(nullptr);
+    game->setMetrics(nullptr);
+    game->setCapture(nullptr);
+    std::lock_guard<std::mutex> guard(lock_);
+    free_.push_back(std::move(game));
+}
+
+size_t GamePool::available() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return free_.size();
+}
+
 } // namespace enen
@@ -6,8 +6,13 @@
  */
 
 #include "game.hpp"
+#include "workload.hpp"
 #include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace enen;
 
@@ -34,10 +39,11 @@ TestResult testPuzzle(Game& game, const char* name, int puzzleNum) {
     return {trials, success};
 }
 
-bool runFullTest(uint32_t seed) {
+bool runFullTest(GamePool& pool, uint32_t seed) {
     printf("\n=== Testing with seed %u ===\n", seed);
 
-    Game game(seed);
+    auto handle = pool.acquire(seed);
+    Game& game = *handle;
     int totalTrials = 0;
     bool allPassed = true;
 
@@ -73,22 +79,227 @@ bool runFullTest(uint32_t seed) {
     printf("  Total trials: %d\n", totalTrials);
     printf("  Result: %s\n", allPassed ? "ALL PASSED" : "SOME FAILED");
 
+    pool.release(std::move(handle));
     return allPassed;
 }
 
-bool testFullDemo(uint32_t seed) {
+bool testFullDemo(GamePool& pool, uint32_t seed) {
     printf("\n=== Full Demo Test with seed %u ===\n", seed);
 
-    Game game(seed);
-    bool success = game.runFullDemo(MAX_TRIALS);
+    auto game = pool.acquire(seed);
+    bool success = game->runFullDemo(MAX_TRIALS);
 
     printf("  Full demo: %s\n", success ? "COMPLETED" : "FAILED");
     printf("  Demo complete flag: %s\n",
-           game.state().demo_complete ? "true" : "false");
+           game->state().demo_complete ? "true" : "false");
 
+    pool.release(std::move(game));
     return success;
 }
 
+// Parallel demo: completes, and the same seed and starting weights give the
+// same run regardless of thread timing (per-puzzle trials and event stream)
+bool testParallelDemo(uint32_t seed) {
+    printf("\n=== Parallel Demo Test with seed %u ===\n", seed);
+
+    std::vector<std::string> events[2];
+    int trials[2][NUM_PUZZLES];
+    bool success[2];
+    bool complete[2];
+    for (int run = 0; run < 2; run++) {
+        Game game(seed);
+        auto& s = game.state();
+        s.gen_net.reset(seed + 1);
+        s.feat_net.reset(seed + 2);
+        s.xor_net.reset(seed + 3);
+        s.seq_net.reset(seed + 4);
+        s.comp_net.reset(seed + 5);
+        game.setEventCallback([&events, run](const GameEvent& e) {
+            if (e.type == EventType::PUZZLE_COMPLETE) events[run].push_back(e.message);
+        });
+        success[run] = game.runFullDemoParallel(MAX_TRIALS);
+        complete[run] = s.demo_complete;
+        for (int p = 0; p < NUM_PUZZLES; p++) {
+            trials[run][p] = game.puzzleResult(static_cast<PuzzleType>(p)).trials;
+        }
+    }
+
+    bool same = events[0] == events[1];
+    printf("  Trials per puzzle:");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        printf(" %d", trials[0][p]);
+        if (trials[0][p] != trials[1][p]) same = false;
+    }
+    printf("\n");
+
+    bool pass = success[0] && complete[0] && same &&
+                events[0].size() == static_cast<size_t>(NUM_PUZZLES);
+    printf("  Parallel demo: %s, %zu puzzles reported, %s\n",
+           success[0] ? "COMPLETED" : "FAILED", events[0].size(),
+           same ? "reproducible" : "NOT reproducible");
+    return pass;
+}
+
+// Sequential gauntlet: scripted outcomes settle early, fixed mode never does
+bool testSequentialGauntlet() {
+    printf("\n=== Sequential Gauntlet Test ===\n");
+
+    GauntletState gauntlet;
+    gauntlet.mode = GauntletState::Mode::SEQUENTIAL;
+    gauntlet.reset();
+
+    // A streak of successes settles warmup, then scoring, as MASTERED
+    int trials = 0;
+    while (!gauntlet.isComplete() && trials < GauntletState::TOTAL_TRIALS) {
+        gauntlet.recordOutcome(true);
+        trials++;
+    }
+    bool mastered = gauntlet.verdict() == SequentialTest::Verdict::MASTERED &&
+                    trials < GauntletState::TOTAL_TRIALS &&
+                    gauntlet.scoredLimit() == gauntlet.scored_completed;
+    printf("  All correct: %d trials (warmup %d, scored %d) %s\n", trials,
+           gauntlet.warmup_completed, gauntlet.scored_completed, mastered ? "MASTERED" : "not settled");
+
+    // Failures in scoring settle FAILING; failures in warmup only restart its test
+    gauntlet.reset();
+    for (int i = 0; i < GauntletState::WARMUP_TRIALS; i++) gauntlet.recordOutcome(false);
+    bool warmupRan = !gauntlet.inWarmup() && gauntlet.warmup_completed == GauntletState::WARMUP_TRIALS;
+    while (!gauntlet.isComplete()) gauntlet.recordOutcome(false);
+    bool failing = gauntlet.verdict() == SequentialTest::Verdict::FAILING &&
+                   gauntlet.scored_completed < GauntletState::SCORED_TRIALS;
+    printf("  All wrong: warmup ran %d, scoring stopped after %d %s\n",
+           gauntlet.warmup_completed, gauntlet.scored_completed, failing ? "FAILING" : "not settled");
+
+    // Same outcomes in fixed mode run the full length
+    GauntletState fixed;
+    trials = 0;
+    while (!fixed.isComplete()) {
+        fixed.recordOutcome(true);
+        trials++;
+    }
+    bool fixedFull = trials == GauntletState::TOTAL_TRIALS;
+    printf("  Fixed mode: %d trials\n", trials);
+
+    // And a real gauntlet completes within the fixed bound
+    Game game(4242);
+    for (int p = 0; p < NUM_PUZZLES - 1; p++) game.nextPuzzle();
+    game.state().gauntlet.mode = GauntletState::Mode::SEQUENTIAL;
+    int gameTrials = game.runPuzzleToCompletion(GauntletState::TOTAL_TRIALS);
+    bool bounded = gameTrials > 0 && gameTrials <= GauntletState::TOTAL_TRIALS;
+    printf("  Game gauntlet: %d trials\n", gameTrials);
+
+    bool pass = mastered && warmupRan && failing && fixedFull && bounded;
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// Pooled game: after a full run, reinitialize(seed) matches Game(seed)
+// (puzzle, flags, RNG stream, empty replay) and keeps the network objects
+// and replay capacity
+bool testPoolReinitialize() {
+    printf("\n=== Game Pool Test ===\n");
+
+    GamePool pool(Backend::INTEGER, 1);
+    auto game = pool.acquire(1357);
+    bool ran = game->runFullDemo(MAX_TRIALS);
+    const Game* used = game.get();
+    const IntgrNNWrapper* net = &game->state().gen_net;
+    size_t capacity = game->state().gen_net.historyBytes();
+    pool.release(std::move(game));
+
+    game = pool.acquire(9753);
+    const GameState& s = game->state();
+    GameState fresh(9753);
+    RNG pooledRng = s.rng;
+    bool sameStream = true;
+    for (int i = 0; i < 100; i++) sameStream &= pooledRng.next() == fresh.rng.next();
+    bool reset = s.current_puzzle == PuzzleType::GENERALIZATION && !s.demo_complete &&
+                 !s.puzzle_complete && s.validator.total_trials == 0 &&
+                 s.gauntlet.scored_completed == 0 && s.gen_net.historySize() == 0 &&
+                 s.comp_net.historySize() == 0 && s.seq_puzzle.state == SequenceState::START;
+    bool reused = game.get() == used && &s.gen_net == net && s.gen_net.historyBytes() == capacity &&
+                  capacity > 0 && pool.available() == 0;
+    bool rerun = game->runFullDemo(MAX_TRIALS);
+    pool.release(std::move(game));
+
+    printf("  First run %s, rerun %s; replay capacity kept: %zu bytes\n",
+           ran ? "completed" : "FAILED", rerun ? "completed" : "FAILED", capacity);
+    bool pass = ran && sameStream && reset && reused && rerun;
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// Paired seeding: two games seeded alike make the same run, and a puzzle's
+// trials do not depend on how many the puzzles before it took
+bool testPairedSeeding() {
+    printf("\n=== Paired Seeding Test ===\n");
+
+    const uint32_t seed = 4242;
+    int trials[2][NUM_PUZZLES];
+    for (int run = 0; run < 2; run++) {
+        Game game(seed + run * 100);  // Game seed must not matter
+        game.state().seedPaired(seed);
+        for (int p = 0; p < NUM_PUZZLES; p++) {
+            trials[run][p] = game.runPuzzleToCompletion(MAX_TRIALS);
+            game.nextPuzzle();
+        }
+    }
+    bool same = true;
+    for (int p = 0; p < NUM_PUZZLES; p++) same &= trials[0][p] == trials[1][p];
+
+    // Puzzle 3 opens on its own stream, whatever came before
+    Game skipped(1);
+    skipped.state().seedPaired(seed);
+    skipped.nextPuzzle();
+    skipped.nextPuzzle();
+    RNG expected(substreamSeed(seed, static_cast<int>(PuzzleType::XOR_CONTEXT)));
+    bool ownStream = skipped.state().rng.next() == expected.next();
+
+    printf("  Trials per puzzle:");
+    for (int p = 0; p < NUM_PUZZLES; p++) printf(" %d/%d", trials[0][p], trials[1][p]);
+    printf("\n");
+    bool pass = same && ownStream;
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+// Workload capture: every trial recorded, file round trip, replay in order
+bool testCaptureReplay() {
+    printf("\n=== Workload Capture Test ===\n");
+
+    workload::Capture capture;
+    Game game(2468);
+    game.setCapture(&capture);
+    bool completed = game.runFullDemo(MAX_TRIALS);
+
+    int expected = 0;
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        expected += game.puzzleResult(static_cast<PuzzleType>(p)).trials;
+    }
+    const auto& records = capture.records();
+    bool counted = completed && static_cast<int>(records.size()) == expected &&
+                   (records.front().flags & workload::SESSION_START);
+
+    const char* path = "enen-game-test.enwl";
+    std::vector<workload::Record> loaded;
+    bool roundTrip = workload::save(path, records) && workload::load(path, loaded) &&
+                     loaded.size() == records.size();
+    for (size_t i = 0; roundTrip && i < loaded.size(); i++) {
+        roundTrip = std::memcmp(&loaded[i], &records[i], sizeof(workload::Record)) == 0;
+    }
+    std::remove(path);
+
+    workload::Replayer replayer(2468);
+    int agreed = 0;
+    for (const auto& r : loaded) agreed += replayer.apply(r);
+
+    printf("  %zu records, %s, replay agreed on %d\n", records.size(),
+           roundTrip ? "file round trip exact" : "file round trip FAILED", agreed);
+    bool pass = counted && roundTrip && agreed > 0;
+    printf("  Result: %s\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
 int main() {
     printf("Game Logic Test\n");
     printf("================\n");
@@ -98,10 +309,13 @@ int main() {
     int passedRuns = 0;
     int failedRuns = 0;
 
+    // One game reused for every seed (reinitialized in place between runs)
+    GamePool pool;
+
     // Test with multiple seeds
     for (int i = 0; i < NUM_RUNS; i++) {
         uint32_t seed = static_cast<uint32_t>(time(nullptr)) + i * 1000;
-        if (runFullTest(seed)) {
+        if (runFullTest(pool, seed)) {
             passedRuns++;
         } else {
             failedRuns++;
@@ -117,14 +331,35 @@ int main() {
     int demoPassedRuns = 0;
     for (int i = 0; i < NUM_RUNS; i++) {
         uint32_t seed = static_cast<uint32_t>(time(nullptr)) + i * 1000 + 500;
-        if (testFullDemo(seed)) {
+        if (testFullDemo(pool, seed)) {
             demoPassedRuns++;
         }
     }
 
+    printf("\n=== Parallel Demo Tests ===\n");
+    int parallelPassedRuns = 0;
+    for (int i = 0; i < NUM_RUNS; i++) {
+        uint32_t seed = static_cast<uint32_t>(time(nullptr)) + i * 1000 + 750;
+        if (testParallelDemo(seed)) {
+            parallelPassedRuns++;
+        }
+    }
+
+    bool sequentialPassed = testSequentialGauntlet();
+    bool capturePassed = testCaptureReplay();
+    bool poolPassed = testPoolReinitialize();
+    bool pairedPassed = testPairedSeeding();
+
     printf("\n=== Final Results ===\n");
     printf("Individual puzzle tests: %d/%d passed\n", passedRuns, NUM_RUNS);
     printf("Full demo tests: %d/%d passed\n", demoPassedRuns, NUM_RUNS);
+    printf("Parallel demo tests: %d/%d passed\n", parallelPassedRuns, NUM_RUNS);
+    printf("Sequential gauntlet test: %s\n", sequentialPassed ? "passed" : "FAILED");
+    printf("Workload capture test: %s\n", capturePassed ? "passed" : "FAILED");
+    printf("Game pool test: %s\n", poolPassed ? "passed" : "FAILED");
+    printf("Paired seeding test: %s\n", pairedPassed ? "passed" : "FAILED");
 
-    return (passedRuns == NUM_RUNS && demoPassedRuns == NUM_RUNS) ? 0 : 1;
+    return (passedRuns == NUM_RUNS && demoPassedRuns == NUM_RUNS &&
+            parallelPassedRuns == NUM_RUNS && sequentialPassed && capturePassed &&
+            poolPassed && pairedPassed) ? 0 : 1;
 }
@@ -9,12 +9,26 @@
  * 5. Composition - Combine learned rules (deep network)
  *
  * All using IntgrNN - 8-bit integer neural networks.
+ *
+ * Usage:
+ *   ./enen [--capture FILE]
+ *   ./enen --arena N [--puzzle P]
+ *
+ * --capture records the session's trials and their timing (workload.hpp)
+ * for `enen-bench replay FILE`. --arena watches N creatures (1-16) learn
+ * puzzle P side by side instead (arena.hpp); Space pauses, q quits.
  */
 
+#include "arena.hpp"
 #include "networks.hpp"
 #include "puzzles.hpp"
 #include "renderer.hpp"
+#include "workload.hpp"
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
 
 #ifdef _WIN32
@@ -71,6 +85,25 @@ char readKey() {
 
 #endif
 
+// A trial decided and drawn ahead of the keypress, not yet shown. Its
+// outcome is held here and committed (learned, captured, counted) only
+// when the frame is presented, so quitting leaves no trace of it.
+struct PendingTrial {
+    bool active = false;
+
+    // Progress and history as they are once the trial is shown
+    LearningValidator validator;
+    GauntletState gauntlet;
+    History history;
+    bool puzzleComplete = false;
+
+    // Puzzle 4: the button press (the other puzzles' trial is current_*)
+    int16_t lastAction = 0;
+    int action = 0;
+    bool success = false;     // Not a failing press
+    bool episodeOver = false; // Success or fail: learn the whole episode
+};
+
 // Demo state
 struct DemoState {
     PuzzleType current_puzzle = PuzzleType::GENERALIZATION;
@@ -97,7 +130,10 @@ struct DemoState {
     RNG rng{static_cast<uint32_t>(time(nullptr))};
 
     // Trial history for each puzzle
-    TrialHistory history;
+    History history;
+
+    // Session capture (--capture FILE), or nullptr
+    workload::Capture* capture = nullptr;
 
     // Current trials for rendering
     MushroomTrial current_mushroom;
@@ -105,6 +141,9 @@ struct DemoState {
     XORTrial current_xor;
     CompositionTrial current_composition;
 
+    // The drawn trial waiting to be shown
+    PendingTrial pending;
+
     void reset() {
         validator.reset();
         gauntlet.reset();
@@ -122,6 +161,16 @@ struct DemoState {
         }
     }
 
+    // Start a pending trial from the committed progress and history
+    PendingTrial& beginTrial() {
+        pending.active = true;
+        pending.validator = validator;
+        pending.gauntlet = gauntlet;
+        pending.history = history;
+        pending.puzzleComplete = false;
+        return pending;
+    }
+
     size_t totalModelBytes() const {
         return totalModelSize(gen_net, feat_net, xor_net, seq_net, comp_net);
     }
@@ -131,6 +180,8 @@ struct DemoState {
 // Puzzle 1: Generalization
 //=============================================================================
 void runPuzzle1Trial(DemoState& state, Renderer& renderer) {
+    PendingTrial& next = state.beginTrial();
+
     // First trial is adversarial (likely to fail, evaluated honestly)
     bool adversarial = state.validator.isFirstTrial();
     state.current_mushroom = MushroomTrial::generate(state.rng, adversarial);
@@ -140,35 +191,32 @@ void runPuzzle1Trial(DemoState& state, Renderer& renderer) {
     bool choseA = state.gen_net.chooseA(trial.sizeA, trial.sizeB, trial.colorA, trial.colorB);
     bool correct = (choseA == trial.correctIsA);
 
-    // Always learn
-    state.gen_net.learn(trial.sizeA, trial.sizeB, trial.colorA, trial.colorB, trial.correctIsA);
-
-    // Record outcome
-    state.validator.recordOutcome(correct);
+    // Record outcome (learned when shown, commitTrial)
+    next.validator.recordOutcome(correct);
 
     // Build history summary
     char summary[64];
-    snprintf(summary, sizeof(summary), "%s(%d) vs %s(%d)",
-             MushroomTrial::colorName(trial.colorA), trial.sizeA,
-             MushroomTrial::colorName(trial.colorB), trial.sizeB);
-    state.history.add(state.validator.total_trials, correct, summary);
+    text::format(summary, sizeof(summary), ENEN_FORMAT("{}({}) vs {}({})"),
+                 MushroomTrial::colorName(trial.colorA), trial.sizeA,
+                 MushroomTrial::colorName(trial.colorB), trial.sizeB);
+    next.history.add(next.validator.total_trials, correct, summary);
 
     // Check for completion
-    if (state.validator.hasLearned()) {
-        state.puzzle_complete = true;
-    }
+    next.puzzleComplete = next.validator.hasLearned();
 
     renderer.drawPuzzle1(trial, state.gen_net, choseA, correct,
-                         state.history, state.validator.total_trials,
-                         state.validator.successes,
-                         state.validator.requiredSuccesses(),
-                         state.puzzle_complete);
+                         next.history, next.validator.total_trials,
+                         next.validator.successes,
+                         next.validator.requiredSuccesses(),
+                         next.puzzleComplete);
 }
 
 //=============================================================================
 // Puzzle 2: Feature Interaction (circles safe, blue squares safest)
 //=============================================================================
 void runPuzzle2Trial(DemoState& state, Renderer& renderer) {
+    PendingTrial& next = state.beginTrial();
+
     // First trial is adversarial (blue square vs circle — tests the exception)
     bool adversarial = state.validator.isFirstTrial();
     state.current_shape = ShapeTrial::generate(state.rng, adversarial);
@@ -178,35 +226,32 @@ void runPuzzle2Trial(DemoState& state, Renderer& renderer) {
     bool choseA = state.feat_net.chooseA(trial.colorA, trial.shapeA, trial.colorB, trial.shapeB);
     bool correct = (choseA == trial.correctIsA);
 
-    // Always learn
-    state.feat_net.learn(trial.colorA, trial.shapeA, trial.colorB, trial.shapeB, trial.correctIsA);
-
-    // Record outcome
-    state.validator.recordOutcome(correct);
+    // Record outcome (learned when shown, commitTrial)
+    next.validator.recordOutcome(correct);
 
     // Build history summary
     char summary[64];
-    snprintf(summary, sizeof(summary), "%s %s vs %s %s",
-             ShapeTrial::colorName(trial.colorA), ShapeTrial::shapeName(trial.shapeA),
-             ShapeTrial::colorName(trial.colorB), ShapeTrial::shapeName(trial.shapeB));
-    state.history.add(state.validator.total_trials, correct, summary);
+    text::format(summary, sizeof(summary), ENEN_FORMAT("{} {} vs {} {}"),
+                 ShapeTrial::colorName(trial.colorA), ShapeTrial::shapeName(trial.shapeA),
+                 ShapeTrial::colorName(trial.colorB), ShapeTrial::shapeName(trial.shapeB));
+    next.history.add(next.validator.total_trials, correct, summary);
 
     // Check for completion
-    if (state.validator.hasLearned()) {
-        state.puzzle_complete = true;
-    }
+    next.puzzleComplete = next.validator.hasLearned();
 
     renderer.drawPuzzle2(trial, state.feat_net, choseA, correct,
-                         state.history, state.validator.total_trials,
-                         state.validator.successes,
-                         state.validator.requiredSuccesses(),
-                         state.puzzle_complete);
+                         next.history, next.validator.total_trials,
+                         next.validator.successes,
+                         next.validator.requiredSuccesses(),
+                         next.puzzleComplete);
 }
 
 //=============================================================================
 // Puzzle 3: XOR (Context-dependent choice)
 //=============================================================================
 void runPuzzle3Trial(DemoState& state, Renderer& renderer) {
+    PendingTrial& next = state.beginTrial();
+
     state.current_xor = XORTrial::generate(state.rng);
     const auto& trial = state.current_xor;
 
@@ -214,78 +259,70 @@ void runPuzzle3Trial(DemoState& state, Renderer& renderer) {
     bool predictedSafe = state.xor_net.isSafe(trial.lightInput(), trial.pathInput());
     bool correct = (predictedSafe == trial.isSafe);
 
-    // Always learn
-    state.xor_net.learn(trial.lightInput(), trial.pathInput(), trial.isSafe);
-
-    // Record outcome
-    state.validator.recordOutcome(correct);
+    // Record outcome (learned when shown, commitTrial)
+    next.validator.recordOutcome(correct);
 
     // Build history summary (prediction vs reality)
     char summary[64];
-    snprintf(summary, sizeof(summary), "pred %s, was %s",
-             predictedSafe ? "safe" : "danger",
-             trial.isSafe ? "safe" : "danger");
-    state.history.add(state.validator.total_trials, correct, summary);
+    text::format(summary, sizeof(summary), ENEN_FORMAT("pred {}, was {}"),
+                 predictedSafe ? "safe" : "danger",
+                 trial.isSafe ? "safe" : "danger");
+    next.history.add(next.validator.total_trials, correct, summary);
 
     // Check for completion
-    if (state.validator.hasLearned()) {
-        state.puzzle_complete = true;
-    }
+    next.puzzleComplete = next.validator.hasLearned();
 
     renderer.drawPuzzle3(trial, state.xor_net, predictedSafe, correct,
-                         state.history, state.validator.total_trials,
-                         state.validator.successes,
-                         state.validator.requiredSuccesses(),
-                         state.puzzle_complete);
+                         next.history, next.validator.total_trials,
+                         next.validator.successes,
+                         next.validator.requiredSuccesses(),
+                         next.puzzleComplete);
 }
 
 //=============================================================================
 // Puzzle 4: Sequence (A then B)
 //=============================================================================
 void runPuzzle4Step(DemoState& state, Renderer& renderer) {
+    PendingTrial& next = state.beginTrial();
     int16_t last = state.seq_puzzle.lastActionInput();
 
     // IntgrNN network decides based on last_action alone
     int action = state.seq_net.chooseAction(last);
 
     state.seq_puzzle.pressButton(action);
+    next.lastAction = last;
+    next.action = action;
+    next.success = !state.seq_puzzle.isFail();
+    next.episodeOver = false;
 
-    bool trialComplete = false;
     bool correct = false;
     const char* resultStr = "";
 
     if (state.seq_puzzle.isSuccess()) {
-        trialComplete = true;
         // Honest evaluation — if enen succeeded, it succeeded
+        next.episodeOver = true;
         correct = true;
         resultStr = "A->B SUCCESS";
-        state.seq_net.learnFromOutcome(last, action, true);
         state.seq_puzzle.reset();
     } else if (state.seq_puzzle.isFail()) {
-        trialComplete = true;
+        next.episodeOver = true;
         correct = false;
         resultStr = action == 1 ? "B first FAIL" : "A->A FAIL";
-        state.seq_net.learnFromOutcome(last, action, false);
         state.seq_puzzle.reset();
-    } else {
-        // In progress (pressed A, waiting for B)
-        state.seq_net.learnFromOutcome(last, action, true);
     }
+    // Otherwise in progress (pressed A, waiting for B)
 
-    if (trialComplete) {
-        state.validator.recordOutcome(correct);
-        state.history.add(state.validator.total_trials, correct, resultStr);
-
-        if (state.validator.hasLearned()) {
-            state.puzzle_complete = true;
-        }
+    if (next.episodeOver) {
+        next.validator.recordOutcome(correct);
+        next.history.add(next.validator.total_trials, correct, resultStr);
+        next.puzzleComplete = next.validator.hasLearned();
     }
 
-    renderer.drawPuzzle4(state.seq_puzzle, state.seq_net, state.history,
-                         state.validator.total_trials,
-                         state.validator.successes,
-                         state.validator.requiredSuccesses(),
-                         state.puzzle_complete);
+    renderer.drawPuzzle4(state.seq_puzzle, state.seq_net, next.history,
+                         next.validator.total_trials,
+                         next.validator.successes,
+                         next.validator.requiredSuccesses(),
+                         next.puzzleComplete);
 }
 
 //=============================================================================
@@ -297,6 +334,7 @@ void runPuzzle5Trial(DemoState& state, Renderer& renderer) {
         state.puzzle_complete = true;
         return;
     }
+    PendingTrial& next = state.beginTrial();
 
     state.current_composition = CompositionTrial::generate(state.rng);
     const auto& trial = state.current_composition;
@@ -304,43 +342,179 @@ void runPuzzle5Trial(DemoState& state, Renderer& renderer) {
     bool choseA = state.comp_net.chooseA(trial.lightInput(), trial.sizeA, trial.sizeB);
     bool correct = (choseA == trial.correctIsA);
 
-    // Always learn
-    state.comp_net.learn(trial.lightInput(), trial.sizeA, trial.sizeB, trial.correctIsA);
-
-    // Record in gauntlet
-    state.gauntlet.recordOutcome(correct);
+    // Record in gauntlet (learned when shown, commitTrial)
+    next.gauntlet.recordOutcome(correct);
 
     // Build history summary
     char summary[64];
     bool aLarger = trial.sizeA > trial.sizeB;
-    snprintf(summary, sizeof(summary), "%s — %c(%d) %s %c(%d)",
-             trial.lightOn ? "ON" : "OFF",
-             choseA ? 'A' : 'B',
-             choseA ? trial.sizeA : trial.sizeB,
-             (choseA ? aLarger : !aLarger) ? ">" : "<",
-             choseA ? 'B' : 'A',
-             choseA ? trial.sizeB : trial.sizeA);
-    state.history.add(state.gauntlet.currentTrials(), correct, summary);
+    text::format(summary, sizeof(summary), ENEN_FORMAT("{} — {}({}) {} {}({})"),
+                 trial.lightOn ? "ON" : "OFF",
+                 choseA ? 'A' : 'B',
+                 choseA ? trial.sizeA : trial.sizeB,
+                 (choseA ? aLarger : !aLarger) ? ">" : "<",
+                 choseA ? 'B' : 'A',
+                 choseA ? trial.sizeB : trial.sizeA);
+    next.history.add(next.gauntlet.currentTrials(), correct, summary);
 
     // Check for completion
-    if (state.gauntlet.isComplete()) {
-        state.puzzle_complete = true;
-    }
+    next.puzzleComplete = next.gauntlet.isComplete();
 
     renderer.drawPuzzle5(trial, state.comp_net, choseA, correct,
-                         state.history, state.gauntlet, state.puzzle_complete);
+                         next.history, next.gauntlet, next.puzzleComplete);
+}
+
+//=============================================================================
+// Trial dispatch
+//=============================================================================
+
+// Generate, decide and draw the next trial (see PendingTrial)
+void runTrial(DemoState& state, Renderer& renderer) {
+    switch (state.current_puzzle) {
+        case PuzzleType::GENERALIZATION:
+            runPuzzle1Trial(state, renderer);
+            break;
+        case PuzzleType::FEATURE_SELECTION:
+            runPuzzle2Trial(state, renderer);
+            break;
+        case PuzzleType::XOR_CONTEXT:
+            runPuzzle3Trial(state, renderer);
+            break;
+        case PuzzleType::SEQUENCE:
+            runPuzzle4Step(state, renderer);
+            break;
+        case PuzzleType::COMPOSITION:
+            runPuzzle5Trial(state, renderer);
+            break;
+    }
+}
+
+// The drawn trial has been shown: capture it, learn from it, and take
+// its progress and history
+void commitTrial(DemoState& state) {
+    PendingTrial& p = state.pending;
+    if (!p.active) return;
+    p.active = false;
+
+    switch (state.current_puzzle) {
+        case PuzzleType::GENERALIZATION: {
+            const auto& t = state.current_mushroom;
+            if (state.capture) state.capture->add(t);
+            state.gen_net.learn(t.sizeA, t.sizeB, t.colorA, t.colorB, t.correctIsA);
+            break;
+        }
+        case PuzzleType::FEATURE_SELECTION: {
+            const auto& t = state.current_shape;
+            if (state.capture) state.capture->add(t);
+            state.feat_net.learn(t.colorA, t.shapeA, t.colorB, t.shapeB, t.correctIsA);
+            break;
+        }
+        case PuzzleType::XOR_CONTEXT: {
+            const auto& t = state.current_xor;
+            if (state.capture) state.capture->add(t);
+            state.xor_net.learn(t.lightInput(), t.pathInput(), t.isSafe);
+            break;
+        }
+        case PuzzleType::SEQUENCE:
+            if (state.capture) state.capture->addSequenceStep(p.lastAction, p.action, p.success);
+            // An episode still in progress is learned when it ends
+            if (p.episodeOver) state.seq_net.learnFromOutcome(p.lastAction, p.action, p.success);
+            else state.seq_net.addStep(p.lastAction, p.action, true);
+            break;
+        case PuzzleType::COMPOSITION: {
+            const auto& t = state.current_composition;
+            if (state.capture) state.capture->add(t);
+            state.comp_net.learn(t.lightInput(), t.sizeA, t.sizeB, t.correctIsA);
+            break;
+        }
+    }
+
+    state.validator = p.validator;
+    state.gauntlet = p.gauntlet;
+    state.history = p.history;
+    state.puzzle_complete = p.puzzleComplete;
+}
+
+// Draw the next trial ahead of the keypress. Nothing the user can press
+// changes what the next trial is, so it is generated, decided and drawn
+// while we wait; Space presents the held frame and commits the trial.
+void prepareNextTrial(DemoState& state, Renderer& renderer) {
+    renderer.holdFrames(true);
+    runTrial(state, renderer);
+    renderer.holdFrames(false);
+}
+
+// Live arena: a tick every timing::ARENA_TICK seconds until every
+// creature has learned or given up, then wait for q
+void runArena(Renderer& renderer, int creatures, PuzzleType puzzle) {
+    using Clock = std::chrono::steady_clock;
+    const auto interval = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(timing::ARENA_TICK));
+
+    ArenaConfig config;
+    config.creatures = creatures;
+    config.baseSeed = static_cast<uint32_t>(time(nullptr));
+    config.puzzle = puzzle;
+    Arena arena(config);
+
+    TextBuffer frame;
+    arena.render(frame);
+    renderer.drawFrame(frame);
+
+    bool paused = false;
+    auto due = Clock::now() + interval;
+    while (true) {
+        char key = readKey();
+        if (key == 'q' || key == 'Q') break;
+        if (key == ' ') paused = !paused;
+        if (paused || Clock::now() < due) continue;
+        due = Clock::now() + interval;
+        if (arena.tick()) {
+            arena.render(frame);
+            renderer.drawFrame(frame);
+        }
+    }
 }
 
 //=============================================================================
 // Main
 //=============================================================================
-int main() {
+int main(int argc, char** argv) {
+    const char* capturePath = nullptr;
+    int arenaCreatures = 0;
+    int arenaPuzzle = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            capturePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--arena") == 0 && i + 1 < argc) {
+            arenaCreatures = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--puzzle") == 0 && i + 1 < argc) {
+            arenaPuzzle = std::clamp(std::atoi(argv[++i]), 1, NUM_PUZZLES);
+        } else {
+            std::fprintf(stderr, "Usage: %s [--capture FILE] [--arena N [--puzzle P]]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (arenaCreatures > 0) {
+        enableRawMode();
+        Renderer renderer;
+        renderer.init();
+        runArena(renderer, arenaCreatures, static_cast<PuzzleType>(arenaPuzzle - 1));
+        renderer.cleanup();
+        disableRawMode();
+        printf("\n");
+        return 0;
+    }
+
     enableRawMode();
 
     Renderer renderer;
     renderer.init();
 
     DemoState state;
+    workload::Capture capture;
+    if (capturePath) state.capture = &capture;
     bool showIntro = true;
     bool showPuzzleIntro = false;
 
@@ -348,6 +522,11 @@ int main() {
     renderer.drawIntro(state.totalModelBytes());
 
     while (!state.demo_complete) {
+        // Idle work: as soon as a frame is on screen, prepare the next one
+        if (!showIntro && !state.puzzle_complete && !renderer.framePending()) {
+            prepareNextTrial(state, renderer);
+        }
+
         char key = readKey();
 
         if (key == 'q' || key == 'Q') {
@@ -372,8 +551,9 @@ int main() {
             }
         }
 
-        // Handle puzzle completion - require Enter to advance (not Space)
-        if (state.puzzle_complete) {
+        // Handle puzzle completion - require Enter to advance (not Space),
+        // once the completing trial has been shown
+        if (state.puzzle_complete && !renderer.framePending()) {
             if (key == '\n' || key == '\r') {
                 state.nextPuzzle();
                 if (!state.demo_complete) {
@@ -384,25 +564,15 @@ int main() {
             continue;
         }
 
-        // Next trial (Space only)
+        // Next trial (Space only): normally already prepared. It counts
+        // from here on, once it is on screen.
         if (key == ' ') {
-            switch (state.current_puzzle) {
-                case PuzzleType::GENERALIZATION:
-                    runPuzzle1Trial(state, renderer);
-                    break;
-                case PuzzleType::FEATURE_SELECTION:
-                    runPuzzle2Trial(state, renderer);
-                    break;
-                case PuzzleType::XOR_CONTEXT:
-                    runPuzzle3Trial(state, renderer);
-                    break;
-                case PuzzleType::SEQUENCE:
-                    runPuzzle4Step(state, renderer);
-                    break;
-                case PuzzleType::COMPOSITION:
-                    runPuzzle5Trial(state, renderer);
-                    break;
+            if (renderer.framePending()) {
+                renderer.present();
+            } else {
+                runTrial(state, renderer);
             }
+            commitTrial(state);
         }
     }
 
@@ -410,7 +580,7 @@ int main() {
     if (state.demo_complete) {
         renderer.drawVictory(state.totalModelBytes(),
                              state.gauntlet.correct,
-                             GauntletState::SCORED_TRIALS);
+                             state.gauntlet.scoredLimit());
         while (true) {
             char key = readKey();
             if (key == 'q' || key == 'Q') break;
@@ -421,5 +591,14 @@ int main() {
     disableRawMode();
     printf("\n");
 
+    if (capturePath) {
+        if (workload::save(capturePath, capture.records())) {
+            printf("Captured %zu trials to %s\n", capture.records().size(), capturePath);
+        } else {
+            std::fprintf(stderr, "Could not write %s\n", capturePath);
+            return 1;
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,128 @@
+/**
+ * enen Demo: Render the Demo to an Animated GIF
+ *
+ * Records the same demo as enen-autorun, rasterized in-process instead of
+ * through a cast and an external converter.
+ * Usage:
+ *   ./enen-render                     # writes demo.gif
+ *   ./enen-render -o run7.gif --seed 7
+ *
+ * Options:
+ *   -o FILE       output file (default demo.gif)
+ *   --seed N      trial stream seed (default 42, as enen-autorun)
+ *   --scale N     pixels per font pixel (default 2: 960x432)
+ *   --threads N   worker threads (default: one per hardware thread)
+ *
+ * Pipeline (autorun.hpp, raster.hpp, gif.hpp):
+ * 1. Simulate the demo into a frame log
+ * 2. Draw every frame's TextBuffer (parallel)
+ * 3. Diff each frame against the previous one to the changed cell
+ *    rectangle; frames with no change just extend the previous delay
+ * 4. Rasterize and LZW-encode only the changed rectangles (parallel)
+ * 5. Write the GIF in order
+ */
+
+#include "autorun.hpp"
+#include "gif.hpp"
+#include "raster.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace enen;
+
+namespace {
+
+struct Update {
+    size_t frame;          // Index into the log
+    raster::CellRect rect; // Cells that changed since the previous update
+    double start;          // Seconds
+    double end;
+};
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    const char* output = "demo.gif";
+    uint32_t seed = 42;
+    int scale = 2;
+    int threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            scale = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: %s [-o FILE] [--seed N] [--scale N] [--threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // 1-2. Simulate, then draw every frame
+    FrameLog log = simulateDemo(seed);
+    std::vector<TextBuffer> buffers(log.size());
+    parallelFor(log.size(), threads, [&](size_t i) { renderFrame(buffers[i], log[i]); });
+
+    // 3. Changed regions; unchanged frames only extend the previous one
+    std::vector<double> times = frameTimes(log);
+    std::vector<Update> updates;
+    for (size_t i = 0; i < log.size(); i++) {
+        double end = times[i] + log[i].pause;
+        raster::CellRect rect = (i == 0) ? raster::CellRect::full()
+                                         : raster::diffCells(buffers[i - 1], buffers[i]);
+        if (rect.empty()) {
+            updates.back().end = end;
+        } else {
+            updates.push_back({i, rect, times[i], end});
+        }
+    }
+
+    // 4. Rasterize and compress the updates
+    std::vector<gif::Frame> frames(updates.size());
+    parallelFor(updates.size(), threads, [&](size_t u) {
+        const Update& update = updates[u];
+        std::vector<uint8_t> pixels;
+        raster::rasterize(buffers[update.frame], update.rect, scale, pixels);
+
+        gif::Frame& frame = frames[u];
+        frame.x = static_cast<uint16_t>(update.rect.x * raster::CELL_W * scale);
+        frame.y = static_cast<uint16_t>(update.rect.y * raster::CELL_H * scale);
+        frame.width = static_cast<uint16_t>(update.rect.w * raster::CELL_W * scale);
+        frame.height = static_cast<uint16_t>(update.rect.h * raster::CELL_H * scale);
+        // Round the timeline, not each delay, so the GIF doesn't drift
+        long delay = std::lround(update.end * 100.0) - std::lround(update.start * 100.0);
+        frame.delay = static_cast<uint16_t>(std::min(delay, 65535L));
+        frame.data = gif::encodeLzw(pixels.data(), pixels.size());
+    });
+
+    // 5. Write in order
+    std::FILE* file = std::fopen(output, "wb");
+    if (!file) {
+        std::fprintf(stderr, "Cannot write %s\n", output);
+        return 1;
+    }
+    bool ok = gif::write(file, terminal::WIDTH * raster::CELL_W * scale,
+                         terminal::HEIGHT * raster::CELL_H * scale,
+                         raster::BACKGROUND, raster::FOREGROUND, frames);
+    long bytes = std::ftell(file);
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::fprintf(stderr, "Error writing %s\n", output);
+        return 1;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%s: %zu frames (%zu updates), %.1f s of video, %ld bytes in %.0f ms\n",
+                 output, log.size(), updates.size(), log.empty() ? 0.0 : times.back() + log.back().pause,
+                 bytes, ms);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * enen Demo: Live Metrics Viewer
+ *
+ * Maps a running simulation's metrics segment (metrics.hpp) read-only and
+ * redraws a summary every interval: throughput, learn() latency, replay
+ * sizes, mastery per puzzle and frame overruns. The publisher never
+ * waits on the viewer - reading is just loads from shared memory.
+ *
+ * Usage:
+ *   ./enen-top [NAME] [--interval S] [--once]
+ *
+ * NAME defaults to enen-population (/dev/shm/enen-population).
+ */
+
+#include "metrics.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace enen;
+using metrics::LATENCY_BUCKETS;
+
+namespace {
+
+//=============================================================================
+// Totals - Sum of all shards at one instant
+//=============================================================================
+struct Totals {
+    uint64_t trials = 0;
+    uint64_t frameOverruns = 0;
+    uint64_t learnCalls = 0;
+    uint64_t learnNanos = 0;
+    uint64_t replaySamples = 0;
+    uint64_t replayMax = 0;
+    uint64_t mastered[NUM_PUZZLES] = {};
+    uint64_t gaveUp = 0;
+    uint64_t learnLatency[LATENCY_BUCKETS] = {};
+    std::vector<uint64_t> shardTrials;
+};
+
+Totals sample(const metrics::Segment& segment) {
+    Totals t;
+    for (uint32_t s = 0; s < segment.shardCount(); s++) {
+        const metrics::Shard& shard = *segment.shard(s);
+        t.trials += shard.trials.load();
+        t.frameOverruns += shard.frameOverruns.load();
+        t.learnCalls += shard.learnCalls.load();
+        t.learnNanos += shard.learnNanos.load();
+        t.replaySamples += shard.replaySamples.load();
+        if (shard.replayMax.load() > t.replayMax) t.replayMax = shard.replayMax.load();
+        for (int p = 0; p < NUM_PUZZLES; p++) t.mastered[p] += shard.mastered[p].load();
+        t.gaveUp += shard.gaveUp.load();
+        for (int b = 0; b < LATENCY_BUCKETS; b++) t.learnLatency[b] += shard.learnLatency[b].load();
+        t.shardTrials.push_back(shard.trials.load());
+    }
+    return t;
+}
+
+// Upper edge of the bucket holding the q-th quantile, in microseconds
+double latencyQuantileUs(const uint64_t* buckets, uint64_t total, double q) {
+    if (total == 0) return 0.0;
+    uint64_t rank = static_cast<uint64_t>(q * (total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += buckets[b];
+        if (seen >= rank) return static_cast<double>(uint64_t(1) << (b + 1)) / 1000.0;
+    }
+    return static_cast<double>(uint64_t(1) << LATENCY_BUCKETS) / 1000.0;
+}
+
+const char* formatNanos(uint64_t nanos, char* out, size_t size) {
+    if (nanos < 1000) std::snprintf(out, size, "%lluns", static_cast<unsigned long long>(nanos));
+    else if (nanos < 1000000) std::snprintf(out, size, "%.0fus", nanos / 1e3);
+    else if (nanos < 1000000000) std::snprintf(out, size, "%.0fms", nanos / 1e6);
+    else std::snprintf(out, size, "%.0fs", nanos / 1e9);
+    return out;
+}
+
+//=============================================================================
+// Display
+//=============================================================================
+void draw(const metrics::Segment& segment, const Totals& now, const Totals& before,
+          double seconds, bool clear) {
+    const metrics::Header& h = *segment.header();
+    if (clear) printf("\x1b[H\x1b[2J");
+
+    printf("enen-top  %s (pid %lld, %u shard%s)%s\n", h.label, static_cast<long long>(h.pid),
+           h.shards, h.shards == 1 ? "" : "s",
+           h.running.load(std::memory_order_relaxed) ? "" : "  [finished]");
+    printf("======================================================================\n");
+
+    double rate = seconds > 0 ? (now.trials - before.trials) / seconds : 0.0;
+    double learnRate = seconds > 0 ? (now.learnCalls - before.learnCalls) / seconds : 0.0;
+    printf("Trials       %12llu   %10.0f /s\n", static_cast<unsigned long long>(now.trials), rate);
+    printf("learn()      %12llu   %10.0f /s\n", static_cast<unsigned long long>(now.learnCalls), learnRate);
+    printf("Overruns     %12llu   (trials over the %.1f ms frame budget)\n",
+           static_cast<unsigned long long>(now.frameOverruns),
+           h.shards > 0 ? segment.shard(0)->frameBudgetNs / 1e6 : 0.0);
+
+    double replayMean = now.learnCalls ? static_cast<double>(now.replaySamples) / now.learnCalls : 0.0;
+    printf("Replay size  mean %.1f, max %llu\n", replayMean,
+           static_cast<unsigned long long>(now.replayMax));
+
+    // Latency: totals since start, plus the histogram of the last interval
+    double meanUs = now.learnCalls ? now.learnNanos / 1e3 / now.learnCalls : 0.0;
+    printf("\nlearn() latency  mean %.1f us, p50 <%.1f us, p90 <%.1f us, p99 <%.1f us\n", meanUs,
+           latencyQuantileUs(now.learnLatency, now.learnCalls, 0.50),
+           latencyQuantileUs(now.learnLatency, now.learnCalls, 0.90),
+           latencyQuantileUs(now.learnLatency, now.learnCalls, 0.99));
+
+    uint64_t interval[LATENCY_BUCKETS];
+    uint64_t peak = 0;
+    int first = LATENCY_BUCKETS, last = -1;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        interval[b] = now.learnLatency[b] - before.learnLatency[b];
+        if (interval[b] > peak) peak = interval[b];
+        if (now.learnLatency[b] > 0) {
+            if (b < first) first = b;
+            last = b;
+        }
+    }
+    for (int b = first; b <= last; b++) {
+        char lo[16], hi[16];
+        int width = peak ? static_cast<int>(40 * interval[b] / peak) : 0;
+        printf("  %6s-%-6s %10llu  %.*s\n", formatNanos(uint64_t(1) << b, lo, sizeof(lo)),
+               formatNanos(uint64_t(1) << (b + 1), hi, sizeof(hi)),
+               static_cast<unsigned long long>(interval[b]), width,
+               "########################################");
+    }
+
+    printf("\nMastered\n");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        printf("  %-18s %10llu\n", puzzleLabel(static_cast<PuzzleType>(p)), static_cast<unsigned long long>(now.mastered[p]));
+    }
+    printf("  %-18s %10llu\n", "Gave up", static_cast<unsigned long long>(now.gaveUp));
+
+    printf("\nShard  trials/s\n");
+    for (size_t s = 0; s < now.shardTrials.size(); s++) {
+        uint64_t previous = s < before.shardTrials.size() ? before.shardTrials[s] : 0;
+        printf("  %3zu  %10.0f\n", s, seconds > 0 ? (now.shardTrials[s] - previous) / seconds : 0.0);
+    }
+    std::fflush(stdout);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* name = "enen-population";
+    double interval = 1.0;
+    bool once = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            interval = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else if (argv[i][0] != '-') {
+            name = argv[i];
+        } else {
+            std::fprintf(stderr, "Usage: %s [NAME] [--interval S] [--once]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (interval < 0.05) interval = 0.05;
+
+    metrics::Segment segment;
+    if (!segment.openReadOnly(name)) {
+        std::fprintf(stderr, "No metrics segment /dev/shm/%s (is enen-population running?)\n", name);
+        return 1;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Totals before = sample(segment);
+    auto then = Clock::now();
+
+    // --once: one interval's worth of rates, printed without clearing
+    for (;;) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(interval));
+        Totals now = sample(segment);
+        auto at = Clock::now();
+        draw(segment, now, before, std::chrono::duration<double>(at - then).count(), !once);
+        if (once || !segment.header()->running.load(std::memory_order_relaxed)) break;
+        before = std::move(now);
+        then = at;
+    }
+    return 0;
+}
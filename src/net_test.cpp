@@ -7,9 +7,11 @@
  * With experience replay, tests show gradual learning progression.
  */
 
+#include "heatmap.hpp"
 #include "networks.hpp"
 #include "puzzles.hpp"
 #include <cstdio>
+#include <vector>
 
 using namespace enen;
 
@@ -249,6 +251,280 @@ bool testComposition() {
     return pass;
 }
 
+//=============================================================================
+// Test 6: Interruptible training
+// Sliced step() training must match learn(); cancel() must stop a pass
+//=============================================================================
+bool testInterruptibleTraining() {
+    printf("Test 6: Interruptible training (step/cancel cursor)\n");
+
+    XORNet atomic;
+    XORNet sliced;
+    atomic.reset(777);
+    sliced.reset(777);
+
+    RNG rng(42);
+    size_t slices = 0;
+    for (int trial = 0; trial < 10; trial++) {
+        auto t = XORTrial::generate(rng);
+        atomic.learn(t.lightInput(), t.pathInput(), t.isSafe);
+
+        sliced.beginLearn(t.lightInput(), t.pathInput(), t.isSafe);
+        while (sliced.isTraining()) {
+            sliced.step(7);  // Odd slice size crosses epoch boundaries
+            slices++;
+        }
+    }
+
+    int agree = 0;
+    for (int16_t light : {0, 127}) {
+        for (int16_t path : {0, 127}) {
+            if (atomic.isSafe(light, path) == sliced.isSafe(light, path)) agree++;
+        }
+    }
+    printf("  Sliced into %zu steps, agreement with learn(): %d/4\n", slices, agree);
+
+    // Cancel mid-pass: cursor stops, history keeps the sample
+    sliced.beginLearn(127, 0, true);
+    sliced.step(3);
+    size_t before = sliced.remainingSteps();
+    sliced.cancel();
+    bool cancelled = !sliced.isTraining() && sliced.step(5) == 0 &&
+                     sliced.remainingSteps() == 0 && sliced.historySize() == 11;
+    printf("  Cancel after 3 steps (%zu remaining): %s\n", before, cancelled ? "stopped" : "still running");
+
+    bool pass = agree == 4 && cancelled;
+    printf("  %s\n\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+//=============================================================================
+// Test 7: Float reference backend
+// Same wrapper and replay loop on the float32 MLP must also learn XOR
+//=============================================================================
+bool testFloatBackend() {
+    printf("Test 7: Float reference backend (float32 2->4->1, same replay)\n");
+
+    XORNet net(Backend::FLOAT);
+    net.reset(42);
+    printf("  Params: %zu, Size: %zu bytes\n", net.parameterCount(), net.modelSizeBytes());
+
+    RNG rng(42);
+    for (int trial = 0; trial < 15; trial++) {
+        auto t = XORTrial::generate(rng);
+        net.learn(t.lightInput(), t.pathInput(), t.isSafe);
+    }
+
+    int correct = (net.isSafe(127, 0) ? 1 : 0) + (!net.isSafe(127, 127) ? 1 : 0) +
+                  (!net.isSafe(0, 0) ? 1 : 0) + (net.isSafe(0, 127) ? 1 : 0);
+    bool pass = correct >= 3 && net.modelSizeBytes() == net.parameterCount() * sizeof(float);
+    printf("  Score: %d/4 %s\n\n", correct, pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+//=============================================================================
+// Test 8: Decision heatmap
+// Batched grid must match one-at-a-time decisions; the grid is only
+// re-scored when the weights change
+//=============================================================================
+bool testDecisionHeatmap() {
+    printf("Test 8: Decision heatmap (batched grid, cached until learn)\n");
+
+    bool pass = true;
+    for (Backend backend : {Backend::INTEGER, Backend::FLOAT, Backend::EVOLVED}) {
+        CompositionNet net(backend);
+        net.reset(7);
+        RNG rng(7);
+        for (int trial = 0; trial < 5; trial++) {
+            auto t = CompositionTrial::generate(rng);
+            net.learn(t.lightInput(), t.sizeA, t.sizeB, t.correctIsA);
+        }
+
+        DecisionHeatmap heatmap;
+        heatmap.update(net, 127);
+
+        int mismatches = 0;
+        for (size_t r = 0; r < DecisionGrid::ROWS; r++) {
+            for (size_t c = 0; c < DecisionGrid::COLS; c++) {
+                net.chooseA(127, DecisionGrid::xAt(c), DecisionGrid::yAt(r));
+                const auto& trace = net.lastForward();
+                int diff = trace.units[trace.outputLayer()][0] - heatmap.grid().cells[r][c];
+                if (diff < -1 || diff > 1) mismatches++;  // Allow float rounding
+            }
+        }
+
+        bool cachedHit = !heatmap.update(net, 127);
+        bool lightMiss = heatmap.update(net, 0);
+        net.learn(0, 90, 30, false);
+        bool learnMiss = heatmap.update(net, 0);
+
+        bool ok = mismatches == 0 && cachedHit && lightMiss && learnMiss &&
+                  heatmap.evaluations() == 3;
+        printf("  %-12s grid mismatches: %d, cache: %s  %s\n", backendName(backend), mismatches,
+               (cachedHit && lightMiss && learnMiss) ? "ok" : "wrong", ok ? "PASS" : "FAIL");
+        pass = pass && ok;
+    }
+    printf("  %s\n\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+//=============================================================================
+// Test 9: Evolved int8 backend
+// The (1+lambda) learner must learn XOR through the same wrapper at one
+// byte per weight; sliced step() must match learn(), and scoring on
+// several threads must not change the result
+//=============================================================================
+bool testEvolvedBackend() {
+    printf("Test 9: Evolved int8 backend ((1+lambda) over the replay buffer)\n");
+
+    XORNet net(Backend::EVOLVED);
+    XORNet sliced(Backend::EVOLVED);
+    net.reset(42);
+    sliced.reset(42);
+    printf("  Params: %zu, Size: %zu bytes\n", net.parameterCount(), net.modelSizeBytes());
+
+    RNG rng(42);
+    for (int trial = 0; trial < 15; trial++) {
+        auto t = XORTrial::generate(rng);
+        net.learn(t.lightInput(), t.pathInput(), t.isSafe);
+        sliced.beginLearn(t.lightInput(), t.pathInput(), t.isSafe);
+        while (sliced.isTraining()) sliced.step(1);
+    }
+
+    int correct = (net.isSafe(127, 0) ? 1 : 0) + (!net.isSafe(127, 127) ? 1 : 0) +
+                  (!net.isSafe(0, 0) ? 1 : 0) + (net.isSafe(0, 127) ? 1 : 0);
+    int agree = 0;
+    for (int16_t light : {0, 127}) {
+        for (int16_t path : {0, 127}) {
+            agree += net.isSafe(light, path) == sliced.isSafe(light, path);
+        }
+    }
+
+    // Same generations on one thread and on four
+    uint8_t inputs[] = {0, 0, 0, 254, 254, 0, 254, 254};
+    uint8_t targets[] = {0, 255, 255, 0};
+    EvolutionConfig serial;
+    serial.threads = 1;
+    EvolutionConfig parallel;
+    parallel.threads = 4;
+    parallel.parallelWork = 0;
+    EvolvedMLP a(2, {4}, 1, serial);
+    EvolvedMLP b(2, {4}, 1, parallel);
+    a.reinitialize(9);
+    b.reinitialize(9);
+    for (int g = 0; g < 50; g++) {
+        a.evolve(inputs, targets, 4);
+        b.evolve(inputs, targets, 4);
+    }
+    bool sameWeights = b.stats().parallelGenerations == 50;
+    for (size_t i = 0; i < 2; i++) {
+        for (size_t j = 0; j < 4; j++) sameWeights &= a.weight(0, j, i) == b.weight(0, j, i);
+    }
+
+    bool pass = correct >= 3 && agree == 4 && sameWeights && net.modelSizeBytes() == 17;
+    printf("  Score: %d/4, sliced agreement %d/4, threads %s  %s\n\n", correct, agree,
+           sameWeights ? "identical" : "DIFFER", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+//=============================================================================
+// Test 10: Batched learning
+// learnBatch() of one must match learn(); a batch of k appends k samples
+// and starts one replay of batchEpochs() epochs
+//=============================================================================
+bool testLearnBatch() {
+    printf("Test 10: Batched learning (learnBatch, one replay per batch)\n");
+
+    XORNet single;
+    XORNet batched;
+    single.reset(31);
+    batched.reset(31);
+
+    RNG rng(42);
+    std::vector<XORNet::Sample> samples;
+    for (int i = 0; i < 8; i++) {
+        auto t = XORTrial::generate(rng);
+        samples.push_back({t.lightInput(), t.pathInput(), t.isSafe});
+    }
+    for (const auto& s : samples) {
+        single.learn(s.light, s.path, s.safe);
+        batched.learnBatch(&s, 1);
+    }
+    int agree = 0;
+    for (int16_t light : {0, 127}) {
+        for (int16_t path : {0, 127}) {
+            agree += single.isSafe(light, path) == batched.isSafe(light, path);
+        }
+    }
+
+    // Eight more in one batch: one pass over all 16, per-trial epochs
+    batched.beginLearnBatch(samples.data(), samples.size());
+    size_t perTrial = batched.remainingSteps();
+    batched.finishTraining();
+
+    // Policy knob, and an empty batch changes nothing
+    batched.setBatchEpochs(20);
+    batched.beginLearnBatch(samples.data(), 4);
+    size_t knob = batched.remainingSteps();
+    batched.finishTraining();
+    batched.beginLearnBatch(samples.data(), 0);
+    bool empty = !batched.isTraining() && batched.historySize() == 20;
+
+    // reset() returns to the default policy with the rest of training
+    batched.reset(31);
+    bool policyReset = batched.batchEpochs() == 0 && batched.historySize() == 0;
+
+    printf("  Batch of 1 vs learn(): %d/4, batch of 8: %zu updates, 20 epochs x 20: %zu\n",
+           agree, perTrial, knob);
+    bool pass = agree == 4 && perTrial == 200 * 16 && knob == 20 * 20 && empty && policyReset;
+    printf("  %s\n\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+//=============================================================================
+// Test 11: Episode steps during a sliced pass
+// addStep() while a replay is under way must restart it over the whole
+// history, exactly as starting a new pass with that sample would. On the
+// evolved backend this re-encodes the history (it used to replay a stale
+// encoding shorter than the history)
+//=============================================================================
+bool testStepDuringPass() {
+    printf("Test 11: Episode step during a sliced pass (evolved backend)\n");
+
+    SequenceNet stepped(Backend::EVOLVED);
+    SequenceNet restarted(Backend::EVOLVED);
+    stepped.reset(17);
+    restarted.reset(17);
+
+    // Contradictory outcomes at the start, so the pass cannot finish early
+    for (SequenceNet* net : {&stepped, &restarted}) {
+        net->learnFromOutcome(0, 0, true);
+        net->beginLearnFromOutcome(0, 0, false);
+        net->step(1);
+    }
+    bool midPass = stepped.isTraining() && restarted.isTraining();
+
+    stepped.addStep(64, 1, true);
+    restarted.beginLearnFromOutcome(64, 1, true);
+    bool restartedPass = stepped.cursor().epoch == 0 &&
+                         stepped.remainingSteps() == restarted.remainingSteps();
+    stepped.finishTraining();
+    restarted.finishTraining();
+
+    int agree = 0;
+    for (int16_t last : {0, 64, 127}) {
+        uint8_t a1, b1, a2, b2;
+        stepped.getScores(last, a1, b1);
+        restarted.getScores(last, a2, b2);
+        agree += a1 == a2 && b1 == b2;
+    }
+
+    bool pass = midPass && restartedPass && agree == 3;
+    printf("  Pass restarted: %s, scores agree: %d/3  %s\n\n", restartedPass ? "yes" : "no",
+           agree, pass ? "PASS" : "FAIL");
+    return pass;
+}
+
 //=============================================================================
 // Main
 //=============================================================================
@@ -259,13 +535,19 @@ int main() {
     printf("==================================================\n\n");
 
     int passed = 0;
-    int total = 5;
+    int total = 11;
 
     if (testGeneralization()) passed++;
     if (testFeatureSelection()) passed++;
     if (testXOR()) passed++;
     if (testSequence()) passed++;
     if (testComposition()) passed++;
+    if (testInterruptibleTraining()) passed++;
+    if (testFloatBackend()) passed++;
+    if (testDecisionHeatmap()) passed++;
+    if (testEvolvedBackend()) passed++;
+    if (testLearnBatch()) passed++;
+    if (testStepDuringPass()) passed++;
 
     printf("==================================================\n");
     printf("Results: %d/%d passed\n", passed, total);
@@ -0,0 +1,259 @@
+/**
+ * Population runner implementation for enen Demo
+ */
+
+#include "population.hpp"
+#include "game.hpp"
+#include "metrics.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace enen {
+
+//=============================================================================
+// Topology
+//=============================================================================
+namespace topology {
+
+#ifdef __linux__
+
+// Parse a sysfs cpulist such as "0-3,8-11"
+static bool cpuListContains(const char* path, int cpu) {
+    FILE* f = std::fopen(path, "r");
+    if (!f) return false;
+
+    bool found = false;
+    int lo = 0;
+    int hi = 0;
+    char sep = 0;
+    while (!found && std::fscanf(f, "%d", &lo) == 1) {
+        hi = lo;
+        if (std::fscanf(f, "%c", &sep) == 1 && sep == '-') {
+            if (std::fscanf(f, "%d", &hi) != 1) break;
+            std::fscanf(f, "%c", &sep);  // Trailing ',' or newline
+        }
+        found = cpu >= lo && cpu <= hi;
+    }
+    std::fclose(f);
+    return found;
+}
+
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty()) cpus.push_back(0);
+    return cpus;
+}
+
+// Numbers of the nodes present, ascending (may have gaps, e.g. 0 and 2)
+static std::vector<int> nodeIds() {
+    std::vector<int> ids;
+    DIR* dir = opendir("/sys/devices/system/node");
+    if (!dir) return ids;
+    while (dirent* entry = readdir(dir)) {
+        int id = 0;
+        char tail = 0;
+        if (std::sscanf(entry->d_name, "node%d%c", &id, &tail) == 1) ids.push_back(id);
+    }
+    closedir(dir);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+int nodeCount() {
+    int count = static_cast<int>(nodeIds().size());
+    return count > 0 ? count : 1;
+}
+
+int nodeOfCpu(int cpu) {
+    char path[64];
+    for (int node : nodeIds()) {
+        std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        if (cpuListContains(path, cpu)) return node;
+    }
+    return 0;
+}
+
+bool pinCurrentThread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+#else
+
+std::vector<int> allowedCpus() {
+    unsigned n = std::thread::hardware_concurrency();
+    std::vector<int> cpus;
+    for (unsigned i = 0; i < (n > 0 ? n : 1); i++) cpus.push_back(static_cast<int>(i));
+    return cpus;
+}
+
+int nodeCount() { return 1; }
+int nodeOfCpu(int) { return 0; }
+bool pinCurrentThread(int) { return false; }
+
+#endif
+
+} // namespace topology
+
+//=============================================================================
+// PopulationRunner
+//=============================================================================
+namespace {
+
+// Per-worker results. Cache-line aligned so workers never share a line.
+struct alignas(64) WorkerStats {
+    int cpu = 0;
+    int node = 0;
+    int creatures = 0;
+    int completed = 0;
+    long trials = 0;
+    double seconds = 0;
+    bool pinned = false;
+};
+
+// Trials one creature ran, and whether it mastered all five puzzles
+struct CreatureRun {
+    long trials = 0;
+    bool completed = false;
+};
+
+// Run all five puzzles, counting trials. A creature that gives up on a
+// puzzle ran maxTrialsPerPuzzle trials of it and stops there.
+CreatureRun runCreature(Game& game, int maxTrialsPerPuzzle) {
+    CreatureRun run;
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        int t = game.runPuzzleToCompletion(maxTrialsPerPuzzle);
+        if (t < 0) {
+            run.trials += maxTrialsPerPuzzle;
+            return run;
+        }
+        run.trials += t;
+        if (p < NUM_PUZZLES - 1) game.nextPuzzle();
+    }
+    run.completed = true;
+    return run;
+}
+
+void runWorker(const PopulationConfig& config, int first, int count,
+               int cpu, int node, bool pin, metrics::Segment* live, int index, WorkerStats& out) {
+    WorkerStats stats;
+    stats.cpu = cpu;
+    stats.node = node;
+    stats.creatures = count;
+    stats.pinned = pin && topology::pinCurrentThread(cpu);
+
+    // Construct the shard only after pinning: first touch places every
+    // network, history and RNG of this shard, and its metrics counters,
+    // on the worker's node.
+    metrics::Shard* counters = nullptr;
+    if (live) {
+        counters = live->initShard(static_cast<uint32_t>(index),
+                                   static_cast<uint64_t>(config.frameBudgetMs * 1e6));
+    }
+    std::vector<std::unique_ptr<Game>> shard;
+    shard.reserve(count);
+    for (int i = 0; i < count; i++) {
+        shard.push_back(std::make_unique<Game>(config.baseSeed + first + i));
+        shard.back()->setMetrics(counters);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto& game : shard) {
+        CreatureRun run = runCreature(*game, config.maxTrialsPerPuzzle);
+        stats.trials += run.trials;
+        stats.completed += run.completed;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    out = stats;  // Single write to shared memory, after the hot loop
+}
+
+} // anonymous namespace
+
+PopulationReport PopulationRunner::run() {
+    // Each CPU's node, read from sysfs once. Ordered by node so
+    // consecutive workers fill one node at a time.
+    struct Placement {
+        int cpu;
+        int node;
+    };
+    std::vector<Placement> cpus;
+    for (int cpu : topology::allowedCpus()) cpus.push_back({cpu, topology::nodeOfCpu(cpu)});
+    std::stable_sort(cpus.begin(), cpus.end(),
+                     [](const Placement& a, const Placement& b) { return a.node < b.node; });
+
+    int threads = config_.threads > 0 ? config_.threads : static_cast<int>(cpus.size());
+    threads = std::max(1, std::min(threads, config_.creatures));
+
+    // Live metrics: one shard per worker
+    metrics::Segment live;
+    bool shared = false;
+    if (!config_.metricsName.empty()) {
+        shared = live.create(config_.metricsName, static_cast<uint32_t>(threads), "enen-population");
+    }
+
+    std::vector<WorkerStats> stats(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    auto start = std::chrono::steady_clock::now();
+    int first = 0;
+    for (int t = 0; t < threads; t++) {
+        int count = config_.creatures / threads + (t < config_.creatures % threads ? 1 : 0);
+        const Placement& where = cpus[t % cpus.size()];
+        workers.emplace_back(runWorker, std::cref(config_), first, count, where.cpu, where.node,
+                             config_.pinThreads, live.valid() ? &live : nullptr, t,
+                             std::ref(stats[t]));
+        first += count;
+    }
+    for (auto& w : workers) w.join();
+    live.finish();
+
+    PopulationReport report;
+    report.metricsShared = shared;
+    report.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.pinned = config_.pinThreads;
+
+    // Indexed by node number, which may skip values
+    int highestNode = 0;
+    for (const auto& s : stats) highestNode = std::max(highestNode, s.node);
+    std::vector<NodeStats> byNode(highestNode + 1);
+    for (size_t n = 0; n < byNode.size(); n++) byNode[n].node = static_cast<int>(n);
+
+    for (const auto& s : stats) {
+        NodeStats& node = byNode[s.node];
+        node.threads++;
+        node.creatures += s.creatures;
+        node.completed += s.completed;
+        node.trials += s.trials;
+        node.busySeconds = std::max(node.busySeconds, s.seconds);
+
+        report.totalTrials += s.trials;
+        report.completed += s.completed;
+        if (!s.pinned) report.pinned = false;
+    }
+    for (const auto& node : byNode) {
+        if (node.threads > 0) report.nodes.push_back(node);
+    }
+    return report;
+}
+
+} // namespace enen
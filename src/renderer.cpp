@@ -4,23 +4,14 @@
  */
 
 #include "renderer.hpp"
+#include "brain_diagram.hpp"
+#include "layout.hpp"
 #include <cstdio>
 #include <cstring>
 #include <algorithm>
 
 namespace enen {
 
-//=============================================================================
-// TrialHistory
-//=============================================================================
-
-void TrialHistory::add(int trial_num, bool correct, const std::string& summary) {
-    entries_.push_back({trial_num, correct, summary});
-    while (entries_.size() > MAX_ENTRIES) {
-        entries_.erase(entries_.begin());
-    }
-}
-
 //=============================================================================
 // Renderer - Setup
 //=============================================================================
@@ -53,38 +44,39 @@ void Renderer::clear() {
 //=============================================================================
 
 void Renderer::clearBuffer() {
-    for (int y = 0; y < TERM_HEIGHT; y++) {
-        memset(buffer_[y], ' ', TERM_WIDTH);
-        buffer_[y][TERM_WIDTH] = '\0';
-    }
+    buffer_.clear();
 }
 
 void Renderer::putString(int x, int y, const char* str) {
-    if (y < 0 || y >= TERM_HEIGHT) return;
-    int len = strlen(str);
-    for (int i = 0; i < len && x + i < TERM_WIDTH; i++) {
-        if (x + i >= 0) {
-            buffer_[y][x + i] = str[i];
-        }
-    }
+    buffer_.putString(x, y, str);
 }
 
 void Renderer::putChar(int x, int y, char c) {
-    if (y >= 0 && y < TERM_HEIGHT && x >= 0 && x < TERM_WIDTH) {
-        buffer_[y][x] = c;
-    }
+    buffer_.putChar(x, y, c);
 }
 
 void Renderer::drawHLine(int x, int y, int len, char c) {
-    for (int i = 0; i < len; i++) {
-        putChar(x + i, y, c);
-    }
+    buffer_.drawHLine(x, y, len, c);
 }
 
 void Renderer::flush() {
+    if (hold_) {
+        pending_ = true;  // Composed; written by present()
+        return;
+    }
+    present();
+}
+
+void Renderer::drawFrame(const TextBuffer& frame) {
+    buffer_ = frame;
+    flush();
+}
+
+void Renderer::present() {
+    pending_ = false;
     printf("\033[H");  // Home cursor
     for (int y = 0; y < TERM_HEIGHT; y++) {
-        printf("%s\n", buffer_[y]);
+        printf("%s\n", buffer_.line(y));
     }
     fflush(stdout);
 }
@@ -106,24 +98,19 @@ void Renderer::drawProgressBar(int x, int y, int width, int value, int max) {
 void Renderer::drawHeader(const char* puzzleName, const char* rule,
                           const IntgrNNWrapper& net, const char* arch,
                           int successes, int required) {
-    char buf[TERM_WIDTH + 1];
-
     // Line 0: Title
-    snprintf(buf, sizeof(buf), "ENEN DEMO: %s", puzzleName);
-    putString(0, 0, buf);
+    text::put(buffer_, 0, 0, ENEN_FORMAT("ENEN DEMO: {}"), puzzleName);
 
     // Line 1: Separator (left side only, brain box goes on right)
     drawHLine(0, 1, 38, '=');
 
     // Line 2: Rule
-    snprintf(buf, sizeof(buf), "Rule: %s", rule);
-    putString(0, 2, buf);
+    text::put(buffer_, 0, 2, ENEN_FORMAT("Rule: {}"), rule);
 
     // Line 3: Progress
     putString(0, 3, "Progress: ");
     drawProgressBar(10, 3, 10, successes, required);
-    snprintf(buf, sizeof(buf), " %d/%d", successes, required);
-    putString(23, 3, buf);
+    text::put(buffer_, 23, 3, ENEN_FORMAT(" {}/{}"), successes, required);
 
     // Line 4: Separator (left side only)
     drawHLine(0, 4, 38, '-');
@@ -135,35 +122,28 @@ void Renderer::drawHeader(const char* puzzleName, const char* rule,
 void Renderer::drawGauntletHeader(const char* puzzleName, const char* rule,
                                    const IntgrNNWrapper& net, const char* arch,
                                    const GauntletState& gauntlet) {
-    char buf[TERM_WIDTH + 1];
-
     // Line 0: Title
-    snprintf(buf, sizeof(buf), "ENEN DEMO: %s", puzzleName);
-    putString(0, 0, buf);
+    text::put(buffer_, 0, 0, ENEN_FORMAT("ENEN DEMO: {}"), puzzleName);
 
     // Line 1: Separator (left side only)
     drawHLine(0, 1, 38, '=');
 
     // Line 2: Rule
-    snprintf(buf, sizeof(buf), "Rule: %s", rule);
-    putString(0, 2, buf);
+    text::put(buffer_, 0, 2, ENEN_FORMAT("Rule: {}"), rule);
 
     // Line 3: Phase info
     if (gauntlet.inWarmup()) {
-        snprintf(buf, sizeof(buf), "Phase: WARMUP %d/%d",
-                 gauntlet.warmup_completed, GauntletState::WARMUP_TRIALS);
+        text::put(buffer_, 0, 3, ENEN_FORMAT("Phase: WARMUP {}/{}"),
+                  gauntlet.warmup_completed, GauntletState::WARMUP_TRIALS);
     } else {
-        snprintf(buf, sizeof(buf), "Phase: SCORED %d/%d",
-                 gauntlet.scored_completed, GauntletState::SCORED_TRIALS);
+        text::put(buffer_, 0, 3, ENEN_FORMAT("Phase: SCORED {}/{}"),
+                  gauntlet.scored_completed, gauntlet.scoredLimit());
     }
-    putString(0, 3, buf);
 
     // Line 4: Score (only if in scored phase)
     if (!gauntlet.inWarmup()) {
-        snprintf(buf, sizeof(buf), "Score: %d/%d (%d%%)",
-                 gauntlet.correct, gauntlet.scored_completed,
-                 gauntlet.scorePercent());
-        putString(0, 4, buf);
+        text::put(buffer_, 0, 4, ENEN_FORMAT("Score: {}/{} ({}%)"),
+                  gauntlet.correct, gauntlet.scored_completed, gauntlet.scorePercent());
     }
 
     // Line 5: Separator (left side only)
@@ -173,22 +153,12 @@ void Renderer::drawGauntletHeader(const char* puzzleName, const char* rule,
     (void)arch;
 }
 
-void Renderer::drawHistory(const TrialHistory& history, int startY) {
+void Renderer::drawHistory(const History& history, int startY) {
     putString(0, startY, "HISTORY:");
-    const auto& entries = history.entries();
-
-    // Show most recent first (reverse order)
-    for (size_t i = 0; i < entries.size() && (int)(startY + 1 + i) < TERM_HEIGHT - 2; i++) {
-        size_t idx = entries.size() - 1 - i;
-        const auto& e = entries[idx];
-        char buf[TERM_WIDTH + 1];
-        snprintf(buf, sizeof(buf), "  Trial %d: %s %s",
-                 e.trial_num,
-                 e.correct ? "[OK]" : "[X]",
-                 e.summary.c_str());
-        // Truncate if too long
-        if (strlen(buf) > 50) buf[50] = '\0';
-        putString(0, startY + 1 + i, buf);
+
+    // Show most recent first; lines are preformatted to fit
+    for (size_t i = 0; i < history.size() && (int)(startY + 1 + i) < TERM_HEIGHT - 2; i++) {
+        buffer_.blit(0, startY + 1 + (int)i, history.line(i), history.lineLength(i));
     }
 }
 
@@ -279,21 +249,17 @@ void Renderer::drawLightAndPaths(int boxX, int boxY, bool lightOn) {
 }
 
 void Renderer::drawButtons(int boxX, int boxY, int16_t scoreA, int16_t scoreB) {
-    char buf[16];
-
     // Button A
     putString(boxX + 2, boxY + 1, "+-+");
     putString(boxX + 2, boxY + 2, "|A|");
     putString(boxX + 2, boxY + 3, "+-+");
-    snprintf(buf, sizeof(buf), "%3d", scoreA);
-    putString(boxX + 2, boxY + 4, buf);
+    text::put(buffer_, boxX + 2, boxY + 4, ENEN_FORMAT("{:3}"), scoreA);
 
     // Button B
     putString(boxX + 8, boxY + 1, "+-+");
     putString(boxX + 8, boxY + 2, "|B|");
     putString(boxX + 8, boxY + 3, "+-+");
-    snprintf(buf, sizeof(buf), "%3d", scoreB);
-    putString(boxX + 8, boxY + 4, buf);
+    text::put(buffer_, boxX + 8, boxY + 4, ENEN_FORMAT("{:3}"), scoreB);
 }
 
 void Renderer::drawLightAndSizes(int boxX, int boxY, bool lightOn, int16_t sizeA, int16_t sizeB) {
@@ -323,21 +289,24 @@ void Renderer::drawLightAndSizes(int boxX, int boxY, bool lightOn, int16_t sizeA
     putChar(boxX + 9, boxY + 6, 'B');
 }
 
-void Renderer::drawBrainBox(int x, int y, PuzzleType puzzleType, size_t modelBytes) {
-    char line[50];
-
+void Renderer::drawBrainBox(int x, int y, PuzzleType puzzleType, size_t modelBytes,
+                            const ForwardTrace* trace) {
     // Top border and title
     putString(x, y, "+---------------------------------------+");
 
-    snprintf(line, sizeof(line), "| enen's brain (%zu bytes)", modelBytes);
     // Pad to fit the box width
-    int len = strlen(line);
-    while (len < 40) line[len++] = ' ';
-    line[40] = '|';
-    line[41] = '\0';
-    putString(x, y + 1, line);
-
-    putString(x, y + 2, "|                                       |");
+    int end = text::put(buffer_, x, y + 1, ENEN_FORMAT("| enen's brain ({} bytes)"), modelBytes);
+    drawHLine(end, y + 1, x + 40 - end, ' ');
+    putChar(x + 40, y + 1, '|');
+
+    // Activity of the last decision (lights up as enen thinks)
+    if (trace && trace->valid()) {
+        char activity[42];
+        formatActivityLine(activity, *trace);
+        putString(x, y + 2, activity);
+    } else {
+        putString(x, y + 2, "|                                       |");
+    }
     putString(x, y + 3, "| SEES         THINKS        DECIDES    |");
     putString(x, y + 4, "|                                       |");
 
@@ -400,7 +369,7 @@ void Renderer::drawCompletionMessage(int y, PuzzleType type, int gauntletScore,
             message = "enen learned: circles safe, blue squares best.";
             break;
         case PuzzleType::XOR_CONTEXT:
-            message = "enen learned: the light changes which path is safe.";
+            message = "enen learned: light flips the safe path.";
             break;
         case PuzzleType::SEQUENCE:
             message = "enen learned: A first, then B.";
@@ -414,10 +383,8 @@ void Renderer::drawCompletionMessage(int y, PuzzleType type, int gauntletScore,
 
     // For puzzle 5, also show final score
     if (type == PuzzleType::COMPOSITION && gauntletTotal > 0) {
-        char scoreLine[40];
-        snprintf(scoreLine, sizeof(scoreLine), "Final score: %d/%d (%d%%)",
-                 gauntletScore, gauntletTotal, (gauntletScore * 100) / gauntletTotal);
-        putString(0, y + 1, scoreLine);
+        text::put(buffer_, 0, y + 1, ENEN_FORMAT("Final score: {}/{} ({}%)"),
+                  gauntletScore, gauntletTotal, (gauntletScore * 100) / gauntletTotal);
     }
 }
 
@@ -427,7 +394,7 @@ void Renderer::drawCompletionMessage(int y, PuzzleType type, int gauntletScore,
 
 void Renderer::drawPuzzle1(const MushroomTrial& trial, const GeneralizationNet& net,
                            bool choseA, bool correct,
-                           const TrialHistory& history, int trial_num,
+                           const History& history, int trial_num,
                            int successes, int required,
                            bool showContinue) {
     clearBuffer();
@@ -435,32 +402,27 @@ void Renderer::drawPuzzle1(const MushroomTrial& trial, const GeneralizationNet&
     drawHeader("SIZE", "Bigger is safe. Ignore color.",
                net, "4->8->1", successes, required);
 
-    char buf[TERM_WIDTH + 1];
-
     // Brain box (right side)
-    drawBrainBox(39, 0, PuzzleType::GENERALIZATION, net.modelSizeBytes());
+    ForwardTrace trace = net.lastForward();
+    drawBrainBox(39, 0, PuzzleType::GENERALIZATION, net.modelSizeBytes(), &trace);
+    heatmap_.update(net, trial.colorA, trial.colorB);
+    heatmap_.draw(buffer_, layout::heatmap::X, layout::heatmap::Y);
 
     // Trial section (line 6-11)
-    snprintf(buf, sizeof(buf), "TRIAL %d:", trial_num);
-    putString(0, 6, buf);
+    text::put(buffer_, 0, 6, ENEN_FORMAT("TRIAL {}:"), trial_num);
 
-    snprintf(buf, sizeof(buf), "  [A] %s, size %d",
-             MushroomTrial::colorName(trial.colorA), trial.sizeA);
-    putString(0, 7, buf);
-    snprintf(buf, sizeof(buf), "  [B] %s, size %d",
-             MushroomTrial::colorName(trial.colorB), trial.sizeB);
-    putString(0, 8, buf);
+    text::put(buffer_, 0, 7, ENEN_FORMAT("  [A] {}, size {}"),
+              MushroomTrial::colorName(trial.colorA), trial.sizeA);
+    text::put(buffer_, 0, 8, ENEN_FORMAT("  [B] {}, size {}"),
+              MushroomTrial::colorName(trial.colorB), trial.sizeB);
 
     // Use passed choseA (what network chose BEFORE learning)
     bool aIsLarger = trial.sizeA > trial.sizeB;
-    snprintf(buf, sizeof(buf), "  Pick: %c (%s)",
-             choseA ? 'A' : 'B',
-             (choseA == aIsLarger) ? "larger" : "smaller");
-    putString(0, 9, buf);
+    text::put(buffer_, 0, 9, ENEN_FORMAT("  Pick: {} ({})"),
+              choseA ? 'A' : 'B', (choseA == aIsLarger) ? "larger" : "smaller");
 
     // Use passed correct (computed BEFORE learning)
-    snprintf(buf, sizeof(buf), "  %s", correct ? "[OK] CORRECT" : "[X] WRONG");
-    putString(0, 10, buf);
+    text::put(buffer_, 0, 10, ENEN_FORMAT("  {}"), correct ? "[OK] CORRECT" : "[X] WRONG");
 
     // Separator
     drawHLine(0, 12, 38, '-');
@@ -482,7 +444,7 @@ void Renderer::drawPuzzle1(const MushroomTrial& trial, const GeneralizationNet&
 
 void Renderer::drawPuzzle2(const ShapeTrial& trial, const FeatureSelectionNet& net,
                            bool choseA, bool correct,
-                           const TrialHistory& history, int trial_num,
+                           const History& history, int trial_num,
                            int successes, int required,
                            bool showContinue) {
     clearBuffer();
@@ -490,30 +452,23 @@ void Renderer::drawPuzzle2(const ShapeTrial& trial, const FeatureSelectionNet& n
     drawHeader("EXCEPTIONS", "Circle safe. Blue square best.",
                net, "4->8->1", successes, required);
 
-    char buf[TERM_WIDTH + 1];
-
     // Brain box (right side)
-    drawBrainBox(39, 0, PuzzleType::FEATURE_SELECTION, net.modelSizeBytes());
+    ForwardTrace trace = net.lastForward();
+    drawBrainBox(39, 0, PuzzleType::FEATURE_SELECTION, net.modelSizeBytes(), &trace);
 
     // Trial section
-    snprintf(buf, sizeof(buf), "TRIAL %d:", trial_num);
-    putString(0, 6, buf);
+    text::put(buffer_, 0, 6, ENEN_FORMAT("TRIAL {}:"), trial_num);
 
-    snprintf(buf, sizeof(buf), "  [A] %s %s",
-             ShapeTrial::colorName(trial.colorA), ShapeTrial::shapeName(trial.shapeA));
-    putString(0, 7, buf);
-    snprintf(buf, sizeof(buf), "  [B] %s %s",
-             ShapeTrial::colorName(trial.colorB), ShapeTrial::shapeName(trial.shapeB));
-    putString(0, 8, buf);
+    text::put(buffer_, 0, 7, ENEN_FORMAT("  [A] {} {}"),
+              ShapeTrial::colorName(trial.colorA), ShapeTrial::shapeName(trial.shapeA));
+    text::put(buffer_, 0, 8, ENEN_FORMAT("  [B] {} {}"),
+              ShapeTrial::colorName(trial.colorB), ShapeTrial::shapeName(trial.shapeB));
 
     // Use passed choseA (what network chose BEFORE learning)
     int16_t pickedColor = choseA ? trial.colorA : trial.colorB;
     int16_t pickedShape = choseA ? trial.shapeA : trial.shapeB;
-    snprintf(buf, sizeof(buf), "  Pick: %c (%s %s)",
-             choseA ? 'A' : 'B',
-             ShapeTrial::colorName(pickedColor),
-             ShapeTrial::shapeName(pickedShape));
-    putString(0, 9, buf);
+    text::put(buffer_, 0, 9, ENEN_FORMAT("  Pick: {} ({} {})"),
+              choseA ? 'A' : 'B', ShapeTrial::colorName(pickedColor), ShapeTrial::shapeName(pickedShape));
 
     // Use passed correct (computed BEFORE learning)
     if (correct) {
@@ -546,7 +501,7 @@ void Renderer::drawPuzzle2(const ShapeTrial& trial, const FeatureSelectionNet& n
 
 void Renderer::drawPuzzle3(const XORTrial& trial, const XORNet& net,
                            bool predictedSafe, bool correct,
-                           const TrialHistory& history, int trial_num,
+                           const History& history, int trial_num,
                            int successes, int required,
                            bool showContinue) {
     clearBuffer();
@@ -554,30 +509,25 @@ void Renderer::drawPuzzle3(const XORTrial& trial, const XORNet& net,
     drawHeader("CONTEXT", "ON=left, OFF=right.",
                net, "2->4->1", successes, required);
 
-    char buf[TERM_WIDTH + 1];
-
     // Brain box (right side)
-    drawBrainBox(39, 0, PuzzleType::XOR_CONTEXT, net.modelSizeBytes());
+    ForwardTrace trace = net.lastForward();
+    drawBrainBox(39, 0, PuzzleType::XOR_CONTEXT, net.modelSizeBytes(), &trace);
+    heatmap_.update(net);
+    heatmap_.draw(buffer_, layout::heatmap::X, layout::heatmap::Y);
 
     // Trial section
-    snprintf(buf, sizeof(buf), "TRIAL %d:", trial_num);
-    putString(0, 6, buf);
+    text::put(buffer_, 0, 6, ENEN_FORMAT("TRIAL {}:"), trial_num);
 
     // Show the scenario being tested
-    snprintf(buf, sizeof(buf), "  Scenario: Light %s, Path %s",
-             trial.lightOn ? "ON" : "OFF",
-             trial.choosingRight ? "RIGHT" : "LEFT");
-    putString(0, 7, buf);
+    text::put(buffer_, 0, 7, ENEN_FORMAT("  Scenario: Light {}, Path {}"),
+              trial.lightOn ? "ON" : "OFF", trial.choosingRight ? "RIGHT" : "LEFT");
 
     // What enen predicted about safety
-    snprintf(buf, sizeof(buf), "  enen predicts: %s", predictedSafe ? "SAFE" : "DANGER");
-    putString(0, 8, buf);
+    text::put(buffer_, 0, 8, ENEN_FORMAT("  enen predicts: {}"), predictedSafe ? "SAFE" : "DANGER");
 
     // Reality and whether prediction was correct
-    snprintf(buf, sizeof(buf), "  Reality: %s — %s",
-             trial.isSafe ? "SAFE" : "DANGER",
-             correct ? "[OK] Correct!" : "[X] Wrong!");
-    putString(0, 9, buf);
+    text::put(buffer_, 0, 9, ENEN_FORMAT("  Reality: {} — {}"),
+              trial.isSafe ? "SAFE" : "DANGER", correct ? "[OK] Correct!" : "[X] Wrong!");
 
     // Separator and history
     drawHLine(0, 11, 38, '-');
@@ -596,7 +546,7 @@ void Renderer::drawPuzzle3(const XORTrial& trial, const XORNet& net,
 }
 
 void Renderer::drawPuzzle4(const SequencePuzzle& puzzle, const SequenceNet& net,
-                           const TrialHistory& history, int trial_num,
+                           const History& history, int trial_num,
                            int successes, int required,
                            bool showContinue) {
     clearBuffer();
@@ -604,14 +554,12 @@ void Renderer::drawPuzzle4(const SequencePuzzle& puzzle, const SequenceNet& net,
     drawHeader("ORDER", "A first, then B.",
                net, "1->4->2", successes, required);
 
-    char buf[TERM_WIDTH + 1];
-
     // Brain box (right side)
-    drawBrainBox(39, 0, PuzzleType::SEQUENCE, net.modelSizeBytes());
+    ForwardTrace trace = net.lastForward();
+    drawBrainBox(39, 0, PuzzleType::SEQUENCE, net.modelSizeBytes(), &trace);
 
     // Trial section
-    snprintf(buf, sizeof(buf), "TRIAL %d:", trial_num);
-    putString(0, 6, buf);
+    text::put(buffer_, 0, 6, ENEN_FORMAT("TRIAL {}:"), trial_num);
 
     // State
     const char* stateStr = "Ready";
@@ -621,19 +569,16 @@ void Renderer::drawPuzzle4(const SequencePuzzle& puzzle, const SequenceNet& net,
         case SequenceState::SUCCESS: stateStr = "SUCCESS!"; break;
         case SequenceState::FAIL: stateStr = "FAIL!"; break;
     }
-    snprintf(buf, sizeof(buf), "  State: %s", stateStr);
-    putString(0, 7, buf);
+    text::put(buffer_, 0, 7, ENEN_FORMAT("  State: {}"), stateStr);
 
     // Scores
     int16_t scoreA = net.scoreA(puzzle.lastActionInput());
     int16_t scoreB = net.scoreB(puzzle.lastActionInput());
-    snprintf(buf, sizeof(buf), "  Scores: A=%d  B=%d", scoreA, scoreB);
-    putString(0, 8, buf);
+    text::put(buffer_, 0, 8, ENEN_FORMAT("  Scores: A={}  B={}"), scoreA, scoreB);
 
     // What enen will do
     int action = const_cast<SequenceNet&>(net).chooseAction(puzzle.lastActionInput());
-    snprintf(buf, sizeof(buf), "  Pick: %c", action == 0 ? 'A' : 'B');
-    putString(0, 9, buf);
+    text::put(buffer_, 0, 9, ENEN_FORMAT("  Pick: {}"), action == 0 ? 'A' : 'B');
 
     // Result based on state
     if (puzzle.isSuccess()) {
@@ -662,43 +607,36 @@ void Renderer::drawPuzzle4(const SequencePuzzle& puzzle, const SequenceNet& net,
 
 void Renderer::drawPuzzle5(const CompositionTrial& trial, const CompositionNet& net,
                            bool choseA, bool correct,
-                           const TrialHistory& history, const GauntletState& gauntlet,
+                           const History& history, const GauntletState& gauntlet,
                            bool showContinue) {
     clearBuffer();
 
     drawGauntletHeader("EVERYTHING", "ON=bigger, OFF=smaller.",
                        net, "3->8->4->1", gauntlet);
 
-    char buf[TERM_WIDTH + 1];
-
     // Brain box (right side)
-    drawBrainBox(39, 0, PuzzleType::COMPOSITION, net.modelSizeBytes());
+    ForwardTrace trace = net.lastForward();
+    drawBrainBox(39, 0, PuzzleType::COMPOSITION, net.modelSizeBytes(), &trace);
+    heatmap_.update(net, trial.lightInput());
+    heatmap_.draw(buffer_, layout::heatmap::X, layout::heatmap::Y);
 
     // Trial section
     int trialNum = gauntlet.currentTrials();
-    snprintf(buf, sizeof(buf), "TRIAL %d:", trialNum);
-    putString(0, 7, buf);
+    text::put(buffer_, 0, 7, ENEN_FORMAT("TRIAL {}:"), trialNum);
 
-    snprintf(buf, sizeof(buf), "  Light: %s -> pick %s",
-             trial.lightOn ? "ON" : "OFF",
-             trial.lightOn ? "LARGER" : "SMALLER");
-    putString(0, 8, buf);
+    text::put(buffer_, 0, 8, ENEN_FORMAT("  Light: {} -> pick {}"),
+              trial.lightOn ? "ON" : "OFF", trial.lightOn ? "LARGER" : "SMALLER");
 
-    snprintf(buf, sizeof(buf), "  [A] size %d", trial.sizeA);
-    putString(0, 9, buf);
-    snprintf(buf, sizeof(buf), "  [B] size %d", trial.sizeB);
-    putString(0, 10, buf);
+    text::put(buffer_, 0, 9, ENEN_FORMAT("  [A] size {}"), trial.sizeA);
+    text::put(buffer_, 0, 10, ENEN_FORMAT("  [B] size {}"), trial.sizeB);
 
     // Use passed choseA (what network chose BEFORE learning)
     bool aIsLarger = trial.sizeA > trial.sizeB;
-    snprintf(buf, sizeof(buf), "  Pick: %c (%s)",
-             choseA ? 'A' : 'B',
-             (choseA ? aIsLarger : !aIsLarger) ? "larger" : "smaller");
-    putString(0, 11, buf);
+    text::put(buffer_, 0, 11, ENEN_FORMAT("  Pick: {} ({})"),
+              choseA ? 'A' : 'B', (choseA ? aIsLarger : !aIsLarger) ? "larger" : "smaller");
 
     // Use passed correct (computed BEFORE learning)
-    snprintf(buf, sizeof(buf), "  %s", correct ? "[OK] CORRECT" : "[X] WRONG");
-    putString(0, 12, buf);
+    text::put(buffer_, 0, 12, ENEN_FORMAT("  {}"), correct ? "[OK] CORRECT" : "[X] WRONG");
 
     // Separator and history
     drawHLine(0, 14, 38, '-');
@@ -707,7 +645,7 @@ void Renderer::drawPuzzle5(const CompositionTrial& trial, const CompositionNet&
     // Completion message if done
     if (showContinue) {
         drawCompletionMessage(19, PuzzleType::COMPOSITION,
-                              gauntlet.correct, GauntletState::SCORED_TRIALS);
+                              gauntlet.correct, gauntlet.scoredLimit());
     }
 
     // Controls
@@ -733,9 +671,7 @@ void Renderer::drawIntro(size_t totalModelBytes) {
     putString(10, 8, "weights. It will learn each puzzle from scratch by trying,");
     putString(10, 9, "failing, and updating its brain.");
 
-    char buf[64];
-    snprintf(buf, sizeof(buf), "The entire brain fits in %zu bytes.", totalModelBytes);
-    putString(10, 11, buf);
+    text::put(buffer_, 10, 11, ENEN_FORMAT("The entire brain fits in {} bytes."), totalModelBytes);
     putString(10, 12, "No cloud. No pre-training. Just learning.");
 
     putString(10, 14, "Each puzzle teaches a different concept:");
@@ -765,14 +701,10 @@ void Renderer::drawVictory(size_t totalModelBytes, int gauntletScore, int gauntl
     putString(14, 12, "Puzzle 4: Order matters (A then B)");
     putString(14, 13, "Puzzle 5: Combine skills (context + comparison)");
 
-    char buf[64];
-    snprintf(buf, sizeof(buf), "Final gauntlet score: %d/%d (%d%%)",
-             gauntletScore, gauntletTotal,
-             gauntletTotal > 0 ? (gauntletScore * 100) / gauntletTotal : 0);
-    putString(20, 15, buf);
+    text::put(buffer_, 20, 15, ENEN_FORMAT("Final gauntlet score: {}/{} ({}%)"),
+              gauntletScore, gauntletTotal, gauntletTotal > 0 ? (gauntletScore * 100) / gauntletTotal : 0);
 
-    snprintf(buf, sizeof(buf), "Total brain size: %zu bytes", totalModelBytes);
-    putString(20, 17, buf);
+    text::put(buffer_, 20, 17, ENEN_FORMAT("Total brain size: {} bytes"), totalModelBytes);
     putString(20, 18, "All learning happened live. No pre-training.");
 
     putString(30, 21, "Press [Q] to exit");
@@ -0,0 +1,446 @@
+/**
+ * Multi-process seed sweep implementation for enen Demo
+ */
+
+#include "sweep.hpp"
+#include "game.hpp"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <utility>
+
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace enen {
+namespace sweep {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Header {
+    MessageType type;
+    uint32_t size;
+};
+
+struct Hello {
+    int32_t pid = 0;
+};
+
+//=============================================================================
+// Framing
+//=============================================================================
+bool sendAll(int fd, const void* data, size_t size) {
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+template <class T>
+bool sendMessage(int fd, MessageType type, const T& payload) {
+    char frame[sizeof(Header) + sizeof(T)];
+    Header header{type, static_cast<uint32_t>(sizeof(T))};
+    std::memcpy(frame, &header, sizeof(header));
+    std::memcpy(frame + sizeof(header), &payload, sizeof(T));
+    return sendAll(fd, frame, sizeof(frame));
+}
+
+bool sendEmpty(int fd, MessageType type) {
+    Header header{type, 0};
+    return sendAll(fd, &header, sizeof(header));
+}
+
+// Blocking read of exactly `size` bytes (worker side). False on EOF/error.
+bool readAll(int fd, void* data, size_t size) {
+    char* p = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t n = ::read(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+//=============================================================================
+// Coordinator bookkeeping
+//=============================================================================
+struct Range {
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+struct Connection {
+    int fd = -1;
+    int pid = 0;
+    bool forked = false;
+    bool busy = false;
+    Range range;
+    std::string buffer;  // Partial messages
+    Clock::time_point lastHeard;
+    size_t stats = 0;    // Index into SweepReport::workers
+};
+
+} // anonymous namespace
+
+//=============================================================================
+// SweepReport
+//=============================================================================
+double SweepReport::meanTrials(PuzzleType puzzle) const {
+    int p = static_cast<int>(puzzle);
+    double sum = 0.0;
+    int n = 0;
+    for (const auto& r : results) {
+        if (r.trials[p] > 0) {
+            sum += r.trials[p];
+            n++;
+        }
+    }
+    return n > 0 ? sum / n : 0.0;
+}
+
+int SweepReport::completed() const {
+    int n = 0;
+    for (const auto& r : results) n += r.completed;
+    return n;
+}
+
+//=============================================================================
+// Worker
+//=============================================================================
+int runWorker(int fd) {
+    Hello hello;
+    hello.pid = static_cast<int32_t>(::getpid());
+    if (!sendMessage(fd, MessageType::HELLO, hello)) return 1;
+
+    GamePool pool;  // One game per worker, reinitialized for each seed
+    for (;;) {
+        Header header;
+        if (!readAll(fd, &header, sizeof(header))) return 0;  // Coordinator gone
+        if (header.type == MessageType::STOP) return 0;
+        if (header.type != MessageType::ASSIGN || header.size != sizeof(Assignment)) return 1;
+
+        Assignment work;
+        if (!readAll(fd, &work, sizeof(work))) return 1;
+
+        for (uint32_t i = 0; i < work.count; i++) {
+            uint32_t seed = work.firstSeed + i;
+            const FaultPlan& faults = work.faults;
+            bool inject = !faults.onlyFirstAttempt || work.attempt == 0;
+            if (inject && seed == faults.crashSeed) std::abort();
+            if (inject && seed == faults.hangSeed) {
+                for (;;) ::pause();
+            }
+
+            auto game = pool.acquire(seed);
+            SeedResult result;
+            result.seed = seed;
+            result.worker = hello.pid;
+            result.completed = game->runFullDemo(work.maxTrialsPerPuzzle) ? 1 : 0;
+            for (int p = 0; p < NUM_PUZZLES; p++) {
+                const PuzzleResult& pr = game->puzzleResult(static_cast<PuzzleType>(p));
+                result.trials[p] = pr.trials;
+                result.seconds[p] = static_cast<float>(pr.seconds);
+            }
+            result.gauntletPercent = game->state().gauntlet.scorePercent();
+            pool.release(std::move(game));
+            if (!sendMessage(fd, MessageType::RESULT, result)) return 1;
+        }
+        if (!sendEmpty(fd, MessageType::DONE)) return 1;
+    }
+}
+
+int runRemoteWorker(const std::string& path) {
+    sockaddr_un addr = {};
+    if (path.size() >= sizeof(addr.sun_path)) return 1;
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return 1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return 1;
+    }
+    int code = runWorker(fd);
+    ::close(fd);
+    return code;
+}
+
+//=============================================================================
+// Coordinator
+//=============================================================================
+bool SweepCoordinator::run(SweepReport& report) {
+    const SweepConfig& c = config_;
+    auto start = Clock::now();
+    report = SweepReport();
+    report.results.resize(c.seeds);
+
+    std::vector<bool> have(c.seeds, false);
+    std::vector<int> attempts(c.seeds, 0);
+    uint32_t remaining = c.seeds;
+
+    uint32_t rangeSize = std::max<uint32_t>(1, c.rangeSize);
+    std::deque<Range> queue;
+    for (uint32_t s = 0; s < c.seeds; s += rangeSize) {
+        queue.push_back({c.firstSeed + s, std::min(rangeSize, c.seeds - s)});
+    }
+
+    int forkedTarget = c.workers;
+    if (forkedTarget <= 0 && c.listenPath.empty()) {
+        forkedTarget = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    std::vector<Connection> conns;
+
+    // Listening socket for separately started workers
+    int listenFd = -1;
+    if (!c.listenPath.empty()) {
+        sockaddr_un addr = {};
+        if (c.listenPath.size() >= sizeof(addr.sun_path)) return false;
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, c.listenPath.c_str(), c.listenPath.size() + 1);
+        ::unlink(c.listenPath.c_str());
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listenFd, 16) != 0) {
+            if (listenFd >= 0) ::close(listenFd);
+            return false;
+        }
+    }
+
+    auto addWorker = [&](int fd, int pid, bool forked) {
+        Connection conn;
+        conn.fd = fd;
+        conn.pid = pid;
+        conn.forked = forked;
+        conn.lastHeard = Clock::now();
+        conn.stats = report.workers.size();
+        WorkerStats stats;
+        stats.pid = pid;
+        stats.forked = forked;
+        report.workers.push_back(stats);
+        conns.push_back(std::move(conn));
+    };
+
+    auto spawn = [&]() -> bool {
+        int pair[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) return false;
+        std::fflush(stdout);
+        std::fflush(stderr);
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            ::close(pair[0]);
+            ::close(pair[1]);
+            return false;
+        }
+        if (pid == 0) {
+            // Child: drop every coordinator descriptor so a dead worker's
+            // socket reads as EOF on the coordinator side
+            for (const auto& conn : conns) ::close(conn.fd);
+            if (listenFd >= 0) ::close(listenFd);
+            ::close(pair[0]);
+            int code = runWorker(pair[1]);
+            ::_exit(code);
+        }
+        ::close(pair[1]);
+        addWorker(pair[0], static_cast<int>(pid), true);
+        return true;
+    };
+
+    auto forkedAlive = [&] {
+        int n = 0;
+        for (const auto& conn : conns) n += conn.forked;
+        return n;
+    };
+
+    auto assign = [&](Connection& conn) {
+        if (conn.busy || queue.empty()) return;
+        Range range = queue.front();
+        queue.pop_front();
+
+        Assignment work;
+        work.firstSeed = range.first;
+        work.count = range.count;
+        work.attempt = static_cast<uint32_t>(attempts[range.first - c.firstSeed]);
+        work.maxTrialsPerPuzzle = c.maxTrialsPerPuzzle;
+        work.faults = c.faults;
+        conn.busy = true;
+        conn.range = range;
+        conn.lastHeard = Clock::now();
+        // A failed send shows up as EOF on the next poll, which requeues
+        (void)sendMessage(conn.fd, MessageType::ASSIGN, work);
+    };
+
+    // A worker is gone: requeue what it did not report, blaming the first
+    // unreported seed (workers run their range in order)
+    auto lose = [&](size_t index) {
+        Connection& conn = conns[index];
+        report.workers[conn.stats].lost = true;
+        if (conn.busy) {
+            uint32_t first = conn.range.first;
+            uint32_t end = conn.range.first + conn.range.count;
+            while (first < end && have[first - c.firstSeed]) first++;
+            if (first < end) {
+                uint32_t i = first - c.firstSeed;
+                if (++attempts[i] >= c.maxAttempts) {
+                    SeedResult& r = report.results[i];
+                    r.seed = first;
+                    r.failed = 1;
+                    for (int p = 0; p < NUM_PUZZLES; p++) r.trials[p] = -1;
+                    have[i] = true;
+                    remaining--;
+                    report.failedSeeds++;
+                    first++;
+                }
+                if (first < end) {
+                    queue.push_front({first, end - first});
+                    report.requeued++;
+                }
+            }
+        }
+        ::close(conn.fd);
+        if (conn.forked) {
+            ::kill(conn.pid, SIGKILL);
+            ::waitpid(conn.pid, nullptr, 0);
+        }
+        conns.erase(conns.begin() + static_cast<std::ptrdiff_t>(index));
+    };
+
+    // Returns false if the connection broke the protocol
+    auto handle = [&](Connection& conn, const Header& header, const char* payload) -> bool {
+        WorkerStats& stats = report.workers[conn.stats];
+        switch (header.type) {
+            case MessageType::HELLO: {
+                if (header.size != sizeof(Hello)) return false;
+                Hello hello;
+                std::memcpy(&hello, payload, sizeof(hello));
+                conn.pid = hello.pid;
+                stats.pid = hello.pid;
+                return true;
+            }
+            case MessageType::RESULT: {
+                if (header.size != sizeof(SeedResult) || !conn.busy) return false;
+                SeedResult result;
+                std::memcpy(&result, payload, sizeof(result));
+                if (result.seed < c.firstSeed || result.seed - c.firstSeed >= c.seeds) return false;
+                uint32_t i = result.seed - c.firstSeed;
+                if (!have[i]) {
+                    report.results[i] = result;
+                    have[i] = true;
+                    remaining--;
+                }
+                stats.seeds++;
+                return true;
+            }
+            case MessageType::DONE:
+                if (!conn.busy) return false;
+                conn.busy = false;
+                stats.ranges++;
+                return true;
+            default:
+                return false;
+        }
+    };
+
+    for (int i = 0; i < forkedTarget; i++) {
+        if (!spawn()) break;
+    }
+    if (conns.empty() && listenFd < 0) return false;
+
+    // Until every seed is reported and every worker has closed its range
+    auto anyBusy = [&] {
+        for (const auto& conn : conns) {
+            if (conn.busy) return true;
+        }
+        return false;
+    };
+    while (remaining > 0 || anyBusy()) {
+        // Replace lost forked workers while there is work to hand out
+        while (!queue.empty() && forkedAlive() < forkedTarget && spawn()) {
+        }
+        if (conns.empty() && listenFd < 0) break;  // No worker left and none can join
+        for (auto& conn : conns) assign(conn);
+
+        std::vector<pollfd> fds;
+        for (const auto& conn : conns) fds.push_back({conn.fd, POLLIN, 0});
+        if (listenFd >= 0) fds.push_back({listenFd, POLLIN, 0});
+        int ready = ::poll(fds.data(), fds.size(), 100);
+        if (ready < 0 && errno != EINTR) break;
+
+        if (listenFd >= 0 && (fds.back().revents & POLLIN)) {
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd >= 0) addWorker(fd, 0, false);
+        }
+
+        // Read, parse, and drop broken or silent workers (back to front,
+        // so erasing keeps the remaining indices valid)
+        auto now = Clock::now();
+        size_t polled = conns.size() < fds.size() ? conns.size() : fds.size();
+        for (size_t k = polled; k-- > 0;) {
+            Connection& conn = conns[k];
+            bool lost = false;
+            if (fds[k].revents & (POLLIN | POLLHUP | POLLERR)) {
+                char chunk[4096];
+                ssize_t n = ::read(conn.fd, chunk, sizeof(chunk));
+                if (n <= 0) {
+                    lost = !(n < 0 && errno == EINTR);
+                } else {
+                    conn.lastHeard = now;
+                    conn.buffer.append(chunk, static_cast<size_t>(n));
+                    size_t used = 0;
+                    while (!lost && conn.buffer.size() - used >= sizeof(Header)) {
+                        Header header;
+                        std::memcpy(&header, conn.buffer.data() + used, sizeof(header));
+                        if (conn.buffer.size() - used < sizeof(Header) + header.size) break;
+                        lost = !handle(conn, header, conn.buffer.data() + used + sizeof(Header));
+                        used += sizeof(Header) + header.size;
+                    }
+                    conn.buffer.erase(0, used);
+                }
+            }
+            double silent = std::chrono::duration<double>(now - conn.lastHeard).count();
+            if (!lost && conn.busy && silent > c.timeoutSeconds) {
+                if (!conn.forked && conn.pid > 0) ::kill(conn.pid, SIGKILL);  // Same host stand-in
+                lost = true;
+            }
+            if (lost) lose(k);
+        }
+    }
+
+    // Release the workers (all seeds reported, unless the loop gave up)
+    for (auto& conn : conns) {
+        sendEmpty(conn.fd, MessageType::STOP);
+        ::close(conn.fd);
+        if (conn.forked) ::waitpid(conn.pid, nullptr, 0);
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        ::unlink(c.listenPath.c_str());
+    }
+
+    report.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return remaining == 0;
+}
+
+} // namespace sweep
+} // namespace enen
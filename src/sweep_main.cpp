@@ -0,0 +1,121 @@
+/**
+ * enen Demo: Multi-Process Seed Sweep
+ *
+ * Runs the full demo for a range of seeds in worker processes handed
+ * seed ranges over Unix sockets (sweep.hpp), and merges the results.
+ * A crashing or hung seed costs one worker, which is replaced; the rest
+ * of its range is requeued.
+ *
+ * Usage:
+ *   ./enen-sweep [--seeds N] [--first S] [--range N] [--workers N]
+ *                [--max-trials N] [--timeout S] [--attempts N]
+ *                [--listen PATH] [--crash-seed S] [--hang-seed S] [--always]
+ *   ./enen-sweep --connect PATH
+ *
+ * --listen also accepts workers started separately with --connect (the
+ * stand-in for workers on other hosts); with --workers 0 it waits for
+ * them. --crash-seed / --hang-seed make workers abort or stop responding
+ * on that seed, on the first attempt only unless --always is given.
+ */
+
+#include "sweep.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace enen;
+
+namespace {
+
+void usage(const char* argv0) {
+    std::fprintf(stderr,
+                 "Usage: %s [--seeds N] [--first S] [--range N] [--workers N]\n"
+                 "          [--max-trials N] [--timeout S] [--attempts N]\n"
+                 "          [--listen PATH] [--crash-seed S] [--hang-seed S] [--always]\n"
+                 "       %s --connect PATH\n", argv0, argv0);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    sweep::SweepConfig config;
+    bool workersGiven = false;
+
+    for (int i = 1; i < argc; i++) {
+        auto next = [&] { return argv[++i]; };
+        if (std::strcmp(argv[i], "--connect") == 0 && i + 1 < argc) {
+            return sweep::runRemoteWorker(next());
+        } else if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) {
+            config.seeds = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (std::strcmp(argv[i], "--first") == 0 && i + 1 < argc) {
+            config.firstSeed = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (std::strcmp(argv[i], "--range") == 0 && i + 1 < argc) {
+            config.rangeSize = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            config.workers = std::atoi(next());
+            workersGiven = true;
+        } else if (std::strcmp(argv[i], "--max-trials") == 0 && i + 1 < argc) {
+            config.maxTrialsPerPuzzle = std::atoi(next());
+        } else if (std::strcmp(argv[i], "--timeout") == 0 && i + 1 < argc) {
+            config.timeoutSeconds = std::atof(next());
+        } else if (std::strcmp(argv[i], "--attempts") == 0 && i + 1 < argc) {
+            config.maxAttempts = std::atoi(next());
+        } else if (std::strcmp(argv[i], "--listen") == 0 && i + 1 < argc) {
+            config.listenPath = next();
+        } else if (std::strcmp(argv[i], "--crash-seed") == 0 && i + 1 < argc) {
+            config.faults.crashSeed = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (std::strcmp(argv[i], "--hang-seed") == 0 && i + 1 < argc) {
+            config.faults.hangSeed = static_cast<uint32_t>(std::strtoul(next(), nullptr, 10));
+        } else if (std::strcmp(argv[i], "--always") == 0) {
+            config.faults.onlyFirstAttempt = false;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!workersGiven && !config.listenPath.empty()) config.workers = 0;
+    if (config.maxAttempts < 1) config.maxAttempts = 1;
+
+    printf("Seed Sweep\n");
+    printf("==========\n");
+    printf("Seeds %u..%u in ranges of %u, ", config.firstSeed, config.firstSeed + config.seeds - 1,
+           config.rangeSize);
+    if (config.workers > 0) printf("%d forked workers", config.workers);
+    else if (config.listenPath.empty()) printf("one forked worker per CPU");
+    else printf("no forked workers");
+    if (!config.listenPath.empty()) printf(", listening on %s", config.listenPath.c_str());
+    printf("\n");
+    std::fflush(stdout);
+
+    sweep::SweepCoordinator coordinator(config);
+    sweep::SweepReport report;
+    if (!coordinator.run(report)) {
+        std::fprintf(stderr, "Sweep incomplete: could not start or keep workers%s\n",
+                     config.listenPath.empty() ? "" : " or listen on the socket");
+        return 1;
+    }
+
+    printf("\n%-18s %12s %12s\n", "Puzzle", "solved", "mean trials");
+    for (int p = 0; p < NUM_PUZZLES; p++) {
+        int solved = 0;
+        for (const auto& r : report.results) solved += r.trials[p] > 0;
+        printf("%-18s %8d/%-3zu %12.1f\n", puzzleLabel(static_cast<PuzzleType>(p)), solved, report.results.size(),
+               report.meanTrials(static_cast<PuzzleType>(p)));
+    }
+
+    printf("\n%-8s %-7s %8s %8s  %s\n", "Worker", "kind", "seeds", "ranges", "status");
+    for (const auto& w : report.workers) {
+        printf("%-8d %-7s %8d %8d  %s\n", w.pid, w.forked ? "forked" : "remote", w.seeds, w.ranges,
+               w.lost ? "lost" : "ok");
+    }
+
+    printf("\nCompleted: %d/%zu seeds in %.2fs (%.1f seeds/s)\n", report.completed(),
+           report.results.size(), report.wallSeconds,
+           report.wallSeconds > 0 ? report.results.size() / report.wallSeconds : 0.0);
+    printf("Requeued ranges: %d, failed seeds: %d", report.requeued, report.failedSeeds);
+    for (const auto& r : report.results) {
+        if (r.failed) printf(" %u", r.seed);
+    }
+    printf("\n");
+    return report.failedSeeds == 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/**
+ * Seed Sweep Test
+ *
+ * Runs small multi-process sweeps on this machine and checks that every
+ * seed is accounted for exactly once: with healthy workers, with a worker
+ * that crashes or hangs once (range requeued, worker replaced), with a
+ * seed that always crashes (recorded as failed), and with workers that
+ * connect over the listening socket instead of being forked.
+ */
+
+#include "sweep.hpp"
+#include <cstdio>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace enen;
+
+namespace {
+
+constexpr uint32_t SEEDS = 10;
+constexpr uint32_t FIRST = 100;
+
+sweep::SweepConfig baseConfig() {
+    sweep::SweepConfig config;
+    config.firstSeed = FIRST;
+    config.seeds = SEEDS;
+    config.rangeSize = 3;
+    config.workers = 2;
+    config.timeoutSeconds = 2.0;
+    return config;
+}
+
+// Every seed present once, in order; `failed` seeds marked failed
+bool accounted(const sweep::SweepReport& report, uint32_t failedSeed = 0) {
+    if (report.results.size() != SEEDS) return false;
+    for (uint32_t i = 0; i < SEEDS; i++) {
+        const auto& r = report.results[i];
+        if (r.seed != FIRST + i) return false;
+        if ((r.seed == failedSeed) != (r.failed != 0)) return false;
+        if (!r.failed && r.worker <= 0) return false;
+    }
+    return true;
+}
+
+int lostWorkers(const sweep::SweepReport& report) {
+    int n = 0;
+    for (const auto& w : report.workers) n += w.lost;
+    return n;
+}
+
+bool check(const char* name, bool ok, const sweep::SweepReport& report) {
+    printf("  %-22s %s (%zu workers, %d lost, %d requeued, %d failed, %.2fs)\n", name,
+           ok ? "PASS" : "FAIL", report.workers.size(), lostWorkers(report), report.requeued,
+           report.failedSeeds, report.wallSeconds);
+    return ok;
+}
+
+bool testHealthy() {
+    sweep::SweepReport report;
+    bool ran = sweep::SweepCoordinator(baseConfig()).run(report);
+    return check("Healthy workers", ran && accounted(report) && report.requeued == 0 &&
+                                        lostWorkers(report) == 0, report);
+}
+
+bool testCrashOnce() {
+    sweep::SweepConfig config = baseConfig();
+    config.faults.crashSeed = FIRST + 4;
+    sweep::SweepReport report;
+    bool ran = sweep::SweepCoordinator(config).run(report);
+    return check("Crash, then retry", ran && accounted(report) && report.requeued == 1 &&
+                                          lostWorkers(report) == 1 && report.failedSeeds == 0, report);
+}
+
+bool testPoisonSeed() {
+    sweep::SweepConfig config = baseConfig();
+    config.faults.crashSeed = FIRST + 4;
+    config.faults.onlyFirstAttempt = false;
+    config.maxAttempts = 2;
+    sweep::SweepReport report;
+    bool ran = sweep::SweepCoordinator(config).run(report);
+    return check("Seed always crashes", ran && accounted(report, FIRST + 4) &&
+                                            report.failedSeeds == 1 && lostWorkers(report) == 2, report);
+}
+
+bool testHang() {
+    sweep::SweepConfig config = baseConfig();
+    config.faults.hangSeed = FIRST + 7;
+    config.timeoutSeconds = 1.0;
+    sweep::SweepReport report;
+    bool ran = sweep::SweepCoordinator(config).run(report);
+    return check("Hang, killed, retry", ran && accounted(report) && lostWorkers(report) == 1 &&
+                                            report.failedSeeds == 0, report);
+}
+
+bool testConnectedWorkers() {
+    sweep::SweepConfig config = baseConfig();
+    config.workers = 0;
+    config.listenPath = "/tmp/enen-sweep-test-" + std::to_string(::getpid()) + ".sock";
+
+    // Two workers started apart from the coordinator, connecting once it listens
+    pid_t children[2];
+    for (pid_t& child : children) {
+        child = ::fork();
+        if (child == 0) {
+            for (int attempt = 0; attempt < 50; attempt++) {
+                if (sweep::runRemoteWorker(config.listenPath) == 0) ::_exit(0);
+                ::usleep(20000);
+            }
+            ::_exit(1);
+        }
+    }
+
+    sweep::SweepReport report;
+    bool ran = sweep::SweepCoordinator(config).run(report);
+    for (pid_t child : children) ::waitpid(child, nullptr, 0);
+
+    int remote = 0;
+    for (const auto& w : report.workers) remote += !w.forked;
+    return check("Connected workers", ran && accounted(report) && remote == 2, report);
+}
+
+} // anonymous namespace
+
+int main() {
+    printf("Seed Sweep Test\n");
+    printf("===============\n");
+    printf("%u seeds per sweep, ranges of 3\n\n", SEEDS);
+    std::fflush(stdout);
+
+    int passed = 0;
+    int total = 0;
+    for (bool (*test)() : {testHealthy, testCrashOnce, testPoisonSeed, testHang, testConnectedWorkers}) {
+        passed += test();
+        total++;
+    }
+
+    printf("\nResults: %d/%d passed\n", passed, total);
+    return passed == total ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/**
+ * Concurrent inference tests for enen Demo
+ *
+ * One trained brain, many threads: every thread makes decisions on the
+ * same const wrappers and must get exactly the answers a single thread
+ * gets. Run on both backends.
+ *
+ * Build with -DENEN_TSAN=ON (the default where supported) to run the
+ * stress under ThreadSanitizer; any data race on the inference path is
+ * then reported and fails the run.
+ */
+
+#include "heatmap.hpp"
+#include "networks.hpp"
+#include "puzzles.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace enen;
+
+namespace {
+
+constexpr int ROUNDS = 20;  // Passes over the query set per thread
+
+int threadCount() {
+    int hw = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(hw, 4, 8);
+}
+
+// Run body(thread index) on n threads at once
+template <class Body>
+void runThreads(int n, Body body) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n; t++) threads.emplace_back(body, t);
+    for (auto& thread : threads) thread.join();
+}
+
+struct Brain {
+    GeneralizationNet gen;
+    XORNet xorNet;
+    SequenceNet seq;
+    CompositionNet comp;
+
+    explicit Brain(Backend backend) : gen(backend), xorNet(backend), seq(backend), comp(backend) {
+        gen.reset(11);
+        xorNet.reset(12);
+        seq.reset(13);
+        comp.reset(14);
+
+        RNG rng(99);
+        for (int i = 0; i < 8; i++) {
+            auto m = MushroomTrial::generate(rng);
+            gen.learn(m.sizeA, m.sizeB, m.colorA, m.colorB, m.correctIsA);
+            auto x = XORTrial::generate(rng);
+            xorNet.learn(x.lightInput(), x.pathInput(), x.isSafe);
+            auto c = CompositionTrial::generate(rng);
+            comp.learn(c.lightInput(), c.sizeA, c.sizeB, c.correctIsA);
+        }
+        seq.learnFromOutcome(0, 0, true);
+        seq.learnFromOutcome(64, 1, true);
+    }
+};
+
+struct Query {
+    int16_t a, b, c, d;
+};
+
+// Every decision the shared brain can make, packed for comparison
+uint32_t decide(const Brain& brain, const Query& q) {
+    uint32_t bits = 0;
+    bits |= brain.gen.chooseA(q.a, q.b, q.c, q.d) ? 1u : 0u;
+    bits |= brain.xorNet.isSafe(q.a, q.b) ? 2u : 0u;
+    bits |= static_cast<uint32_t>(brain.seq.chooseAction(q.a)) << 2;
+    bits |= brain.comp.chooseA(q.c, q.a, q.b) ? 8u : 0u;
+    bits |= static_cast<uint32_t>(brain.seq.scoreA(q.a)) << 8;
+    bits |= static_cast<uint32_t>(brain.seq.scoreB(q.a)) << 16;
+    return bits;
+}
+
+//=============================================================================
+// Test 1: Shared decisions
+// All threads query the same const brain; answers must match the reference
+//=============================================================================
+bool testSharedDecisions(Backend backend) {
+    printf("Test 1 (%s): %d threads deciding on one shared brain\n",
+           backendName(backend), threadCount());
+
+    const Brain brain(backend);
+
+    RNG rng(2024);
+    std::vector<Query> queries(64);
+    auto input = [&rng] { return static_cast<int16_t>(rng.next() % 128); };
+    for (auto& q : queries) q = {input(), input(), input(), input()};
+
+    std::vector<uint32_t> expected;
+    for (const auto& q : queries) expected.push_back(decide(brain, q));
+
+    std::atomic<int> mismatches{0};
+    std::atomic<int> badTraces{0};
+    runThreads(threadCount(), [&](int t) {
+        for (int round = 0; round < ROUNDS; round++) {
+            for (size_t i = 0; i < queries.size(); i++) {
+                // Stagger threads so they hit different queries at once
+                size_t k = (i + static_cast<size_t>(t) * 7) % queries.size();
+                if (decide(brain, queries[k]) != expected[k]) mismatches++;
+                if (!brain.comp.lastForward().valid()) badTraces++;
+            }
+        }
+    });
+
+    int decisions = threadCount() * ROUNDS * static_cast<int>(queries.size()) * 6;
+    bool pass = mismatches == 0 && badTraces == 0;
+    printf("  %d decisions, %d mismatches, %d bad traces\n", decisions,
+           mismatches.load(), badTraces.load());
+    printf("  %s\n\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+//=============================================================================
+// Test 2: Shared decision maps
+// Each thread keeps its own heatmap of the shared nets (batched path)
+//=============================================================================
+bool testSharedDecisionMaps(Backend backend) {
+    printf("Test 2 (%s): %d threads scoring decision maps of one shared brain\n",
+           backendName(backend), threadCount());
+
+    const Brain brain(backend);
+
+    DecisionGrid on, off, xorGrid;
+    brain.comp.decisionGrid(127, on);
+    brain.comp.decisionGrid(0, off);
+    brain.xorNet.decisionGrid(xorGrid);
+
+    auto same = [](const DecisionGrid& a, const DecisionGrid& b) {
+        return std::equal(&a.cells[0][0], &a.cells[0][0] + DecisionGrid::CELLS, &b.cells[0][0]);
+    };
+
+    std::atomic<int> mismatches{0};
+    runThreads(threadCount(), [&](int t) {
+        DecisionHeatmap comp;
+        DecisionHeatmap xorMap;
+        for (int round = 0; round < ROUNDS; round++) {
+            bool lightOn = ((round + t) & 1) != 0;  // Alternate to force a re-score
+            comp.update(brain.comp, lightOn ? 127 : 0);
+            if (!same(comp.grid(), lightOn ? on : off)) mismatches++;
+
+            DecisionGrid grid;
+            brain.xorNet.decisionGrid(grid);
+            if (!same(grid, xorGrid)) mismatches++;
+            xorMap.update(brain.xorNet);
+        }
+    });
+
+    bool pass = mismatches == 0;
+    printf("  %d grids, %d mismatches\n", threadCount() * ROUNDS * 2, mismatches.load());
+    printf("  %s\n\n", pass ? "PASS" : "FAIL");
+    return pass;
+}
+
+} // anonymous namespace
+
+//=============================================================================
+// Main
+//=============================================================================
+int main() {
+    printf("==================================================\n");
+    printf("Concurrent Inference Tests for enen Demo\n");
+    printf("==================================================\n\n");
+
+    int passed = 0;
+    int total = 0;
+
+    for (Backend backend : {Backend::INTEGER, Backend::FLOAT, Backend::EVOLVED}) {
+        total += 2;
+        if (testSharedDecisions(backend)) passed++;
+        if (testSharedDecisionMaps(backend)) passed++;
+    }
+
+    printf("==================================================\n");
+    printf("Results: %d/%d passed\n", passed, total);
+    printf("==================================================\n");
+
+    return (passed == total) ? 0 : 1;
+}